@@ -1,5 +1,9 @@
 #pragma once
 
+#include "HttpStreamSource.hpp"
+
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -20,5 +24,23 @@ namespace Aether::Api
         int status = 200;                                     /**< Status HTTP (200, 404, 500, etc) */
         std::string body;                                     /**< Corpo da resposta (JSON, HTML, etc) */
         std::unordered_map<std::string,std::string> headers;  /**< Headers HTTP da resposta */
+
+        /**
+         * @brief Quando preenchido, a resposta é um stream: `body` é
+         * ignorado e os pedaços vêm dessa fonte, enviados com
+         * Transfer-Encoding: chunked até a fonte terminar ou o cliente sair.
+         */
+        std::shared_ptr<HttpStreamSource> stream;
     };
+
+    /**
+     * @brief Callback que entrega a resposta de uma requisição
+     *
+     * Usado pelas rotas assíncronas (ex: snapshot de câmera), que
+     * completam a resposta depois, a partir de outro callback do
+     * io_context. Deve ser chamado exatamente uma vez.
+     *
+     * @see Router::dispatch()
+     */
+    using HttpResponseHandler = std::function<void(HttpResponse)>;
 }
\ No newline at end of file
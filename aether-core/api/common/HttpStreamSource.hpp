@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Um pedaço de uma resposta em streaming
+     *
+     * Os bytes não são copiados: `parts` aponta para memória mantida viva
+     * por `owner` até o pedaço terminar de ser escrito no socket -- assim o
+     * mesmo frame pode ser enviado a N clientes sem N cópias.
+     */
+    struct HttpStreamChunk
+    {
+        std::shared_ptr<const void> owner;    /**< Mantém vivos os bytes apontados por parts */
+        std::vector<std::string_view> parts;  /**< Escritos em sequência, como um único chunk HTTP */
+    };
+
+    /**
+     * @brief Fonte de uma resposta HTTP em streaming (Transfer-Encoding: chunked)
+     *
+     * Quando HttpResponse::stream está preenchido, a HttpSession envia só
+     * status + headers e depois pede um pedaço por vez com next(): o
+     * próximo só é pedido quando o anterior terminou de ser escrito, então
+     * um cliente lento nunca acumula fila -- a fonte decide o que fazer com
+     * o que chegar nesse meio tempo (ex: manter só o mais recente).
+     *
+     * @see HttpSession
+     */
+    class HttpStreamSource
+    {
+        public:
+            /**
+             * @brief Recebe o próximo pedaço, ou std::nullopt quando o stream terminou
+             */
+            using ChunkHandler = std::function<void(std::optional<HttpStreamChunk>)>;
+
+            virtual ~HttpStreamSource() = default;
+
+            /**
+             * @brief Pede o próximo pedaço
+             *
+             * @p handler é chamado uma única vez (na hora ou mais tarde, de
+             * qualquer thread), a não ser que close() seja chamado antes.
+             */
+            virtual void next(ChunkHandler handler) = 0;
+
+            /**
+             * @brief O cliente desconectou: libera recursos e descarta o
+             * handler pendente de next() sem chamá-lo
+             */
+            virtual void close() = 0;
+    };
+}
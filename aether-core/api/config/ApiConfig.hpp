@@ -1,5 +1,7 @@
 #pragma once
 
+#include "CameraConfig.hpp"
+#include "HorusDatabaseConfig.hpp"
 #include "../common/HttpMethod.hpp"
 
 #include <algorithm>
@@ -102,5 +104,18 @@ namespace Aether::Api
             HttpMethod::PATCH,
             HttpMethod::DELETE_,
         };
+
+        /**
+         * @brief Acesso às câmeras do Horus (prazos, cadência de polling,
+         * cache e a câmera única usada quando não há cadastro no banco).
+         * @see CameraService
+         */
+        CameraConfig camera;
+
+        /**
+         * @brief Banco de onde o cadastro de câmeras (horus.came_camera) é carregado.
+         * @see CameraRegistry
+         */
+        HorusDatabaseConfig horusDatabase;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -11,6 +13,11 @@ namespace Aether::Api
      * Centraliza host, porta, credenciais e path do endpoint de snapshot
      * usado pelas câmeras compatíveis com o padrão cgi-bin (ex: Dahua/Intelbras).
      *
+     * Câmeras cadastradas em horus.came_camera (CameraRegistry) usam host,
+     * porta, credenciais e path do próprio cadastro, e herdam daqui só os
+     * prazos, a cadência de polling e as idades máximas. host/port/user/
+     * password/cgiPath são a câmera única usada quando não há cadastro.
+     *
      * @warning Os valores abaixo são o default de desenvolvimento. Em produção,
      * mover host/user/password para variáveis de ambiente ou arquivo de
      * configuração fora do versionamento.
@@ -22,5 +29,65 @@ namespace Aether::Api
         std::string user     = "admin";                         /**< Usuário do Digest Auth */
         std::string password = "favero10";                      /**< Senha do Digest Auth */
         std::string cgiPath  = "/cgi-bin/snapshot.cgi?channel="; /**< Path base do snapshot (concatenar canal) */
+
+        /**
+         * @brief Maior canal aceito na câmera única (canais de 1 a maxChannel).
+         *
+         * Só vale sem cadastro, quando o id da rota é o canal. Cada canal
+         * aceito ganha um cache próprio que vive enquanto a API estiver de
+         * pé, então o canal vindo da URL precisa de um teto.
+         */
+        int maxChannel = 16;
+
+        /**
+         * @brief Idade máxima de um snapshot em cache pra ainda ser servido
+         * como "fresco", sem nenhuma busca nova na câmera.
+         *
+         * Com 10 dashboards consultando o mesmo canal a cada segundo, é
+         * isso que impede a câmera de receber 10 buscas por segundo: todas
+         * as requisições dentro dessa janela saem do cache. 0 desliga o
+         * cache (toda requisição busca na câmera, mas buscas concorrentes
+         * do mesmo canal continuam sendo coalescidas).
+         */
+        std::chrono::milliseconds snapshotMaxAge{1000};
+
+        /**
+         * @brief Idade máxima de um snapshot velho que ainda pode ser
+         * servido enquanto outra requisição já está buscando o próximo
+         * na câmera (stale-while-revalidate).
+         *
+         * Acima disso, quem chega durante uma busca em andamento espera o
+         * resultado dela em vez de receber uma imagem antiga demais.
+         */
+        std::chrono::milliseconds snapshotStaleMaxAge{10000};
+
+        /**
+         * @brief Prazo para resolver/conectar na câmera.
+         *
+         * Câmera desligada ou fora da rede falha nesse tempo em vez de
+         * esperar o timeout TCP do sistema operacional.
+         */
+        std::chrono::milliseconds connectTimeout{3000};
+
+        /**
+         * @brief Prazo para enviar a requisição e receber a resposta
+         * completa (headers + JPEG) de uma conexão já aberta.
+         */
+        std::chrono::milliseconds requestTimeout{5000};
+
+        /**
+         * @brief Quantidade máxima de conexões keep-alive ociosas mantidas
+         * por câmera, prontas pra serem reaproveitadas.
+         */
+        std::size_t maxIdleConnections = 4;
+
+        /**
+         * @brief Cadência do CameraPoller: de quanto em quanto tempo cada
+         * câmera cadastrada tem o snapshot atualizado em memória.
+         *
+         * Nunca há mais de uma busca em andamento por câmera: se a anterior
+         * ainda não terminou quando o próximo ciclo chega, o ciclo é pulado.
+         */
+        std::chrono::milliseconds pollInterval{1000};
     };
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Configuração de banco de dados do módulo Horus (cadastro de câmeras)
+     *
+     * Usada pelo CameraRegistry para carregar as câmeras de
+     * horus.came_camera na subida da API.
+     *
+     * O usuário é o HORUS_APPLICATION (database/core/structure/006), que só
+     * tem leitura no schema horus. Nenhuma credencial fica no código: o
+     * aetherd preenche com fromEnvironment(), e senha vazia deixa o libpq
+     * usar PGPASSWORD ou o ~/.pgpass.
+     *
+     * @see CameraRegistry
+     */
+    struct HorusDatabaseConfig
+    {
+        /**
+         * @brief Carrega as câmeras do banco. Com false (ou se o banco
+         * estiver fora), a API usa só a câmera única do CameraConfig.
+         */
+        bool        enabled  = true;
+        std::string host     = "localhost";          /**< Host do PostgreSQL */
+        uint16_t    port     = 5432;                 /**< Porta do PostgreSQL */
+        std::string user     = "horus_application";  /**< Usuário do banco */
+        std::string password;                        /**< Senha do banco (vazia = PGPASSWORD/~/.pgpass) */
+        std::string database = "aetherdb";           /**< Nome do banco */
+        std::string schema   = "horus";              /**< Schema das tabelas do Horus */
+        int connectTimeoutSeconds = 3;               /**< Prazo de conexão (a API não sobe enquanto espera) */
+
+        /**
+         * @brief Defaults acima, sobrescritos pelas variáveis de ambiente
+         * AETHER_HORUS_DB_HOST, _PORT, _USER, _PASSWORD e _NAME que existirem.
+         * AETHER_HORUS_DB_ENABLED=0 desliga o cadastro.
+         */
+        static HorusDatabaseConfig fromEnvironment()
+        {
+            HorusDatabaseConfig config;
+
+            if (const char* value = std::getenv("AETHER_HORUS_DB_ENABLED"))
+                config.enabled = std::string(value) != "0";
+            if (const char* value = std::getenv("AETHER_HORUS_DB_HOST"))
+                config.host = value;
+            if (const char* value = std::getenv("AETHER_HORUS_DB_PORT"))
+                config.port = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+            if (const char* value = std::getenv("AETHER_HORUS_DB_USER"))
+                config.user = value;
+            if (const char* value = std::getenv("AETHER_HORUS_DB_PASSWORD"))
+                config.password = value;
+            if (const char* value = std::getenv("AETHER_HORUS_DB_NAME"))
+                config.database = value;
+
+            return config;
+        }
+
+        /** @brief Gera a connection string pronta (formato libpq, valores entre aspas) */
+        std::string connectionString() const
+        {
+            std::string conninfo = "host=" + quote(host)
+                + " port=" + std::to_string(port)
+                + " user=" + quote(user)
+                + " dbname=" + quote(database)
+                + " connect_timeout=" + std::to_string(connectTimeoutSeconds)
+                + " options='-c search_path=" + schema + "'";
+
+            if (!password.empty())
+                conninfo += " password=" + quote(password);
+
+            return conninfo;
+        }
+
+    private:
+        /** @brief Valor entre aspas simples, com ' e \ escapados (sintaxe do conninfo) */
+        static std::string quote(const std::string& value)
+        {
+            std::string quoted = "'";
+            for (const char c : value)
+            {
+                if (c == '\'' || c == '\\')
+                    quoted += '\\';
+                quoted += c;
+            }
+            return quoted + "'";
+        }
+    };
+}
@@ -0,0 +1,22 @@
+#include "MetricsController.hpp"
+
+namespace Aether::Api
+{
+    /**
+     * Processa requisição GET para /api/core/metrics
+     *
+     * Retorna as métricas no formato texto do Prometheus.
+     * Delegada ao MetricsService para obter os dados.
+     */
+    HttpResponse MetricsController::get(const HttpRequest&)
+    {
+        HttpResponse response;
+        response.status = 200;
+
+        response.body = m_service.get();
+        response.headers["Access-Control-Allow-Origin"] = "*";
+        response.headers["Content-Type"] = "text/plain; version=0.0.4; charset=utf-8";
+
+        return response;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../../services/core/MetricsService.hpp"
+#include "../../common/HttpResponse.hpp"
+#include "../../common/HttpRequest.hpp"
+
+namespace Aether::Api
+{
+    /**
+     * @brief Controller de métricas do Aether Core
+     *
+     * Expõe as métricas do Core para o Prometheus (scrape em
+     * GET /api/core/metrics).
+     *
+     * @see MetricsService
+     * @see Router
+     */
+    class MetricsController
+    {
+        public:
+            /**
+             * @brief Processa requisição GET de métricas
+             * @param request Requisição HTTP recebida
+             * @return Resposta HTTP com as métricas em text/plain (formato Prometheus 0.0.4)
+             */
+            HttpResponse get(const HttpRequest& request);
+
+        private:
+            MetricsService m_service;  /**< Service de métricas */
+    };
+}
@@ -7,6 +7,10 @@ namespace Aether::Api
     {
         constexpr const char* kCamerasPrefix = "/api/horus/cameras/";
         constexpr const char* kSnapshotSuffix = "snapshot";
+        constexpr const char* kStreamSuffix = "stream";
+
+        /** Separador das partes do multipart/x-mixed-replace */
+        constexpr const char* kMjpegBoundary = "aetherframe";
 
         /**
          * Monta uma resposta de erro em JSON, no mesmo formato usado pelo
@@ -26,14 +30,76 @@ namespace Aether::Api
 
             return response;
         }
+
+        /**
+         * Stream MJPEG de um espectador: cada frame da inscrição vira uma
+         * parte do multipart/x-mixed-replace, sem copiar o JPEG (o chunk
+         * aponta direto pro frame compartilhado com os outros espectadores).
+         */
+        class MjpegStream : public HttpStreamSource
+        {
+            public:
+                explicit MjpegStream(std::shared_ptr<FrameSubscription> subscription)
+                    : m_subscription(std::move(subscription))
+                {
+                }
+
+                ~MjpegStream() override
+                {
+                    m_subscription->cancel();
+                }
+
+                void next(ChunkHandler handler) override
+                {
+                    m_subscription->next([handler = std::move(handler)](FrameSubscription::FramePtr frame)
+                    {
+                        struct Part
+                        {
+                            FrameSubscription::FramePtr frame;
+                            std::string header;
+                        };
+
+                        auto part = std::make_shared<Part>();
+                        part->header = std::string("--") + kMjpegBoundary +
+                            "\r\nContent-Type: " + frame->contentType +
+                            "\r\nContent-Length: " + std::to_string(frame->data.size()) +
+                            "\r\n\r\n";
+                        part->frame = std::move(frame);
+
+                        HttpStreamChunk chunk;
+                        chunk.parts = {
+                            part->header,
+                            std::string_view(reinterpret_cast<const char*>(part->frame->data.data()),
+                                             part->frame->data.size()),
+                            "\r\n",
+                        };
+                        chunk.owner = std::move(part);
+
+                        handler(std::move(chunk));
+                    });
+                }
+
+                void close() override
+                {
+                    m_subscription->cancel();
+                }
+
+            private:
+                std::shared_ptr<FrameSubscription> m_subscription;
+        };
+    }
+
+    CameraController::CameraController(boost::asio::io_context& ioContext, const ApiConfig& config)
+        : m_service(ioContext, config.camera, config.horusDatabase)
+    {
     }
 
     /**
-     * Extrai o canal do path "/api/horus/cameras/:channel/snapshot".
+     * Extrai o id do path "/api/horus/cameras/:id/<action>".
      * Tolera query string ao final (ex: "?t=123") para uso futuro
      * com cache-buster.
      */
-    int CameraController::parseChannelFromPath(const std::string& path)
+    int CameraController::parseCameraIdFromPath(const std::string& path, const std::string& action)
     {
         const std::string prefix = kCamerasPrefix;
 
@@ -46,19 +112,19 @@ namespace Aether::Api
         if (slashPos == std::string::npos)
             return -1;
 
-        const std::string channelStr = rest.substr(0, slashPos);
+        const std::string idStr = rest.substr(0, slashPos);
 
         std::string suffix = rest.substr(slashPos + 1);
         const auto queryPos = suffix.find('?');
         if (queryPos != std::string::npos)
             suffix = suffix.substr(0, queryPos);
 
-        if (suffix != kSnapshotSuffix)
+        if (suffix != action)
             return -1;
 
         try
         {
-            return std::stoi(channelStr);
+            return std::stoi(idStr);
         }
         catch (const std::exception&)
         {
@@ -67,36 +133,84 @@ namespace Aether::Api
     }
 
     /**
-     * Processa requisição GET para /api/horus/cameras/:channel/snapshot
+     * Processa requisição GET para /api/horus/cameras/:id/snapshot
+     *
+     * Delega ao CameraService a imagem (da memória, para câmeras
+     * cadastradas, ou buscada na câmera com cache e coalescing) e entrega
+     * o JPEG bruto, ou um erro em JSON quando a captura falha. A resposta
+     * sai pelo handler quando estiver pronta -- a thread que chamou não
+     * fica esperando.
+     */
+    void CameraController::getSnapshot(const HttpRequest& request, HttpResponseHandler handler)
+    {
+        const int cameraId = parseCameraIdFromPath(request.path, kSnapshotSuffix);
+
+        if (cameraId < 0)
+        {
+            handler(buildErrorResponse(400, "Camera invalida. Use /api/horus/cameras/:id/snapshot"));
+            return;
+        }
+
+        if (!m_service.hasCamera(cameraId))
+        {
+            handler(buildErrorResponse(404, "Camera nao cadastrada"));
+            return;
+        }
+
+        m_service.getSnapshot(cameraId, [handler = std::move(handler)](CameraService::SnapshotPtr dto)
+        {
+            if (!dto->success)
+            {
+                // 502 Bad Gateway: a API esta ok, quem falhou foi o upstream (a camera)
+                handler(buildErrorResponse(502,
+                    dto->message.empty() ? "Falha ao obter snapshot da camera" : dto->message));
+                return;
+            }
+
+            HttpResponse response;
+            response.status = 200;
+            response.body.assign(dto->data.begin(), dto->data.end());
+            response.headers["Content-Type"] = dto->contentType;
+            response.headers["Cache-Control"] = "no-store, no-cache, must-revalidate";
+            response.headers["Access-Control-Allow-Origin"] = "*";
+
+            handler(std::move(response));
+        });
+    }
+
+    /**
+     * Processa requisição GET para /api/horus/cameras/:id/stream
      *
-     * Delega ao CameraService a captura da imagem (Digest Auth) e
-     * retorna o JPEG bruto, ou um erro em JSON quando a captura falha.
+     * Responde multipart/x-mixed-replace (MJPEG): o navegador troca a
+     * imagem a cada parte recebida, direto num <img src=...>. Cada frame
+     * que o CameraPoller captura é enviado a todos os espectadores da
+     * câmera; espectador lento recebe só o frame mais recente.
      */
-    HttpResponse CameraController::getSnapshot(const HttpRequest& request)
+    void CameraController::getStream(const HttpRequest& request, HttpResponseHandler handler)
     {
-        const int channel = parseChannelFromPath(request.path);
+        const int cameraId = parseCameraIdFromPath(request.path, kStreamSuffix);
 
-        if (channel < 0)
+        if (cameraId < 0)
         {
-            return buildErrorResponse(400, "Canal invalido. Use /api/horus/cameras/:channel/snapshot");
+            handler(buildErrorResponse(400, "Camera invalida. Use /api/horus/cameras/:id/stream"));
+            return;
         }
 
-        auto dto = m_service.getSnapshot(channel);
+        auto subscription = m_service.subscribe(cameraId);
 
-        if (!dto.success)
+        if (!subscription)
         {
-            // 502 Bad Gateway: a API esta ok, quem falhou foi o upstream (a camera)
-            return buildErrorResponse(502,
-                dto.message.empty() ? "Falha ao obter snapshot da camera" : dto.message);
+            handler(buildErrorResponse(404, "Camera nao cadastrada (streaming exige cadastro em horus.came_camera)"));
+            return;
         }
 
         HttpResponse response;
         response.status = 200;
-        response.body.assign(dto.data.begin(), dto.data.end());
-        response.headers["Content-Type"] = dto.contentType;
+        response.headers["Content-Type"] = std::string("multipart/x-mixed-replace; boundary=") + kMjpegBoundary;
         response.headers["Cache-Control"] = "no-store, no-cache, must-revalidate";
         response.headers["Access-Control-Allow-Origin"] = "*";
+        response.stream = std::make_shared<MjpegStream>(std::move(subscription));
 
-        return response;
+        handler(std::move(response));
     }
 }
@@ -3,6 +3,9 @@
 #include "../../../services/modules/Horus/CameraService.hpp"
 #include "../../../common/HttpResponse.hpp"
 #include "../../../common/HttpRequest.hpp"
+#include "../../../config/ApiConfig.hpp"
+
+#include <boost/asio/io_context.hpp>
 
 namespace Aether::Api
 {
@@ -19,25 +22,45 @@ namespace Aether::Api
     {
         public:
             /**
-             * @brief Processa requisição GET de snapshot de uma câmera
+             * @brief Construtor
+             * @param ioContext io_context do HttpServer, repassado ao CameraService
+             * @param config Configuração da API (usa camera e horusDatabase)
+             */
+            CameraController(boost::asio::io_context& ioContext, const ApiConfig& config);
+
+            /**
+             * @brief Processa requisição GET de snapshot de uma câmera (assíncrono)
+             *
+             * Rota: GET /api/horus/cameras/:id/snapshot
+             *
+             * @param request Requisição HTTP recebida
+             * @param handler Recebe a resposta HTTP com a imagem JPEG
+             *        (Content-Type: image/jpeg) ou um erro em JSON quando a
+             *        captura falha
+             */
+            void getSnapshot(const HttpRequest& request, HttpResponseHandler handler);
+
+            /**
+             * @brief Processa requisição GET de stream MJPEG de uma câmera
              *
-             * Rota: GET /api/horus/cameras/:channel/snapshot
+             * Rota: GET /api/horus/cameras/:id/stream
              *
              * @param request Requisição HTTP recebida
-             * @return Resposta HTTP com a imagem JPEG (Content-Type: image/jpeg)
-             *         ou um erro em JSON quando a captura falha
+             * @param handler Recebe a resposta em streaming
+             *        (multipart/x-mixed-replace), ou um erro em JSON
              */
-            HttpResponse getSnapshot(const HttpRequest& request);
+            void getStream(const HttpRequest& request, HttpResponseHandler handler);
 
         private:
             CameraService m_service;  /**< Service de câmeras */
 
             /**
-             * @brief Extrai o número do canal a partir do path da requisição
+             * @brief Extrai o id da câmera a partir do path da requisição
              * (ex: "/api/horus/cameras/1/snapshot" -> 1)
              * @param path Path da requisição
-             * @return Número do canal, ou -1 se o path for inválido
+             * @param action Último segmento esperado (ex: "snapshot", "stream")
+             * @return Id da câmera, ou -1 se o path for inválido
              */
-            static int parseChannelFromPath(const std::string& path);
+            static int parseCameraIdFromPath(const std::string& path, const std::string& action);
     };
 }
@@ -0,0 +1,13 @@
+#include "MetricsService.hpp"
+#include "../core/utils/Metrics.hpp"
+
+namespace Aether::Api
+{
+    /**
+     * Renderiza o registro global de métricas do Core
+     */
+    std::string MetricsService::get()
+    {
+        return Aether::Core::Utils::Metrics::renderPrometheus();
+    }
+}
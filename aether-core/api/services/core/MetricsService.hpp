@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Service do controler MetricsController
+     *
+     * Lê as métricas registradas pelo Core (TCP, Parser, Router, banco,
+     * agendador, HTTP e câmeras) em Aether::Core::Utils::Metrics.
+     *
+     * @see MetricsController
+     */
+    class MetricsService
+    {
+    public:
+        /**
+         * @brief Retorna todas as métricas no formato texto do Prometheus
+         * @return Corpo pronto para a resposta HTTP
+         */
+        static std::string get();
+    };
+}
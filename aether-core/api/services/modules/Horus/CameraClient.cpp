@@ -0,0 +1,278 @@
+#include "CameraClient.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/beast/http.hpp>
+
+#include <utility>
+
+namespace Aether::Api
+{
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    using tcp = boost::asio::ip::tcp;
+
+    /**
+     * Uma requisição em andamento (GET -> resposta, com as repetições de
+     * reconexão/desafio). Vive como shared_ptr capturado pelos callbacks
+     * e roda sempre no strand do CameraClient.
+     *
+     * - Com desafio conhecido, já envia o Authorization (1 round trip)
+     * - 401 sem termos enviado Authorization, ou com stale=true -> adota o
+     *   novo desafio e repete a requisição uma vez
+     * - 401 com Authorization e sem stale -> credenciais recusadas, erro
+     * - Erro de I/O numa conexão reaproveitada (câmera fechou o keep-alive
+     *   ocioso) -> reconecta e repete uma vez
+     */
+    class CameraClient::Exchange : public std::enable_shared_from_this<Exchange>
+    {
+        public:
+            Exchange(CameraClient& client, std::string target, ResponseHandler handler)
+                : m_client(client)
+                , m_target(std::move(target))
+                , m_handler(std::move(handler))
+            {
+            }
+
+            void start()
+            {
+                if (!m_client.m_idle.empty())
+                {
+                    m_connection = std::move(m_client.m_idle.back());
+                    m_client.m_idle.pop_back();
+                    m_reused = true;
+                    send();
+                    return;
+                }
+
+                connect();
+            }
+
+        private:
+            CameraClient& m_client;
+            std::string m_target;
+            ResponseHandler m_handler;
+
+            std::unique_ptr<Connection> m_connection;
+            std::unique_ptr<tcp::resolver> m_resolver;
+            http::request<http::empty_body> m_request;
+            http::response<http::vector_body<std::uint8_t>> m_response;
+
+            bool m_reused = false;              /**< A conexão atual veio do pool */
+            bool m_sentAuth = false;            /**< A última requisição levou Authorization */
+            bool m_retriedConnection = false;
+            bool m_retriedChallenge = false;
+
+            void connect()
+            {
+                m_reused = false;
+                m_connection = std::make_unique<Connection>(m_client.m_strand);
+
+                if (!m_client.m_endpoints.empty())
+                {
+                    doConnect();
+                    return;
+                }
+
+                m_resolver = std::make_unique<tcp::resolver>(m_client.m_strand);
+                m_resolver->async_resolve(
+                    m_client.m_host,
+                    m_client.m_port,
+                    [self = shared_from_this()](beast::error_code ec, tcp::resolver::results_type results)
+                    {
+                        self->m_resolver.reset();
+
+                        if (ec)
+                        {
+                            self->fail(ec);
+                            return;
+                        }
+
+                        self->m_client.m_endpoints = std::move(results);
+                        self->doConnect();
+                    });
+            }
+
+            void doConnect()
+            {
+                m_connection->stream.expires_after(m_client.m_connectTimeout);
+                m_connection->stream.async_connect(
+                    m_client.m_endpoints,
+                    [self = shared_from_this()](beast::error_code ec, const tcp::endpoint&)
+                    {
+                        if (ec)
+                        {
+                            // Endereço pode ter mudado (DHCP/DNS): resolve de novo na próxima
+                            self->m_client.m_endpoints = {};
+                            self->fail(ec);
+                            return;
+                        }
+
+                        self->send();
+                    });
+            }
+
+            void send()
+            {
+                m_sentAuth = m_client.m_auth.hasChallenge();
+
+                m_request = {http::verb::get, m_target, 11};
+                m_request.set(http::field::host, m_client.m_host);
+                m_request.set(http::field::user_agent, "Aether-Core");
+                m_request.keep_alive(true);
+
+                if (m_sentAuth)
+                    m_request.set(http::field::authorization, m_client.m_auth.authorization("GET", m_target));
+
+                m_response = {};
+
+                m_connection->stream.expires_after(m_client.m_requestTimeout);
+                http::async_write(
+                    m_connection->stream,
+                    m_request,
+                    [self = shared_from_this()](beast::error_code ec, std::size_t)
+                    {
+                        if (ec)
+                        {
+                            self->onIoError(ec);
+                            return;
+                        }
+
+                        http::async_read(
+                            self->m_connection->stream,
+                            self->m_connection->buffer,
+                            self->m_response,
+                            [self](beast::error_code ec, std::size_t)
+                            {
+                                if (ec)
+                                    self->onIoError(ec);
+                                else
+                                    self->onResponse();
+                            });
+                    });
+            }
+
+            void onIoError(beast::error_code ec)
+            {
+                m_connection.reset();
+
+                if (m_reused && !m_retriedConnection && ec != beast::error::timeout)
+                {
+                    m_retriedConnection = true;
+                    connect();
+                    return;
+                }
+
+                fail(ec);
+            }
+
+            void onResponse()
+            {
+                const bool keepAlive = m_response.keep_alive();
+                if (!keepAlive)
+                    m_connection.reset();
+
+                Dto::CameraSnapshotResponse result;
+
+                if (m_response.result_int() == 401)
+                {
+                    const std::string wwwAuthenticate(m_response[http::field::www_authenticate]);
+
+                    if (wwwAuthenticate.empty())
+                    {
+                        result.httpStatus = 401;
+                        result.message = "Camera nao retornou header WWW-Authenticate";
+                        finish(std::move(result));
+                        return;
+                    }
+
+                    const bool stale = DigestAuth::isStale(wwwAuthenticate);
+
+                    // Guarda o desafio mesmo quando não repete: câmeras que não
+                    // mandam stale=true ao expirar o nonce voltam a funcionar na
+                    // próxima requisição
+                    m_client.m_auth.setChallenge(wwwAuthenticate);
+
+                    if ((!m_sentAuth || stale) && !m_retriedChallenge)
+                    {
+                        m_retriedChallenge = true;
+
+                        if (m_connection)
+                        {
+                            m_reused = false;
+                            send();
+                        }
+                        else
+                        {
+                            connect();
+                        }
+                        return;
+                    }
+                }
+
+                result.httpStatus = m_response.result_int();
+                result.success = m_response.result_int() == 200;
+
+                if (result.success)
+                {
+                    result.data = std::move(m_response.body());
+
+                    if (m_response.count(http::field::content_type))
+                        result.contentType = std::string(m_response[http::field::content_type]);
+                }
+                else if (result.httpStatus == 401)
+                {
+                    result.message = "Falha na autenticacao Digest ou na captura do snapshot (status 401)";
+                }
+                else
+                {
+                    result.message = "Camera retornou status inesperado (" +
+                        std::to_string(result.httpStatus) + ")";
+                }
+
+                if (m_connection && m_client.m_idle.size() < m_client.m_maxIdleConnections)
+                {
+                    m_connection->stream.expires_never();
+                    m_client.m_idle.push_back(std::move(m_connection));
+                }
+
+                finish(std::move(result));
+            }
+
+            void fail(beast::error_code ec)
+            {
+                m_connection.reset();
+
+                Dto::CameraSnapshotResponse result;
+                result.success = false;
+                result.message = ec == beast::error::timeout
+                    ? std::string("Timeout ao falar com a camera")
+                    : "Erro ao conectar na camera: " + ec.message();
+
+                finish(std::move(result));
+            }
+
+            void finish(Dto::CameraSnapshotResponse result)
+            {
+                auto handler = std::move(m_handler);
+                handler(std::move(result));
+            }
+    };
+
+    CameraClient::CameraClient(boost::asio::io_context& ioContext, const CameraConfig& config)
+        : m_strand(boost::asio::make_strand(ioContext))
+        , m_host(config.host)
+        , m_port(std::to_string(config.port))
+        , m_connectTimeout(config.connectTimeout)
+        , m_requestTimeout(config.requestTimeout)
+        , m_maxIdleConnections(config.maxIdleConnections)
+        , m_auth(config.user, config.password)
+    {
+    }
+
+    void CameraClient::asyncGet(std::string target, ResponseHandler handler)
+    {
+        auto exchange = std::make_shared<Exchange>(*this, std::move(target), std::move(handler));
+
+        boost::asio::post(m_strand, [exchange]() { exchange->start(); });
+    }
+}
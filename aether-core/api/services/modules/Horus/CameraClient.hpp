@@ -0,0 +1,106 @@
+#pragma once
+
+#include "DigestAuth.hpp"
+#include "../../../config/CameraConfig.hpp"
+#include "../../../dto/modules/Horus/CameraSnapshotResponse.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Cliente HTTP assíncrono de uma câmera IP, com conexões persistentes
+     *
+     * Roda inteiro no io_context do HttpServer: nenhuma operação bloqueia
+     * uma thread do pool. Câmera lenta ou fora do ar custa só um timer
+     * (CameraConfig::connectTimeout / requestTimeout) -- as threads da API
+     * continuam atendendo as outras requisições enquanto isso.
+     *
+     * Mantém por câmera:
+     * - o endpoint já resolvido (DNS só na primeira requisição ou depois de
+     *   uma falha de conexão)
+     * - um pool de conexões HTTP/1.1 keep-alive ociosas
+     *   (até CameraConfig::maxIdleConnections), reaproveitadas entre snapshots
+     * - o desafio Digest (DigestAuth), reaproveitado com nc incremental
+     *
+     * Com isso um snapshot custa um único round trip na câmera. O desafio só
+     * é renovado quando ainda não existe ou quando a câmera responde 401 com
+     * stale=true; se a conexão reaproveitada tiver sido fechada pela câmera,
+     * ela é reaberta uma única vez.
+     *
+     * Todo o estado (pool, endpoint, DigestAuth) é acessado só dentro de
+     * um strand próprio da câmera, então não há lock: requisições para a
+     * mesma câmera podem estar em andamento ao mesmo tempo, cada uma na sua
+     * conexão, mas seus callbacks nunca rodam em paralelo.
+     *
+     * @warning O io_context precisa sobreviver ao CameraClient.
+     *
+     * @see DigestAuth
+     * @see CameraService
+     */
+    class CameraClient
+    {
+        public:
+            /**
+             * @brief Callback de conclusão de asyncGet(). Roda no strand da câmera.
+             */
+            using ResponseHandler = std::function<void(Dto::CameraSnapshotResponse)>;
+
+            /**
+             * @brief Construtor
+             * @param ioContext io_context onde as operações assíncronas rodam
+             * @param config Configuração de acesso à câmera (host, porta, credenciais, prazos)
+             */
+            CameraClient(boost::asio::io_context& ioContext, const CameraConfig& config);
+
+            /**
+             * @brief Faz um GET autenticado na câmera, de forma assíncrona
+             *
+             * Retorna na hora; @p handler é chamado uma única vez com o
+             * corpo da resposta ou com a mensagem de erro (nunca lança).
+             *
+             * @param target Path + query a requisitar (ex: /cgi-bin/snapshot.cgi?channel=1)
+             * @param handler Callback de conclusão
+             */
+            void asyncGet(std::string target, ResponseHandler handler);
+
+        private:
+            class Exchange;
+            friend class Exchange;
+
+            using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+            /**
+             * @brief Uma conexão com a câmera e o seu buffer de leitura
+             */
+            struct Connection
+            {
+                boost::beast::tcp_stream stream;    /**< Socket com suporte a prazo (expires_after) */
+                boost::beast::flat_buffer buffer;   /**< Buffer de leitura, preso à conexão */
+
+                explicit Connection(const Strand& strand) : stream(strand) {}
+            };
+
+            Strand m_strand;                                            /**< Serializa o acesso ao estado abaixo */
+            std::string m_host;                                         /**< Host da câmera (também vai no header Host) */
+            std::string m_port;                                         /**< Porta da câmera, já em texto pro resolver */
+            std::chrono::milliseconds m_connectTimeout;                 /**< Prazo de conexão */
+            std::chrono::milliseconds m_requestTimeout;                 /**< Prazo de requisição/resposta */
+            std::size_t m_maxIdleConnections;                           /**< Limite do pool de conexões ociosas */
+
+            boost::asio::ip::tcp::resolver::results_type m_endpoints;   /**< Endpoint resolvido (cache de DNS) */
+            std::vector<std::unique_ptr<Connection>> m_idle;            /**< Conexões keep-alive ociosas */
+            DigestAuth m_auth;                                          /**< Desafio Digest reaproveitado */
+    };
+}
@@ -0,0 +1,103 @@
+#include "CameraPoller.hpp"
+#include "../core/utils/logger.hpp"
+#include "../core/utils/Metrics.hpp"
+
+namespace Aether::Api
+{
+    CameraPoller::CameraPoller(
+        boost::asio::io_context& ioContext,
+        const CameraRegistry& registry,
+        FrameStore& frames)
+        : m_frames(frames)
+    {
+        m_cameras.reserve(registry.cameras().size());
+
+        for (const auto& camera : registry.cameras())
+            m_cameras.push_back(std::make_unique<PolledCamera>(ioContext, camera));
+    }
+
+    CameraPoller::~CameraPoller()
+    {
+        for (auto& polled : m_cameras)
+            polled->timer.cancel();
+    }
+
+    /**
+     * Espalha o primeiro ciclo de cada câmera ao longo de um pollInterval
+     * (câmera i de n começa em i/n do intervalo).
+     */
+    void CameraPoller::start()
+    {
+        const auto count = static_cast<long>(m_cameras.size());
+
+        for (long i = 0; i < count; ++i)
+        {
+            auto& polled = *m_cameras[i];
+
+            polled.timer.expires_after(polled.camera.config.pollInterval * i / count);
+            polled.timer.async_wait([this, &polled](const boost::system::error_code& ec)
+            {
+                if (!ec)
+                    poll(polled);
+            });
+        }
+    }
+
+    void CameraPoller::schedule(PolledCamera& polled)
+    {
+        polled.timer.expires_at(polled.timer.expiry() + polled.camera.config.pollInterval);
+
+        // Atrasou mais de um ciclo (ex: máquina suspensa): realinha em vez
+        // de disparar vários ciclos seguidos pra "recuperar"
+        if (polled.timer.expiry() < std::chrono::steady_clock::now())
+            polled.timer.expires_after(polled.camera.config.pollInterval);
+
+        polled.timer.async_wait([this, &polled](const boost::system::error_code& ec)
+        {
+            if (!ec)
+                poll(polled);
+        });
+    }
+
+    void CameraPoller::poll(PolledCamera& polled)
+    {
+        schedule(polled);
+
+        if (polled.inFlight.exchange(true))
+            return;
+
+        using Core::Utils::Metrics;
+        static auto& fetchTime = Metrics::histogram(
+            "aether_camera_fetch_seconds", "Duracao das buscas de snapshot nas cameras", "source=\"poller\"");
+        static auto& failures = Metrics::counter(
+            "aether_camera_fetch_failures_total", "Buscas de snapshot que falharam", "source=\"poller\"");
+
+        polled.client.asyncGet(
+            polled.camera.snapshotTarget,
+            [this, &polled, start = std::chrono::steady_clock::now()](Dto::CameraSnapshotResponse dto)
+            {
+                fetchTime.observe(std::chrono::steady_clock::now() - start);
+                if (!dto.success)
+                    failures.inc();
+
+                // Roda no strand do CameraClient da câmera: `failing` não precisa de lock.
+                // Loga só quando a câmera cai ou volta, não a cada ciclo
+                if (dto.success == polled.failing)
+                {
+                    polled.failing = !dto.success;
+                    if (dto.success)
+                        AETHER_LOG_INFO("CameraPoller", "Camera voltou a responder",
+                                        AetherCoreLogger::field("id", polled.camera.id), AetherCoreLogger::field("name", polled.camera.name));
+                    else
+                        AETHER_LOG_WARN("CameraPoller", "Camera sem resposta",
+                                        AetherCoreLogger::field("id", polled.camera.id), AetherCoreLogger::field("name", polled.camera.name),
+                                        AetherCoreLogger::field("error", dto.message));
+                }
+
+                polled.inFlight = false;
+                m_frames.publish(
+                    polled.camera.id,
+                    std::make_shared<const Dto::CameraSnapshotResponse>(std::move(dto)));
+            });
+    }
+}
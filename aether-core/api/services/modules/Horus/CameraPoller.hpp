@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CameraClient.hpp"
+#include "CameraRegistry.hpp"
+#include "FrameStore.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Atualiza em segundo plano o snapshot de todas as câmeras cadastradas
+     *
+     * Para cada câmera do CameraRegistry, um steady_timer no io_context do
+     * HttpServer dispara a cada CameraConfig::pollInterval uma busca pelo
+     * CameraClient da câmera e publica o resultado no FrameStore.
+     *
+     * - Cadência fixa (o próximo ciclo é agendado a partir do prazo do
+     *   anterior, não do fim da busca), com os primeiros ciclos espalhados
+     *   ao longo de um intervalo pra não bater em todas as câmeras juntas
+     * - No máximo uma busca em andamento por câmera: se a anterior ainda
+     *   não terminou, o ciclo é pulado -- câmera lenta não acumula fila
+     * - Nada bloqueia: câmera fora do ar custa só o timer e o prazo do
+     *   CameraClient
+     *
+     * @warning O io_context, o registro e o FrameStore precisam sobreviver
+     * ao CameraPoller.
+     *
+     * @see FrameStore
+     * @see CameraRegistry
+     */
+    class CameraPoller
+    {
+        public:
+            /**
+             * @brief Construtor -- monta um CameraClient e um timer por câmera
+             * @param ioContext io_context onde timers e buscas rodam
+             * @param registry Câmeras a atualizar
+             * @param frames Destino dos snapshots
+             */
+            CameraPoller(
+                boost::asio::io_context& ioContext,
+                const CameraRegistry& registry,
+                FrameStore& frames);
+
+            /** @brief Cancela os timers */
+            ~CameraPoller();
+
+            /** @brief Agenda o primeiro ciclo de cada câmera (não bloqueia) */
+            void start();
+
+        private:
+            /**
+             * @brief Estado de polling de uma câmera
+             */
+            struct PolledCamera
+            {
+                const HorusCamera& camera;                      /**< Cadastro (vive no CameraRegistry) */
+                CameraClient client;                            /**< Conexões keep-alive + Digest da câmera */
+                boost::asio::steady_timer timer;                /**< Próximo ciclo */
+                std::atomic<bool> inFlight{false};              /**< Há uma busca em andamento */
+                bool failing = false;                           /**< Último ciclo falhou (loga só na transição) */
+
+                PolledCamera(boost::asio::io_context& ioContext, const HorusCamera& camera)
+                    : camera(camera)
+                    , client(ioContext, camera.config)
+                    , timer(ioContext)
+                {
+                }
+            };
+
+            FrameStore& m_frames;                                   /**< Destino dos snapshots */
+            std::vector<std::unique_ptr<PolledCamera>> m_cameras;   /**< Uma entrada por câmera cadastrada */
+
+            /** @brief Agenda o próximo ciclo de uma câmera */
+            void schedule(PolledCamera& polled);
+
+            /** @brief Dispara a busca de um ciclo (ou pula, se a anterior não terminou) */
+            void poll(PolledCamera& polled);
+    };
+}
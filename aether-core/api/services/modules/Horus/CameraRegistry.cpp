@@ -0,0 +1,147 @@
+#include "CameraRegistry.hpp"
+#include "../core/utils/logger.hpp"
+
+#include "PostgresDriver.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Aether::Api
+{
+    /**
+     * Lê horus.came_camera (só ativas) e monta uma HorusCamera por linha.
+     * Linhas com link_connection inválido são ignoradas com log -- uma
+     * câmera mal cadastrada não impede as outras de subirem.
+     */
+    CameraRegistry CameraRegistry::loadFromDatabase(
+        const HorusDatabaseConfig& database,
+        const CameraConfig& defaults)
+    {
+        CameraRegistry registry;
+
+        if (!database.enabled)
+            return registry;
+
+        PostgresDriver conn(database.connectionString());
+
+        if (!conn.isConnected())
+        {
+            AETHER_LOG_WARN("Horus", "Banco indisponivel, usando a camera unica do CameraConfig");
+            return registry;
+        }
+
+        PGresult* resultDb = conn.query(R"(
+            SELECT id, camera_name, link_connection, username, password
+            FROM horus.came_camera
+            WHERE active = TRUE
+            ORDER BY id
+        )");
+
+        if (!resultDb || PQresultStatus(resultDb) != PGRES_TUPLES_OK)
+        {
+            AETHER_LOG_ERROR("Horus", "Falha ao carregar as cameras", AetherCoreLogger::field("error", PQerrorMessage(conn.get())));
+            PostgresDriver::freeResult(resultDb);
+            return registry;
+        }
+
+        const int numRows = PQntuples(resultDb);
+        const int colId       = PQfnumber(resultDb, "id");
+        const int colName     = PQfnumber(resultDb, "camera_name");
+        const int colLink     = PQfnumber(resultDb, "link_connection");
+        const int colUser     = PQfnumber(resultDb, "username");
+        const int colPassword = PQfnumber(resultDb, "password");
+
+        registry.m_cameras.reserve(numRows);
+
+        for (int i = 0; i < numRows; i++)
+        {
+            HorusCamera camera;
+            camera.id     = std::atoi(PQgetvalue(resultDb, i, colId));
+            camera.name   = PQgetvalue(resultDb, i, colName);
+            camera.config = defaults;
+
+            const std::string link = PQgetvalue(resultDb, i, colLink);
+            if (!parseLinkConnection(link, camera))
+            {
+                AETHER_LOG_WARN("Horus", "Camera ignorada: link_connection invalido",
+                                AetherCoreLogger::field("id", camera.id), AetherCoreLogger::field("link", link));
+                continue;
+            }
+
+            if (!PQgetisnull(resultDb, i, colUser))
+                camera.config.user = PQgetvalue(resultDb, i, colUser);
+
+            if (!PQgetisnull(resultDb, i, colPassword))
+                camera.config.password = PQgetvalue(resultDb, i, colPassword);
+
+            registry.m_cameras.push_back(std::move(camera));
+        }
+
+        PostgresDriver::freeResult(resultDb);
+
+        AETHER_LOG_INFO("Horus", "Cameras carregadas", AetherCoreLogger::field("count", registry.m_cameras.size()));
+        return registry;
+    }
+
+    const HorusCamera* CameraRegistry::find(int id) const
+    {
+        const auto it = std::lower_bound(
+            m_cameras.begin(), m_cameras.end(), id,
+            [](const HorusCamera& camera, int value) { return camera.id < value; });
+
+        if (it == m_cameras.end() || it->id != id)
+            return nullptr;
+
+        return &*it;
+    }
+
+    bool CameraRegistry::parseLinkConnection(const std::string& url, HorusCamera& camera)
+    {
+        const std::string scheme = "http://";
+        if (url.compare(0, scheme.size(), scheme) != 0)
+            return false;
+
+        const auto authorityStart = scheme.size();
+        const auto pathStart = url.find_first_of("/?", authorityStart);
+        std::string authority = url.substr(authorityStart, pathStart - authorityStart);
+
+        // Sem path: assume o snapshot cgi-bin padrão, canal 1
+        std::string target = pathStart == std::string::npos ? camera.config.cgiPath + "1" : url.substr(pathStart);
+        if (target.front() == '?')
+            target.insert(target.begin(), '/');
+
+        const auto at = authority.rfind('@');
+        if (at != std::string::npos)
+        {
+            const std::string userInfo = authority.substr(0, at);
+            const auto colon = userInfo.find(':');
+
+            camera.config.user = userInfo.substr(0, colon);
+            camera.config.password = colon == std::string::npos ? "" : userInfo.substr(colon + 1);
+            authority.erase(0, at + 1);
+        }
+
+        uint16_t port = 80;
+        const auto colon = authority.rfind(':');
+        if (colon != std::string::npos && authority.find(']', colon) == std::string::npos)
+        {
+            const int parsed = std::atoi(authority.c_str() + colon + 1);
+            if (parsed <= 0 || parsed > 65535)
+                return false;
+
+            port = static_cast<uint16_t>(parsed);
+            authority.erase(colon);
+        }
+
+        if (authority.size() > 2 && authority.front() == '[' && authority.back() == ']')
+            authority = authority.substr(1, authority.size() - 2);
+
+        if (authority.empty())
+            return false;
+
+        camera.config.host = authority;
+        camera.config.port = port;
+        camera.snapshotTarget = target;
+        return true;
+    }
+}
@@ -1,243 +1,142 @@
 #include "CameraService.hpp"
-#include "../core/utils/Md5.hpp"
 #include "../core/utils/logger.hpp"
+#include "../core/utils/Metrics.hpp"
 
-#include <boost/asio.hpp>
-#include <boost/beast.hpp>
-
-#include <random>
-#include <sstream>
 #include <utility>
 
 namespace Aether::Api
 {
-    namespace beast = boost::beast;
-    namespace http = beast::http;
-    using tcp = boost::asio::ip::tcp;
-
-    namespace
+    CameraService::CameraService(
+        boost::asio::io_context& ioContext,
+        CameraConfig config,
+        const HorusDatabaseConfig& database)
+        : m_config(std::move(config))
+        , m_client(ioContext, m_config)
+        , m_registry(CameraRegistry::loadFromDatabase(database, m_config))
+        , m_frames(m_config.snapshotStaleMaxAge)
+        , m_poller(ioContext, m_registry, m_frames)
     {
-        /**
-         * Gera um cnonce (client nonce) aleatório exigido pelo Digest Auth
-         * quando qop=auth está presente no desafio.
-         */
-        std::string generateCnonce()
-        {
-            std::random_device rd;
-            std::mt19937_64 gen(rd());
-            std::uniform_int_distribution<std::uint64_t> dist;
+        for (const auto& camera : m_registry.cameras())
+            m_frames.addCamera(camera.id);
 
-            std::ostringstream oss;
-            oss << std::hex << dist(gen);
-            return oss.str();
-        }
+        m_poller.start();
     }
 
-    CameraService::CameraService(CameraConfig config)
-        : m_config(std::move(config))
+    bool CameraService::hasCamera(int cameraId) const
     {
+        if (m_registry.empty())
+            return cameraId >= 1 && cameraId <= m_config.maxChannel;
+
+        return m_registry.find(cameraId) != nullptr;
     }
 
-    /**
-     * Extrai um parâmetro do header WWW-Authenticate, que chega no formato:
-     * Digest realm="...", nonce="...", qop="auth", opaque="...", ...
-     * (qop as vezes vem sem aspas: qop=auth)
-     */
-    std::string CameraService::extractAuthParam(const std::string& header, const std::string& key)
+    CameraService::ChannelCache& CameraService::cacheFor(int channel)
     {
-        const std::string quotedMarker = key + "=\"";
-        auto pos = header.find(quotedMarker);
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
 
-        if (pos != std::string::npos)
-        {
-            pos += quotedMarker.size();
-            const auto end = header.find('"', pos);
-            if (end == std::string::npos)
-                return "";
+        auto& entry = m_cache[channel];
+        if (!entry)
+            entry = std::make_unique<ChannelCache>();
 
-            return header.substr(pos, end - pos);
-        }
-
-        const std::string bareMarker = key + "=";
-        pos = header.find(bareMarker);
-        if (pos == std::string::npos)
-            return "";
+        return *entry;
+    }
 
-        pos += bareMarker.size();
-        const auto end = header.find_first_of(", ", pos);
-        return header.substr(pos, end - pos);
+    std::shared_ptr<FrameSubscription> CameraService::subscribe(int cameraId)
+    {
+        return m_frames.subscribe(cameraId);
     }
 
     /**
-     * Monta o header Authorization: Digest ... (RFC 2617) a partir do
-     * desafio recebido em WWW-Authenticate e das credenciais configuradas.
+     * Com cadastro, serve do FrameStore (alimentado pelo CameraPoller).
+     *
+     * Sem cadastro, serve o snapshot do canal pelo cache, coalescendo as
+     * buscas na câmera única:
+     *
+     * 1. Snapshot dentro de snapshotMaxAge -> entrega o do cache
+     * 2. Já existe busca em andamento -> entrega o snapshot velho (se ainda
+     *    dentro de snapshotStaleMaxAge) ou entra na fila dessa busca
+     * 3. Senão esta requisição dispara a busca (assíncrona) e entra na fila
+     *
+     * Os callbacks são sempre chamados fora do lock do canal.
      */
-    std::string CameraService::buildDigestAuthorizationHeader(
-        const std::string& method,
-        const std::string& uri,
-        const std::string& wwwAuthenticateHeader) const
+    void CameraService::getSnapshot(int cameraId, SnapshotHandler handler)
     {
-        const std::string realm  = extractAuthParam(wwwAuthenticateHeader, "realm");
-        const std::string nonce  = extractAuthParam(wwwAuthenticateHeader, "nonce");
-        const std::string qop    = extractAuthParam(wwwAuthenticateHeader, "qop");
-        const std::string opaque = extractAuthParam(wwwAuthenticateHeader, "opaque");
-
-        const std::string ha1 = Aether::Core::Utils::Md5::hash(
-            m_config.user + ":" + realm + ":" + m_config.password);
+        if (!m_registry.empty())
+        {
+            m_frames.get(cameraId, std::move(handler));
+            return;
+        }
 
-        const std::string ha2 = Aether::Core::Utils::Md5::hash(
-            method + ":" + uri);
+        const int channel = cameraId;
+        auto& cache = cacheFor(channel);
+        std::unique_lock<std::mutex> lock(cache.mutex);
 
-        const std::string cnonce = generateCnonce();
-        const std::string nc = "00000001";
+        const auto age = std::chrono::steady_clock::now() - cache.capturedAt;
 
-        std::string response;
-        if (!qop.empty())
+        if (cache.frame && (age <= m_config.snapshotMaxAge ||
+                            (cache.fetching && age <= m_config.snapshotStaleMaxAge)))
         {
-            response = Aether::Core::Utils::Md5::hash(
-                ha1 + ":" + nonce + ":" + nc + ":" + cnonce + ":" + qop + ":" + ha2);
-        }
-        else
-        {
-            response = Aether::Core::Utils::Md5::hash(
-                ha1 + ":" + nonce + ":" + ha2);
+            auto frame = cache.frame;
+            lock.unlock();
+            handler(std::move(frame));
+            return;
         }
 
-        std::ostringstream authHeader;
-        authHeader << "Digest username=\"" << m_config.user << "\""
-                   << ", realm=\"" << realm << "\""
-                   << ", nonce=\"" << nonce << "\""
-                   << ", uri=\"" << uri << "\""
-                   << ", response=\"" << response << "\"";
+        cache.waiters.push_back(std::move(handler));
 
-        if (!qop.empty())
-        {
-            authHeader << ", qop=" << qop
-                       << ", nc=" << nc
-                       << ", cnonce=\"" << cnonce << "\"";
-        }
+        if (cache.fetching)
+            return;
 
-        if (!opaque.empty())
-        {
-            authHeader << ", opaque=\"" << opaque << "\"";
-        }
+        cache.fetching = true;
+        lock.unlock();
 
-        return authHeader.str();
+        fetchSnapshot(channel, cache);
     }
 
     /**
-     * Captura o snapshot JPEG da câmera autenticando via HTTP Digest:
+     * Captura o snapshot JPEG da câmera pelo CameraClient, que reaproveita
+     * conexões keep-alive e o desafio Digest da câmera (1 round trip).
      *
-     * 1ª requisição (sem Authorization) -> câmera responde 401 com o desafio
-     * 2ª requisição (com Authorization: Digest ...) -> câmera responde 200 com o JPEG
+     * Falhas não substituem o último snapshot bom, só são entregues a quem
+     * estava esperando esta busca específica.
      */
-    Dto::CameraSnapshotResponse CameraService::getSnapshot(int channel)
+    void CameraService::fetchSnapshot(int channel, ChannelCache& cache)
     {
-        Dto::CameraSnapshotResponse result;
-        const std::string uri = m_config.cgiPath + std::to_string(channel);
-
-        try
-        {
-            boost::asio::io_context ioContext;
-            tcp::resolver resolver(ioContext);
-            const auto endpoints = resolver.resolve(m_config.host, std::to_string(m_config.port));
-
-            std::string wwwAuthenticate;
-
-            // 1a requisicao - obtem o desafio Digest (401 + WWW-Authenticate)
+        using Core::Utils::Metrics;
+        static auto& fetchTime = Metrics::histogram(
+            "aether_camera_fetch_seconds", "Duracao das buscas de snapshot nas cameras", "source=\"on_demand\"");
+        static auto& failures = Metrics::counter(
+            "aether_camera_fetch_failures_total", "Buscas de snapshot que falharam", "source=\"on_demand\"");
+
+        m_client.asyncGet(
+            m_config.cgiPath + std::to_string(channel),
+            [&cache, start = std::chrono::steady_clock::now()](Dto::CameraSnapshotResponse dto)
             {
-                tcp::socket socket(ioContext);
-                boost::asio::connect(socket, endpoints);
-
-                http::request<http::empty_body> request{http::verb::get, uri, 11};
-                request.set(http::field::host, m_config.host);
-                request.set(http::field::user_agent, "Aether-Core");
+                fetchTime.observe(std::chrono::steady_clock::now() - start);
 
-                http::write(socket, request);
+                if (!dto.success)
+                {
+                    failures.inc();
+                    AETHER_LOG_WARN("CameraService", "Falha no snapshot", AetherCoreLogger::field("error", dto.message));
+                }
 
-                beast::flat_buffer buffer;
-                http::response<http::vector_body<std::uint8_t>> response;
-                http::read(socket, buffer, response);
+                auto result = std::make_shared<const Dto::CameraSnapshotResponse>(std::move(dto));
+                std::vector<SnapshotHandler> waiters;
 
-                if (response.result_int() != 401)
                 {
-                    // Camera nao exigiu autenticacao (ou ja respondeu a imagem direto)
-                    result.httpStatus = response.result_int();
-                    result.success = response.result_int() == 200;
+                    std::lock_guard<std::mutex> lock(cache.mutex);
+                    cache.fetching = false;
+                    waiters.swap(cache.waiters);
 
-                    if (result.success)
-                    {
-                        result.data = std::move(response.body());
-                        if (response.count(http::field::content_type))
-                            result.contentType = std::string(response[http::field::content_type]);
-                    }
-                    else
+                    if (result->success)
                     {
-                        result.message = "Camera retornou status inesperado (" +
-                            std::to_string(result.httpStatus) + ")";
+                        cache.frame = result;
+                        cache.capturedAt = std::chrono::steady_clock::now();
                     }
-
-                    beast::error_code ec;
-                    socket.shutdown(tcp::socket::shutdown_both, ec);
-                    return result;
                 }
 
-                wwwAuthenticate = std::string(response[http::field::www_authenticate]);
-
-                beast::error_code ec;
-                socket.shutdown(tcp::socket::shutdown_both, ec);
-            }
-
-            if (wwwAuthenticate.empty())
-            {
-                result.message = "Camera nao retornou header WWW-Authenticate";
-                return result;
-            }
-
-            const std::string authorization =
-                buildDigestAuthorizationHeader("GET", uri, wwwAuthenticate);
-
-            // 2a requisicao - com Authorization: Digest ...
-            tcp::socket socket(ioContext);
-            boost::asio::connect(socket, endpoints);
-
-            http::request<http::empty_body> request{http::verb::get, uri, 11};
-            request.set(http::field::host, m_config.host);
-            request.set(http::field::user_agent, "Aether-Core");
-            request.set(http::field::authorization, authorization);
-
-            http::write(socket, request);
-
-            beast::flat_buffer buffer;
-            http::response<http::vector_body<std::uint8_t>> response;
-            http::read(socket, buffer, response);
-
-            result.httpStatus = response.result_int();
-            result.success = response.result_int() == 200;
-
-            if (result.success)
-            {
-                result.data = std::move(response.body());
-
-                if (response.count(http::field::content_type))
-                    result.contentType = std::string(response[http::field::content_type]);
-            }
-            else
-            {
-                result.message = "Falha na autenticacao Digest ou na captura do snapshot (status " +
-                    std::to_string(result.httpStatus) + ")";
-            }
-
-            beast::error_code ec;
-            socket.shutdown(tcp::socket::shutdown_both, ec);
-        }
-        catch (const std::exception& e)
-        {
-            result.success = false;
-            result.message = std::string("Erro ao conectar na camera: ") + e.what();
-            AetherCoreLogger::Log(std::string("[CameraService] ") + result.message);
-        }
-
-        return result;
+                for (auto& waiter : waiters)
+                    waiter(result);
+            });
     }
 }
@@ -1,9 +1,22 @@
 #pragma once
 
+#include "CameraClient.hpp"
+#include "CameraPoller.hpp"
+#include "CameraRegistry.hpp"
+#include "FrameStore.hpp"
 #include "../../../config/CameraConfig.hpp"
+#include "../../../config/HorusDatabaseConfig.hpp"
 #include "../../../dto/modules/Horus/CameraSnapshotResponse.hpp"
 
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Aether::Api
 {
@@ -13,54 +26,135 @@ namespace Aether::Api
      * Contém a lógica de negócio para capturar o snapshot (JPEG) de uma
      * câmera IP autenticada via HTTP Digest Authentication (RFC 2617).
      *
-     * Fluxo:
-     * 1. Envia GET sem Authorization para obter o desafio (401 + WWW-Authenticate)
-     * 2. Calcula HA1/HA2/response (MD5) a partir do desafio e das credenciais
-     * 3. Reenvia GET com o header Authorization: Digest ...
-     * 4. Retorna os bytes crus da imagem (JPEG)
+     * Dois modos, decididos na construção:
+     * - Câmeras cadastradas (CameraRegistry carregou horus.came_camera):
+     *   o CameraPoller mantém o último snapshot de cada câmera no
+     *   FrameStore, e getSnapshot() responde direto da memória. O :id da
+     *   rota é o horus.came_camera.id.
+     * - Sem cadastro (banco desabilitado/fora do ar ou tabela vazia): busca
+     *   sob demanda na câmera única do CameraConfig, com o cache e
+     *   coalescing por canal descritos abaixo. O :id da rota é o canal.
+     *
+     * A conversa com a câmera fica no CameraClient, que mantém conexões
+     * keep-alive e reaproveita o desafio Digest: depois do primeiro 401,
+     * cada snapshot é um único GET já com Authorization: Digest ...
+     *
+     * Totalmente assíncrono: getSnapshot() retorna na hora e entrega o
+     * resultado por callback, então nenhuma thread do HttpServer fica
+     * presa esperando uma câmera lenta ou fora do ar.
+     *
+     * Cache e coalescing por canal (modo sem cadastro):
+     * - Um snapshot com menos de CameraConfig::snapshotMaxAge é servido
+     *   direto da memória, sem tocar na câmera.
+     * - Só uma busca por canal fica em andamento de cada vez (single-flight):
+     *   quem chega enquanto ela acontece recebe o snapshot anterior, se ele
+     *   ainda estiver dentro de CameraConfig::snapshotStaleMaxAge, ou espera
+     *   o resultado da busca em andamento (fica na fila de callbacks dela)
+     *   -- nunca abre uma segunda busca.
+     *
+     * Thread-safe: uma única instância é compartilhada por todas as threads
+     * do HttpServer (via Router -> CameraController).
      *
      * @see CameraController
      * @see CameraConfig
+     * @see CameraPoller
      */
     class CameraService
     {
         public:
             /**
-             * @brief Construtor
-             * @param config Configuração de acesso à câmera (host, credenciais, path)
+             * @brief DTO do snapshot, compartilhado com o cache (por isso imutável)
              */
-            explicit CameraService(CameraConfig config = CameraConfig{});
+            using SnapshotPtr = std::shared_ptr<const Dto::CameraSnapshotResponse>;
 
             /**
-             * @brief Captura o snapshot atual de um canal da câmera
-             * @param channel Número do canal (ex: 1)
-             * @return DTO com os bytes da imagem ou mensagem de erro
+             * @brief Callback de conclusão de getSnapshot()
+             */
+            using SnapshotHandler = std::function<void(SnapshotPtr)>;
+
+            /**
+             * @brief Construtor -- carrega o cadastro de câmeras e inicia o polling
+             * @param ioContext io_context do HttpServer, onde as buscas na câmera rodam
+             * @param config Configuração de acesso à câmera (prazos, cadência, câmera única)
+             * @param database Banco de onde o cadastro de câmeras é carregado
+             */
+            CameraService(
+                boost::asio::io_context& ioContext,
+                CameraConfig config = CameraConfig{},
+                const HorusDatabaseConfig& database = HorusDatabaseConfig{});
+
+            /**
+             * @brief Indica se existe uma câmera com esse id
+             *
+             * Sem cadastro, o id é o canal da câmera única e só os canais
+             * de 1 a CameraConfig::maxChannel são aceitos.
+             *
+             * @param cameraId horus.came_camera.id (ou canal, sem cadastro)
              */
-            Dto::CameraSnapshotResponse getSnapshot(int channel);
+            bool hasCamera(int cameraId) const;
+
+            /**
+             * @brief Obtém o snapshot atual de uma câmera
+             *
+             * Sai da memória quando possível (nesse caso @p handler é
+             * chamado antes de retornar); senão espera o próximo ciclo do
+             * poller ou, sem cadastro, a busca sob demanda -- sempre
+             * retornando na hora.
+             *
+             * @param cameraId horus.came_camera.id (ou canal, sem cadastro)
+             * @param handler Chamado uma única vez com o DTO (imagem ou
+             *        mensagem de erro), possivelmente em outra thread do pool.
+             *        Nunca chamado se hasCamera(cameraId) for false.
+             */
+            void getSnapshot(int cameraId, SnapshotHandler handler);
+
+            /**
+             * @brief Inscreve um espectador nos frames de uma câmera cadastrada
+             *
+             * Cada frame capturado pelo CameraPoller é distribuído a todos os
+             * inscritos, sem nova busca na câmera (ver FrameSubscription).
+             *
+             * @param cameraId horus.came_camera.id
+             * @return Inscrição, ou nullptr se a câmera não estiver cadastrada
+             *         (inclusive no modo sem cadastro, que não tem polling)
+             */
+            std::shared_ptr<FrameSubscription> subscribe(int cameraId);
 
         private:
-            CameraConfig m_config;  /**< Configuração de acesso à câmera */
+            /**
+             * @brief Estado de cache/coalescing de um canal
+             */
+            struct ChannelCache
+            {
+                std::mutex mutex;                                 /**< Protege os campos abaixo */
+                bool fetching = false;                            /**< Há uma busca em andamento para o canal */
+                std::vector<SnapshotHandler> waiters;             /**< Quem espera o resultado da busca em andamento */
+                SnapshotPtr frame;                                /**< Último snapshot capturado com sucesso */
+                std::chrono::steady_clock::time_point capturedAt; /**< Quando `frame` foi capturado */
+            };
+
+            CameraConfig m_config;      /**< Configuração de acesso à câmera */
+            CameraClient m_client;      /**< Câmera única (modo sem cadastro) */
+            CameraRegistry m_registry;  /**< Câmeras de horus.came_camera (vazio = modo sem cadastro) */
+            FrameStore m_frames;        /**< Último snapshot de cada câmera cadastrada */
+            CameraPoller m_poller;      /**< Atualiza m_frames em segundo plano */
+
+            std::mutex m_cacheMutex;                                          /**< Protege m_cache (só a inserção de canais) */
+            std::unordered_map<int, std::unique_ptr<ChannelCache>> m_cache;   /**< Cache por canal */
 
             /**
-             * @brief Monta o header "Authorization: Digest ..." a partir do
-             * desafio recebido em WWW-Authenticate
-             * @param method Método HTTP da requisição (ex: "GET")
-             * @param uri URI requisitada (ex: /cgi-bin/snapshot.cgi?channel=1)
-             * @param wwwAuthenticateHeader Conteúdo do header WWW-Authenticate retornado pela câmera
-             * @return Valor completo do header Authorization
+             * @brief Retorna (criando se preciso) o estado de cache de um canal
+             * @param channel Número do canal
+             * @return Referência estável -- entradas nunca são removidas
              */
-            std::string buildDigestAuthorizationHeader(
-                const std::string& method,
-                const std::string& uri,
-                const std::string& wwwAuthenticateHeader) const;
+            ChannelCache& cacheFor(int channel);
 
             /**
-             * @brief Extrai um parâmetro (realm, nonce, qop, opaque, ...) do
-             * header WWW-Authenticate
-             * @param header Conteúdo do header WWW-Authenticate
-             * @param key Nome do parâmetro a extrair
-             * @return Valor do parâmetro, ou string vazia se não encontrado
+             * @brief Busca o snapshot na câmera (sem cache) pelo CameraClient,
+             * publica no cache do canal e entrega a todos os waiters
+             * @param channel Número do canal (ex: 1)
+             * @param cache Estado do canal, já marcado como fetching
              */
-            static std::string extractAuthParam(const std::string& header, const std::string& key);
+            void fetchSnapshot(int channel, ChannelCache& cache);
     };
 }
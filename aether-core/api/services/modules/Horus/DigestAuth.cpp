@@ -0,0 +1,179 @@
+#include "DigestAuth.hpp"
+#include "../core/utils/Md5.hpp"
+
+#include <cstdio>
+#include <utility>
+
+namespace Aether::Api
+{
+    using Aether::Core::Utils::Md5;
+
+    namespace
+    {
+        /**
+         * Escolhe o qop a usar a partir da lista oferecida pela câmera
+         * (ex: qop="auth,auth-int"). Só "auth" é suportado; sem ele a
+         * câmera é tratada como RFC 2069 (qop vazio).
+         */
+        std::string chooseQop(const std::string& offered)
+        {
+            std::size_t start = 0;
+            while (start < offered.size())
+            {
+                auto end = offered.find(',', start);
+                if (end == std::string::npos)
+                    end = offered.size();
+
+                std::string token = offered.substr(start, end - start);
+                token.erase(0, token.find_first_not_of(' '));
+                token.erase(token.find_last_not_of(' ') + 1);
+
+                if (token == "auth")
+                    return token;
+
+                start = end + 1;
+            }
+
+            return "";
+        }
+    }
+
+    DigestAuth::DigestAuth(std::string user, std::string password)
+        : m_user(std::move(user))
+        , m_password(std::move(password))
+        , m_random(std::random_device{}())
+    {
+    }
+
+    void DigestAuth::setChallenge(const std::string& wwwAuthenticate)
+    {
+        const std::string realm = extractParam(wwwAuthenticate, "realm");
+
+        if (m_ha1.empty() || realm != m_realm)
+        {
+            m_realm = realm;
+            m_ha1 = Md5::toHex(Md5().update(m_user).update(":").update(m_realm)
+                                      .update(":").update(m_password).finalize());
+        }
+
+        std::string nonce = extractParam(wwwAuthenticate, "nonce");
+
+        // Requisições concorrentes podem receber o mesmo desafio; o nc só
+        // volta a zero quando o nonce muda, senão ele se repetiria
+        if (nonce != m_nonce)
+        {
+            m_nonce = std::move(nonce);
+            m_nc = 0;
+        }
+
+        m_qop    = chooseQop(extractParam(wwwAuthenticate, "qop"));
+        m_opaque = extractParam(wwwAuthenticate, "opaque");
+    }
+
+    void DigestAuth::reset()
+    {
+        m_nonce.clear();
+        m_nc = 0;
+    }
+
+    /**
+     * Monta o header Authorization: Digest ... (RFC 2617) reaproveitando o
+     * desafio atual. Com qop=auth, cada chamada usa um nc novo e um cnonce
+     * novo, então a câmera aceita o mesmo nonce em várias requisições.
+     */
+    std::string DigestAuth::authorization(const std::string& method, const std::string& uri)
+    {
+        char ha2[Md5::HEX_SIZE];
+        Md5::toHex(Md5().update(method).update(":").update(uri).finalize(), ha2);
+
+        // HA1:nonce: é comum às duas variantes (com e sem qop)
+        Md5 response;
+        response.update(m_ha1).update(":").update(m_nonce).update(":");
+
+        std::string header;
+        header.reserve(256);
+        header += "Digest username=\"" + m_user + "\"";
+        header += ", realm=\"" + m_realm + "\"";
+        header += ", nonce=\"" + m_nonce + "\"";
+        header += ", uri=\"" + uri + "\"";
+
+        char responseHex[Md5::HEX_SIZE];
+
+        if (!m_qop.empty())
+        {
+            char nc[9];
+            std::snprintf(nc, sizeof(nc), "%08x", ++m_nc);
+
+            char cnonce[17];
+            std::snprintf(cnonce, sizeof(cnonce), "%016llx",
+                          static_cast<unsigned long long>(m_random()));
+
+            response.update(nc).update(":").update(cnonce).update(":").update(m_qop).update(":")
+                    .update(std::string_view(ha2, sizeof(ha2)));
+            Md5::toHex(response.finalize(), responseHex);
+
+            header += ", response=\"";
+            header.append(responseHex, sizeof(responseHex));
+            header += "\", qop=" + m_qop;
+            header += ", nc=";
+            header += nc;
+            header += ", cnonce=\"";
+            header += cnonce;
+            header += "\"";
+        }
+        else
+        {
+            response.update(std::string_view(ha2, sizeof(ha2)));
+            Md5::toHex(response.finalize(), responseHex);
+
+            header += ", response=\"";
+            header.append(responseHex, sizeof(responseHex));
+            header += "\"";
+        }
+
+        if (!m_opaque.empty())
+            header += ", opaque=\"" + m_opaque + "\"";
+
+        return header;
+    }
+
+    bool DigestAuth::isStale(const std::string& wwwAuthenticate)
+    {
+        const std::string stale = extractParam(wwwAuthenticate, "stale");
+        return stale.size() == 4 &&
+               (stale[0] == 't' || stale[0] == 'T') &&
+               (stale[1] == 'r' || stale[1] == 'R') &&
+               (stale[2] == 'u' || stale[2] == 'U') &&
+               (stale[3] == 'e' || stale[3] == 'E');
+    }
+
+    /**
+     * Extrai um parâmetro do header WWW-Authenticate, que chega no formato:
+     * Digest realm="...", nonce="...", qop="auth", opaque="...", ...
+     * (qop/stale as vezes vêm sem aspas: qop=auth, stale=TRUE)
+     */
+    std::string DigestAuth::extractParam(const std::string& header, const std::string& key)
+    {
+        const std::string quotedMarker = key + "=\"";
+        auto pos = header.find(quotedMarker);
+
+        if (pos != std::string::npos)
+        {
+            pos += quotedMarker.size();
+            const auto end = header.find('"', pos);
+            if (end == std::string::npos)
+                return "";
+
+            return header.substr(pos, end - pos);
+        }
+
+        const std::string bareMarker = key + "=";
+        pos = header.find(bareMarker);
+        if (pos == std::string::npos)
+            return "";
+
+        pos += bareMarker.size();
+        const auto end = header.find_first_of(", ", pos);
+        return header.substr(pos, end - pos);
+    }
+}
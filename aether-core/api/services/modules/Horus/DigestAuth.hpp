@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Estado do HTTP Digest Authentication (RFC 2617) de uma câmera
+     *
+     * Guarda o último desafio (WWW-Authenticate) recebido e o reaproveita
+     * entre requisições, em vez de pedir um 401 novo a cada snapshot:
+     * - HA1 = MD5(user:realm:password) é calculado uma vez por realm
+     * - nc (nonce count) é incrementado a cada requisição com o mesmo nonce,
+     *   como a RFC exige para reuso do nonce com qop=auth
+     * - Só é preciso um desafio novo quando a câmera responder 401 com
+     *   stale=true (nonce expirou) -- ver isStale()
+     *
+     * Não é thread-safe: cada CameraClient tem a sua instância e a usa
+     * sempre sob o seu próprio lock.
+     *
+     * @see CameraClient
+     */
+    class DigestAuth
+    {
+        public:
+            /**
+             * @brief Construtor
+             * @param user Usuário do Digest Auth
+             * @param password Senha do Digest Auth
+             */
+            DigestAuth(std::string user, std::string password);
+
+            /** @brief true se já existe um desafio para montar o header Authorization */
+            bool hasChallenge() const { return !m_nonce.empty(); }
+
+            /**
+             * @brief Adota um novo desafio recebido num 401
+             *
+             * Zera o nc se o nonce mudou; HA1 só é recalculado se o realm mudou.
+             *
+             * @param wwwAuthenticate Conteúdo do header WWW-Authenticate
+             */
+            void setChallenge(const std::string& wwwAuthenticate);
+
+            /** @brief Descarta o desafio atual (a próxima requisição sai sem Authorization) */
+            void reset();
+
+            /**
+             * @brief Monta o header "Authorization: Digest ..." para a próxima
+             * requisição, consumindo um nc
+             * @param method Método HTTP da requisição (ex: "GET")
+             * @param uri URI requisitada (ex: /cgi-bin/snapshot.cgi?channel=1)
+             * @return Valor completo do header Authorization
+             */
+            std::string authorization(const std::string& method, const std::string& uri);
+
+            /**
+             * @brief Indica se um desafio 401 é só o aviso de nonce expirado
+             * (stale=true), ou seja, as credenciais estavam corretas
+             * @param wwwAuthenticate Conteúdo do header WWW-Authenticate
+             */
+            static bool isStale(const std::string& wwwAuthenticate);
+
+            /**
+             * @brief Extrai um parâmetro (realm, nonce, qop, opaque, ...) do
+             * header WWW-Authenticate
+             * @param header Conteúdo do header WWW-Authenticate
+             * @param key Nome do parâmetro a extrair
+             * @return Valor do parâmetro, ou string vazia se não encontrado
+             */
+            static std::string extractParam(const std::string& header, const std::string& key);
+
+        private:
+            std::string m_user;         /**< Usuário do Digest Auth */
+            std::string m_password;     /**< Senha do Digest Auth */
+
+            std::string m_realm;        /**< realm do desafio atual */
+            std::string m_nonce;        /**< nonce do desafio atual (vazio = sem desafio) */
+            std::string m_qop;          /**< qop escolhido ("auth" ou vazio, RFC 2069) */
+            std::string m_opaque;       /**< opaque do desafio atual, devolvido como veio */
+            std::string m_ha1;          /**< MD5(user:realm:password), cacheado por realm */
+            std::uint32_t m_nc = 0;     /**< Nonce count da última requisição com este nonce */
+
+            std::mt19937_64 m_random;   /**< Gerador dos cnonce, semeado uma única vez */
+    };
+}
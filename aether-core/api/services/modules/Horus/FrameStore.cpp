@@ -0,0 +1,163 @@
+#include "FrameStore.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Aether::Api
+{
+    void FrameSubscription::next(FrameHandler handler)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_cancelled)
+            return;
+
+        if (m_pending)
+        {
+            auto frame = std::move(m_pending);
+            lock.unlock();
+            handler(std::move(frame));
+            return;
+        }
+
+        m_handler = std::move(handler);
+    }
+
+    void FrameSubscription::cancel()
+    {
+        FrameHandler handler;
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_cancelled = true;
+        m_pending.reset();
+        handler.swap(m_handler);
+    }
+
+    std::uint64_t FrameSubscription::dropped() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_dropped;
+    }
+
+    void FrameSubscription::offer(const FramePtr& frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_cancelled)
+            return;
+
+        if (m_handler)
+        {
+            auto handler = std::move(m_handler);
+            m_handler = nullptr;
+            lock.unlock();
+            handler(frame);
+            return;
+        }
+
+        if (m_pending)
+            ++m_dropped;
+
+        m_pending = frame;
+    }
+
+    bool FrameSubscription::cancelled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cancelled;
+    }
+
+    FrameStore::FrameStore(std::chrono::milliseconds maxAge)
+        : m_maxAge(maxAge)
+    {
+    }
+
+    void FrameStore::addCamera(int cameraId)
+    {
+        auto& slot = m_slots[cameraId];
+        if (!slot)
+            slot = std::make_unique<Slot>();
+    }
+
+    bool FrameStore::get(int cameraId, FrameHandler handler)
+    {
+        const auto it = m_slots.find(cameraId);
+        if (it == m_slots.end())
+            return false;
+
+        auto& slot = *it->second;
+        std::unique_lock<std::mutex> lock(slot.mutex);
+
+        if (slot.frame && std::chrono::steady_clock::now() - slot.capturedAt <= m_maxAge)
+        {
+            auto frame = slot.frame;
+            lock.unlock();
+            handler(std::move(frame));
+            return true;
+        }
+
+        slot.waiters.push_back(std::move(handler));
+        return true;
+    }
+
+    /**
+     * Os waiters e os inscritos são chamados fora do lock da câmera.
+     * Inscrições canceladas ou soltas são removidas aqui.
+     */
+    void FrameStore::publish(int cameraId, FramePtr result)
+    {
+        const auto it = m_slots.find(cameraId);
+        if (it == m_slots.end())
+            return;
+
+        auto& slot = *it->second;
+        std::vector<FrameHandler> waiters;
+        std::vector<std::shared_ptr<FrameSubscription>> subscribers;
+
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            waiters.swap(slot.waiters);
+
+            if (result->success)
+            {
+                slot.frame = result;
+                slot.capturedAt = std::chrono::steady_clock::now();
+
+                subscribers.reserve(slot.subscribers.size());
+                std::erase_if(slot.subscribers, [&](const std::weak_ptr<FrameSubscription>& weak)
+                {
+                    auto subscriber = weak.lock();
+                    if (!subscriber || subscriber->cancelled())
+                        return true;
+
+                    subscribers.push_back(std::move(subscriber));
+                    return false;
+                });
+            }
+        }
+
+        for (auto& waiter : waiters)
+            waiter(result);
+
+        for (auto& subscriber : subscribers)
+            subscriber->offer(result);
+    }
+
+    std::shared_ptr<FrameSubscription> FrameStore::subscribe(int cameraId)
+    {
+        const auto it = m_slots.find(cameraId);
+        if (it == m_slots.end())
+            return nullptr;
+
+        auto subscription = std::make_shared<FrameSubscription>();
+        auto& slot = *it->second;
+
+        std::lock_guard<std::mutex> lock(slot.mutex);
+
+        if (slot.frame && std::chrono::steady_clock::now() - slot.capturedAt <= m_maxAge)
+            subscription->m_pending = slot.frame;
+
+        slot.subscribers.push_back(subscription);
+        return subscription;
+    }
+}
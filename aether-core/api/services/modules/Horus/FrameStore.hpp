@@ -0,0 +1,158 @@
+#pragma once
+
+#include "../../../dto/modules/Horus/CameraSnapshotResponse.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Aether::Api
+{
+    /**
+     * @brief Inscrição de um espectador nos frames de uma câmera (streaming)
+     *
+     * Backpressure "drop-to-latest": guarda no máximo um frame pendente.
+     * Se um frame novo chega antes do espectador pedir o anterior (ex: rede
+     * lenta), o pendente é substituído pelo mais recente -- o espectador
+     * perde quadros mas nunca fica atrasado nem acumula memória.
+     *
+     * Thread-safe. Criada por FrameStore::subscribe().
+     */
+    class FrameSubscription
+    {
+        public:
+            /** @brief Frame compartilhado entre todos os espectadores */
+            using FramePtr = std::shared_ptr<const Dto::CameraSnapshotResponse>;
+
+            /** @brief Recebe o próximo frame */
+            using FrameHandler = std::function<void(FramePtr)>;
+
+            /**
+             * @brief Pede o próximo frame
+             *
+             * Com frame pendente, @p handler é chamado antes de retornar;
+             * senão, quando o próximo frame for publicado. Só pode haver
+             * um pedido em aberto por vez.
+             */
+            void next(FrameHandler handler);
+
+            /**
+             * @brief Encerra a inscrição: descarta o pedido em aberto (sem
+             * chamá-lo) e para de receber frames
+             */
+            void cancel();
+
+            /** @brief Quantos frames foram descartados por o espectador estar atrasado */
+            std::uint64_t dropped() const;
+
+        private:
+            friend class FrameStore;
+
+            /** @brief Entrega um frame novo (chamado pelo FrameStore) */
+            void offer(const FramePtr& frame);
+
+            /** @brief true depois de cancel() */
+            bool cancelled() const;
+
+            mutable std::mutex m_mutex;    /**< Protege os campos abaixo */
+            FramePtr m_pending;            /**< Frame mais recente ainda não pedido */
+            FrameHandler m_handler;        /**< Pedido em aberto (next() sem frame pendente) */
+            bool m_cancelled = false;      /**< cancel() já foi chamado */
+            std::uint64_t m_dropped = 0;   /**< Frames substituídos antes de serem pedidos */
+    };
+
+    /**
+     * @brief Último snapshot de cada câmera cadastrada, em memória
+     *
+     * Alimentado pelo CameraPoller (publish) e lido pelas rotas REST (get),
+     * que assim respondem sem nenhuma latência de câmera. Um snapshot com
+     * mais de maxAge é considerado perdido (câmera caiu): quem pedir espera
+     * o resultado do próximo ciclo do poller em vez de receber imagem velha.
+     *
+     * Também distribui cada frame novo a todos os espectadores inscritos
+     * (subscribe) -- uma busca na câmera alimenta N streams.
+     *
+     * As câmeras são adicionadas só na montagem (addCamera), antes de
+     * qualquer get/publish; depois disso o mapa é só leitura e cada câmera
+     * tem o seu próprio lock. Thread-safe.
+     *
+     * @see CameraPoller
+     */
+    class FrameStore
+    {
+        public:
+            /** @brief Snapshot (ou erro) compartilhado, por isso imutável */
+            using FramePtr = std::shared_ptr<const Dto::CameraSnapshotResponse>;
+
+            /** @brief Callback de entrega de get() */
+            using FrameHandler = std::function<void(FramePtr)>;
+
+            /**
+             * @brief Construtor
+             * @param maxAge Idade máxima de um snapshot pra ainda ser servido
+             */
+            explicit FrameStore(std::chrono::milliseconds maxAge);
+
+            /**
+             * @brief Registra uma câmera (só na montagem, antes do uso)
+             * @param cameraId horus.came_camera.id
+             */
+            void addCamera(int cameraId);
+
+            /**
+             * @brief Entrega o último snapshot de uma câmera
+             *
+             * Com snapshot dentro de maxAge, @p handler é chamado antes de
+             * retornar; senão é chamado no próximo publish() da câmera.
+             *
+             * @param cameraId horus.came_camera.id
+             * @param handler Recebe o snapshot ou o erro do último ciclo
+             * @return false se a câmera não estiver registrada (handler não é chamado)
+             */
+            bool get(int cameraId, FrameHandler handler);
+
+            /**
+             * @brief Publica o resultado de uma busca na câmera
+             *
+             * Sucesso substitui o snapshot atual e é oferecido a todos os
+             * inscritos; erro não -- só é entregue a quem estava esperando
+             * em get().
+             *
+             * @param cameraId horus.came_camera.id
+             * @param result Resultado da busca
+             */
+            void publish(int cameraId, FramePtr result);
+
+            /**
+             * @brief Inscreve um espectador nos frames de uma câmera
+             *
+             * Se já existe um snapshot dentro de maxAge, ele fica pendente
+             * na inscrição, pra o espectador não começar com tela preta.
+             *
+             * @param cameraId horus.came_camera.id
+             * @return Inscrição, ou nullptr se a câmera não estiver registrada.
+             *         Basta soltar o shared_ptr (ou chamar cancel()) pra sair.
+             */
+            std::shared_ptr<FrameSubscription> subscribe(int cameraId);
+
+        private:
+            /**
+             * @brief Estado de uma câmera
+             */
+            struct Slot
+            {
+                std::mutex mutex;                                 /**< Protege os campos abaixo */
+                FramePtr frame;                                   /**< Último snapshot capturado com sucesso */
+                std::chrono::steady_clock::time_point capturedAt; /**< Quando `frame` foi capturado */
+                std::vector<FrameHandler> waiters;                /**< Esperando o próximo publish() */
+                std::vector<std::weak_ptr<FrameSubscription>> subscribers; /**< Espectadores (limpos a cada publish) */
+            };
+
+            std::chrono::milliseconds m_maxAge;                     /**< Idade máxima servida */
+            std::unordered_map<int, std::unique_ptr<Slot>> m_slots; /**< Fixo depois da montagem */
+    };
+}
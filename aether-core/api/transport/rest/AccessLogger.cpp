@@ -1,4 +1,5 @@
 #include "AccessLogger.hpp"
+#include "../core/utils/logger.hpp"
 
 #include <algorithm>
 #include <atomic>
@@ -7,7 +8,6 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
-#include <iostream>
 #include <mutex>
 #include <sstream>
 
@@ -102,15 +102,18 @@ namespace Aether::Api
         std::filesystem::create_directories(sDetailsDir, dirError);
         if (dirError)
         {
-            std::cerr << "[AccessLogger] Falha ao criar diretorio de detalhes: "
-                      << sDetailsDir << " (" << dirError.message() << ")" << std::endl;
+            AETHER_LOG_ERROR("AccessLogger", "Falha ao criar diretorio de detalhes",
+                             AetherCoreLogger::field("dir", sDetailsDir), AetherCoreLogger::field("error", dirError.message()));
         }
 
+        // Um novo HttpServer no mesmo processo (ex: aether-apiload) reabre o log
+        if (sLogFile.is_open())
+            sLogFile.close();
+
         sLogFile.open(accessLogPath, std::ios::out | std::ios::app);
         if (!sLogFile.is_open())
         {
-            std::cerr << "[AccessLogger] Falha ao abrir arquivo de log de acesso: "
-                      << accessLogPath << std::endl;
+            AETHER_LOG_ERROR("AccessLogger", "Falha ao abrir arquivo de log de acesso", AetherCoreLogger::field("file", accessLogPath));
         }
     }
 
@@ -176,8 +179,7 @@ namespace Aether::Api
 
         if (!detailFile.is_open())
         {
-            std::cerr << "[AccessLogger] Falha ao criar arquivo de detalhe: "
-                      << fullPath << std::endl;
+            AETHER_LOG_ERROR("AccessLogger", "Falha ao criar arquivo de detalhe", AetherCoreLogger::field("file", fullPath.string()));
             return;
         }
 
@@ -1,8 +1,8 @@
 #include "HttpServer.hpp"
 #include "HttpSessions.hpp"
 #include "AccessLogger.hpp"
+#include "../core/utils/logger.hpp"
 
-#include <iostream>
 #include <memory>
 #include <boost/asio/ip/address.hpp>
 
@@ -26,7 +26,8 @@ namespace Aether::Api
               m_ioContext,
               boost::asio::ip::tcp::endpoint(
                   boost::asio::ip::make_address(config.host),
-                  config.port))
+                  config.port)),
+          m_router(m_ioContext, m_config)
     {
         AccessLogger::Initialize(
             config.accessLogPath,
@@ -68,10 +69,10 @@ namespace Aether::Api
      */
     void HttpServer::start()
     {
-        std::cout << "HTTP Server iniciado em "
-                  << m_config.host << ":"
-                  << m_config.port
-                  << " (" << m_config.threads << " threads)" << std::endl;
+        AETHER_LOG_INFO("HttpServer", "HTTP Server iniciado",
+                        AetherCoreLogger::field("host", m_config.host),
+                        AetherCoreLogger::field("port", m_config.port),
+                        AetherCoreLogger::field("threads", m_config.threads));
 
         doAccept();
 
@@ -87,12 +88,18 @@ namespace Aether::Api
         m_ioContext.run();
     }
 
+    void HttpServer::stop()
+    {
+        m_ioContext.stop();
+    }
+
     /**
      * Agenda a aceitação assíncrona da próxima conexão TCP
      *
      * Passos:
      * 1. async_accept não bloqueia: registra o callback e retorna na hora
-     * 2. Quando uma conexão chega (em qualquer thread do pool), cria a
+     * 2. Quando uma conexão chega (em qualquer thread do pool), num
+     *    strand novo só dela, cria a
      *    HttpSession via shared_ptr e chama run() — a sessão então cuida
      *    de si mesma via I/O assíncrono (ver HttpSession)
      * 3. Reagenda a próxima aceitação, com sucesso ou erro — senão o
@@ -101,6 +108,7 @@ namespace Aether::Api
     void HttpServer::doAccept()
     {
         m_acceptor.async_accept(
+            boost::asio::make_strand(m_ioContext),
             [this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket)
             {
                 if (!ec)
@@ -109,10 +117,7 @@ namespace Aether::Api
                 }
                 else
                 {
-                    std::cerr
-                        << "Erro ao aceitar conexão: "
-                        << ec.message()
-                        << std::endl;
+                    AETHER_LOG_ERROR("HttpServer", "Erro ao aceitar conexão", AetherCoreLogger::field("error", ec.message()));
                 }
 
                 doAccept();
@@ -64,17 +64,29 @@ namespace Aether::Api
          * Sobe (config.threads - 1) threads extras rodando
          * io_context::run(), e a própria thread chamadora entra no
          * io_context também — todas processam conexões em paralelo.
-         * Só retorna quando o io_context para (ex: no destrutor).
+         * Só retorna quando o io_context para (stop() ou destrutor).
          *
          * @throws std::runtime_error Se erro ao iniciar
          */
         void start();
 
+        /**
+         * @brief Para o io_context, fazendo start() retornar
+         *
+         * Pode ser chamado de outra thread. Útil quando o servidor roda
+         * numa thread própria (ex: aether-apiload) e precisa ser parado
+         * antes de ser destruído.
+         */
+        void stop();
+
     private:
         /**
          * @brief Agenda a próxima aceitação assíncrona de conexão
          *
          * - async_accept não bloqueia: agenda o callback e retorna
+         * - Cada conexão aceita ganha o seu próprio strand, então os
+         *   callbacks de uma sessão nunca rodam em paralelo entre si, mesmo
+         *   quando a resposta é completada por outro strand (ex: câmera)
          * - Ao aceitar, cria a HttpSession (via shared_ptr) e chama run()
          * - Sempre reagenda a próxima aceitação, mesmo em caso de erro —
          *   senão o servidor para de aceitar novas conexões após a
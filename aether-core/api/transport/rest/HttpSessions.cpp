@@ -1,11 +1,33 @@
 #include "HttpSessions.hpp"
 #include "AccessLogger.hpp"
+#include "../core/utils/logger.hpp"
+#include "../core/utils/Metrics.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <iostream>
 
 namespace Aether::Api
 {
+    namespace
+    {
+        using Core::Utils::Metrics;
+
+        /** aether_http_requests_total por classe de status (1xx..5xx) */
+        Core::Utils::Counter& requestsByClass(int status)
+        {
+            static Core::Utils::Counter* counters[] = {
+                &Metrics::counter("aether_http_requests_total", "Requisicoes HTTP respondidas", "code=\"1xx\""),
+                &Metrics::counter("aether_http_requests_total", "Requisicoes HTTP respondidas", "code=\"2xx\""),
+                &Metrics::counter("aether_http_requests_total", "Requisicoes HTTP respondidas", "code=\"3xx\""),
+                &Metrics::counter("aether_http_requests_total", "Requisicoes HTTP respondidas", "code=\"4xx\""),
+                &Metrics::counter("aether_http_requests_total", "Requisicoes HTTP respondidas", "code=\"5xx\""),
+            };
+
+            const int index = std::clamp(status / 100, 1, 5) - 1;
+            return *counters[index];
+        }
+    }
+
     /**
      * Inicializa a sessão com socket e roteador
      */
@@ -52,11 +74,10 @@ namespace Aether::Api
     /**
      * Callback de leitura concluída:
      * 1. Converte para HttpRequest interna
-     * 2. Despacha via Router (síncrono, roda nesta mesma thread do pool)
-     * 3. Loga a requisição no AccessLogger (método, rota, status, corpos,
-     *    duração do dispatch) -- ver AccessLogger para o formato
-     * 4. Converte resposta para Boost.Beast
-     * 5. Escreve a resposta de forma assíncrona
+     * 2. Despacha via Router -- a resposta chega por callback, na hora
+     *    (rotas síncronas) ou mais tarde (ex: câmera), sem prender esta
+     *    thread do pool esperando
+     * 3. Volta pro strand da sessão e segue em onResponse()
      *
      * end_of_stream (cliente fechou a conexão) e demais erros só encerram
      * esta sessão — não derrubam o servidor nem afetam outras conexões.
@@ -71,16 +92,48 @@ namespace Aether::Api
 
         if (ec)
         {
-            std::cerr << "Erro ao ler requisicao: " << ec.message() << std::endl;
+            AETHER_LOG_DEBUG("HttpSession", "Erro ao ler requisicao", AetherCoreLogger::field("error", ec.message()));
             return;
         }
 
-        auto request = createRequest(m_request);
-
+        auto request = std::make_shared<HttpRequest>(createRequest(m_request));
         const auto dispatchStart = std::chrono::steady_clock::now();
-        auto response = m_router.dispatch(request);
-        const auto dispatchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - dispatchStart);
+
+        auto self = shared_from_this();
+
+        m_router.dispatch(*request, [self, request, dispatchStart](HttpResponse response)
+        {
+            // O handler pode rodar em outro strand (ex: o da câmera): a
+            // escrita no socket sempre volta pro strand desta sessão
+            boost::asio::dispatch(
+                self->m_socket.get_executor(),
+                [self, request, dispatchStart, response = std::move(response)]() mutable
+                {
+                    self->onResponse(*request, std::move(response), dispatchStart);
+                });
+        });
+    }
+
+    /**
+     * Resposta pronta (no strand da sessão):
+     * 1. Loga a requisição no AccessLogger (método, rota, status, corpos,
+     *    duração do dispatch até a resposta) -- ver AccessLogger para o formato
+     * 2. Converte resposta para Boost.Beast
+     * 3. Escreve a resposta de forma assíncrona
+     */
+    void HttpSession::onResponse(
+        const HttpRequest& request,
+        HttpResponse response,
+        std::chrono::steady_clock::time_point dispatchStart)
+    {
+        static auto& latency = Metrics::histogram(
+            "aether_http_request_seconds", "Tempo do dispatch ate a resposta ficar pronta (sem a escrita no socket)");
+
+        const auto elapsed = std::chrono::steady_clock::now() - dispatchStart;
+        const auto dispatchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+        latency.observe(elapsed);
+        requestsByClass(response.status).inc();
 
         boost::system::error_code endpointEc;
         const auto endpoint = m_socket.remote_endpoint(endpointEc);
@@ -88,6 +141,12 @@ namespace Aether::Api
 
         AccessLogger::Log(clientIp, request, response, dispatchDuration);
 
+        if (response.stream)
+        {
+            startStream(response);
+            return;
+        }
+
         auto beastResponse =
             std::make_shared<http::response<http::string_body>>(createResponse(response));
 
@@ -107,6 +166,153 @@ namespace Aether::Api
             });
     }
 
+    /**
+     * Início de uma resposta em streaming:
+     * 1. Escreve status + headers com Transfer-Encoding: chunked
+     * 2. Começa a vigiar o socket (watchStreamClose) e a puxar pedaços
+     *
+     * A resposta não é keep-alive: quando o stream acaba, a conexão fecha.
+     */
+    void HttpSession::startStream(HttpResponse& response)
+    {
+        m_stream = std::move(response.stream);
+
+        auto header = std::make_shared<http::response<http::empty_body>>();
+        header->version(11);
+        header->result(static_cast<http::status>(response.status));
+
+        for (auto& field : response.headers)
+            header->set(field.first, field.second);
+
+        header->chunked(true);
+        header->keep_alive(false);
+
+        auto serializer = std::make_shared<http::response_serializer<http::empty_body>>(*header);
+        auto self = shared_from_this();
+
+        http::async_write_header(
+            m_socket,
+            *serializer,
+            [self, header, serializer](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                {
+                    self->stopStream();
+                    return;
+                }
+
+                self->watchStreamClose();
+                self->nextStreamChunk();
+            });
+    }
+
+    /**
+     * O handler da fonte pode rodar em qualquer thread (ex: a do poller
+     * da câmera): a escrita sempre volta pro strand da sessão.
+     */
+    void HttpSession::nextStreamChunk()
+    {
+        if (!m_stream)
+            return;
+
+        auto self = shared_from_this();
+
+        m_stream->next([self](std::optional<HttpStreamChunk> chunk)
+        {
+            boost::asio::dispatch(
+                self->m_socket.get_executor(),
+                [self, chunk = std::move(chunk)]() mutable
+                {
+                    self->onStreamChunk(std::move(chunk));
+                });
+        });
+    }
+
+    /**
+     * Escreve um pedaço como um chunk HTTP, direto dos buffers da fonte
+     * (sem cópia). std::nullopt = fonte terminou: escreve o chunk final e
+     * encerra a conexão.
+     */
+    void HttpSession::onStreamChunk(std::optional<HttpStreamChunk> chunk)
+    {
+        if (!m_stream)
+            return;
+
+        auto self = shared_from_this();
+
+        if (!chunk)
+        {
+            boost::asio::async_write(
+                m_socket,
+                http::make_chunk_last(),
+                [self](beast::error_code, std::size_t)
+                {
+                    self->stopStream();
+                });
+            return;
+        }
+
+        auto owner = std::make_shared<HttpStreamChunk>(std::move(*chunk));
+
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(owner->parts.size());
+        for (const auto part : owner->parts)
+            buffers.emplace_back(part.data(), part.size());
+
+        boost::asio::async_write(
+            m_socket,
+            http::make_chunk(buffers),
+            [self, owner](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                {
+                    self->stopStream();
+                    return;
+                }
+
+                self->nextStreamChunk();
+            });
+    }
+
+    /**
+     * O cliente não envia nada durante o stream; qualquer erro/EOF na
+     * leitura significa que ele saiu.
+     */
+    void HttpSession::watchStreamClose()
+    {
+        auto self = shared_from_this();
+
+        m_socket.async_read_some(
+            boost::asio::buffer(m_streamProbe),
+            [self](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                {
+                    self->stopStream();
+                    return;
+                }
+
+                self->watchStreamClose();
+            });
+    }
+
+    /**
+     * Libera a fonte (o espectador deixa de receber frames) e fecha o
+     * socket, cancelando a leitura/escrita pendente. Idempotente.
+     */
+    void HttpSession::stopStream()
+    {
+        if (!m_stream)
+            return;
+
+        m_stream->close();
+        m_stream.reset();
+
+        beast::error_code ec;
+        m_socket.shutdown(tcp::socket::shutdown_both, ec);
+        m_socket.close(ec);
+    }
+
     /**
      * Callback de escrita concluída. Se a conexão for keep-alive, volta a
      * ler a próxima requisição na mesma sessão; senão, encerra.
@@ -115,7 +321,7 @@ namespace Aether::Api
     {
         if (ec)
         {
-            std::cerr << "Erro ao escrever resposta: " << ec.message() << std::endl;
+            AETHER_LOG_DEBUG("HttpSession", "Erro ao escrever resposta", AetherCoreLogger::field("error", ec.message()));
             return;
         }
 
@@ -7,7 +7,10 @@
 
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <array>
+#include <chrono>
 #include <memory>
+#include <optional>
 
 namespace Aether::Api
 {
@@ -30,12 +33,16 @@ namespace Aether::Api
      * socket. Por isso HttpServer sempre a cria com std::make_shared,
      * nunca como valor/stack.
      *
-     * O processamento em si (Router::dispatch) continua síncrono — roda
-     * dentro do callback de leitura, na thread do io_context que o
-     * recebeu. Isso é suficiente pra não travar as demais conexões (cada
-     * uma tem sua própria sessão/callback), mas uma chamada de negócio
-     * muito lenta (ex: câmera respondendo devagar) ainda ocupa aquela
-     * thread do pool até terminar.
+     * O processamento (Router::dispatch) entrega a resposta por callback:
+     * rotas simples respondem na hora; rotas que dependem de I/O externo
+     * (ex: snapshot de câmera) respondem depois, sem ocupar nenhuma thread
+     * do pool enquanto esperam. O socket da sessão vive num strand próprio
+     * (ver HttpServer::doAccept()) e a resposta sempre é escrita nele.
+     *
+     * Respostas com HttpResponse::stream (ex: MJPEG de câmera) são enviadas
+     * com Transfer-Encoding: chunked: um pedaço por vez, pedindo o próximo
+     * à fonte só quando o anterior terminou de ser escrito. A conexão é
+     * encerrada quando o stream acaba ou o cliente desconecta.
      *
      * @see HttpServer - quem cria as sessões (async_accept)
      * @see Router - quem processa as requisições
@@ -68,6 +75,39 @@ namespace Aether::Api
         /** @brief Callback ao terminar de ler a requisição. */
         void onRead(beast::error_code ec, std::size_t bytesTransferred);
 
+        /**
+         * @brief Loga e escreve a resposta de uma requisição (no strand da sessão)
+         * @param request Requisição que originou a resposta
+         * @param response Resposta entregue pelo Router
+         * @param dispatchStart Quando a requisição foi despachada (para o access log)
+         */
+        void onResponse(
+            const HttpRequest& request,
+            HttpResponse response,
+            std::chrono::steady_clock::time_point dispatchStart);
+
+        /**
+         * @brief Envia status + headers de uma resposta em streaming e
+         * começa a puxar os pedaços da fonte
+         * @param response Resposta com HttpResponse::stream preenchido
+         */
+        void startStream(HttpResponse& response);
+
+        /** @brief Pede o próximo pedaço do stream à fonte. */
+        void nextStreamChunk();
+
+        /** @brief Escreve um pedaço do stream (ou o chunk final, com std::nullopt). */
+        void onStreamChunk(std::optional<HttpStreamChunk> chunk);
+
+        /**
+         * @brief Fica lendo o socket durante o stream só pra perceber
+         * quando o cliente desconecta (mesmo sem frame novo pra escrever)
+         */
+        void watchStreamClose();
+
+        /** @brief Encerra o stream: libera a fonte e fecha o socket. */
+        void stopStream();
+
         /** @brief Callback ao terminar de escrever a resposta. */
         void onWrite(beast::error_code ec, std::size_t bytesTransferred, bool close);
 
@@ -95,5 +135,7 @@ namespace Aether::Api
         Router& m_router;                                 /**< Referência do router para processar requisições */
         beast::flat_buffer m_buffer;                       /**< Buffer de leitura, reaproveitado entre requisições da mesma conexão */
         http::request<http::string_body> m_request;        /**< Requisição sendo lida no momento */
+        std::shared_ptr<HttpStreamSource> m_stream;        /**< Fonte do stream em andamento (nulo fora de stream) */
+        std::array<char, 64> m_streamProbe{};              /**< Destino das leituras de watchStreamClose() */
     };
 }
\ No newline at end of file
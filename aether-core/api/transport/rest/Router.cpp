@@ -2,6 +2,11 @@
 
 namespace Aether::Api
 {
+    Router::Router(boost::asio::io_context& ioContext, const ApiConfig& config)
+        : m_cameraController(ioContext, config)
+    {
+    }
+
     /**
      * Roteador principal que inspeciona o método HTTP
      * e delega para o handler apropriado.
@@ -10,22 +15,27 @@ namespace Aether::Api
      * 1. Recebe HttpRequest
      * 2. Verifica request.method
      * 3. Chama dispatchGet, dispatchPost, etc
-     * 4. Retorna HttpResponse
+     * 4. Entrega a HttpResponse pelo handler
      */
-    HttpResponse Router::dispatch(const HttpRequest& request)
+    void Router::dispatch(const HttpRequest& request, HttpResponseHandler handler)
     {
         switch (request.method)
         {
             case HttpMethod::GET:
-                return dispatchGet(request);
+                dispatchGet(request, std::move(handler));
+                return;
             case HttpMethod::POST:
-                return dispatchPost(request);
+                handler(dispatchPost(request));
+                return;
             case HttpMethod::PUT:
-                return dispatchPut(request);
+                handler(dispatchPut(request));
+                return;
             case HttpMethod::DELETE_:
-                return dispatchDelete(request);
+                handler(dispatchDelete(request));
+                return;
             default:
-                return notFound();
+                handler(notFound());
+                return;
         }
     }
 
@@ -3,7 +3,11 @@
 #include "../../common/HttpResponse.hpp"
 #include "../../common/HttpRequest.hpp"
 #include "../../controllers/core/StatusController.hpp"
+#include "../../controllers/core/MetricsController.hpp"
 #include "../../controllers/modules/Horus/CameraController.hpp"
+#include "../../config/ApiConfig.hpp"
+
+#include <boost/asio/io_context.hpp>
 
 #include <string>
 
@@ -23,33 +27,46 @@ namespace Aether::Api
      * @see HttpSession - quem chama dispatch()
      * @see StatusController - exemplo de controller
      *
+     * A resposta é entregue por callback (HttpResponseHandler): rotas
+     * síncronas chamam o callback antes de dispatch() retornar; rotas
+     * assíncronas (ex: snapshot de câmera) chamam depois, de outro
+     * callback do io_context, sem ocupar a thread enquanto esperam.
+     *
      * @example
      * @code
-     *   Router router;
+     *   Router router(ioContext, config);
      *   HttpRequest request{HttpMethod::GET, "/api/status", ...};
-     *   HttpResponse response = router.dispatch(request);
+     *   router.dispatch(request, [](HttpResponse response) { ... });
      * @endcode
      */
     class Router
     {
         public:
+            /**
+             * @brief Construtor
+             * @param ioContext io_context do HttpServer, usado pelos
+             *        controllers com rotas assíncronas
+             * @param config Configuração da API, repassada aos controllers
+             */
+            Router(boost::asio::io_context& ioContext, const ApiConfig& config);
+
             /**
              * @brief Roteador principal de requisições
              *
              * Analisa o método HTTP e delega para o despachante apropriado.
              *
              * @param request Requisição HTTP a processar
-             * @return Resposta HTTP apropriada
+             * @param handler Recebe a resposta HTTP apropriada (uma única vez)
              */
-            HttpResponse dispatch(const HttpRequest& request);
+            void dispatch(const HttpRequest& request, HttpResponseHandler handler);
 
         private:
             /**
              * @brief Processa requisições GET
              * @param request Requisição GET recebida
-             * @return Resposta HTTP
+             * @param handler Recebe a resposta HTTP (rotas de câmera completam depois)
              */
-            HttpResponse dispatchGet(const HttpRequest& request);
+            void dispatchGet(const HttpRequest& request, HttpResponseHandler handler);
 
             /**
              * @brief Processa requisições POST
@@ -80,6 +97,7 @@ namespace Aether::Api
 
         private:
             StatusController m_statusController;  /**< Controller de status */
+            MetricsController m_metricsController; /**< Controller de métricas (Prometheus) */
             CameraController m_cameraController;  /**< Controller de câmeras */
     };
 }
\ No newline at end of file
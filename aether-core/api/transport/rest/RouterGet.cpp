@@ -9,24 +9,37 @@ namespace Aether::Api
      *
      * Routes:
      * - GET /api/core/status -> StatusController::get()
-     * - GET /api/horus/cameras/:channel/snapshot -> CameraController::getSnapshot()
+     * - GET /api/core/metrics -> MetricsController::get() (formato Prometheus)
+     * - GET /api/horus/cameras/:id/snapshot -> CameraController::getSnapshot() (assíncrona)
+     * - GET /api/horus/cameras/:id/stream -> CameraController::getStream() (streaming MJPEG)
      *
      * Para sistemas com muitas rotas, considere usar RouteRegistry
      * que permite registro de rotas de forma centralizada e legível.
      */
-    HttpResponse Router::dispatchGet(const HttpRequest& request)
+    void Router::dispatchGet(const HttpRequest& request, HttpResponseHandler handler)
     {
         if (request.path == "/api/core/status")
         {
-            return m_statusController.get(request);
+            handler(m_statusController.get(request));
+            return;
+        }
+
+        if (request.path == "/api/core/metrics")
+        {
+            handler(m_metricsController.get(request));
+            return;
         }
 
         if (request.path.find("/api/horus/cameras/") == 0)
         {
-            return m_cameraController.getSnapshot(request);
+            if (request.path.find("/stream") != std::string::npos)
+                m_cameraController.getStream(request, std::move(handler));
+            else
+                m_cameraController.getSnapshot(request, std::move(handler));
+            return;
         }
 
-        return notFound();
+        handler(notFound());
     }
 
 }
\ No newline at end of file
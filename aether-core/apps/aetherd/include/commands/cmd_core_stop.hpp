@@ -2,6 +2,7 @@
 #include <mutex>
 #include <set>
 #include "../../../core/eventbus/include/EventBus.hpp"
+#include "../../../core/utils/logger.hpp"
 
 inline std::mutex stopMutex;
 inline std::condition_variable stopCv;
@@ -33,7 +34,7 @@ inline void waitForAllModulesToStop(const std::vector<IModule*>& modules) {
             EventBus::getInstance().publish(
                 Event("CLI", m->name(), Events::CORE_STOP, {})
             );
-            std::cout << "[CORE_STOP] Enviando comando de parada para o módulo: " << m->name() << std::endl;
+            AETHER_LOG_INFO("CORE_STOP", "Enviando comando de parada para o módulo", AetherCoreLogger::field("module", m->name()));
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "../../../core/eventbus/include/IModule.hpp"
@@ -9,9 +10,21 @@ class ModuleTest;
 class ModulePoseidon;
 class IModule;
 
+namespace Aether::Api
+{
+    class HttpServer;
+}
+
 class AetherDaemon
 {
 public:
+    AetherDaemon();
+
+    /**
+     * @brief Para o servidor de API e aguarda a thread dele
+     */
+    ~AetherDaemon();
+
     /**
      * @brief Função que inicia o daemon do Aether
      * @return retorna 0 caso o daemon for finalizado
@@ -29,8 +42,28 @@ private:
     void initializeCliSocket();
     /**
      * @brief Função que realiza o processamento dos comandos recebidos pelo CLI
+     * @return Texto devolvido ao CLI (vazio = "ACK")
+     */
+    std::string processCliCommands(const std::string& command);
+
+    /**
+     * @brief Trata os comandos trace.on / trace.off / trace.status (PacketCapture)
+     * @return Texto devolvido ao CLI
+     */
+    static std::string processTraceCommand(const std::string& command);
+
+    /**
+     * @brief Trata os comandos spans.on / spans.off / spans.status (Tracing)
+     * @return Texto devolvido ao CLI
      */
-    void processCliCommands(const std::string& command);
+    static std::string processSpansCommand(const std::string& command);
+
+    /**
+     * @brief Trata os comandos admission.status / admission.set (limites do TcpServer)
+     * @return Texto devolvido ao CLI
+     */
+    std::string processAdmissionCommand(const std::string& command);
+
     /**
      * @brief Função que inicializa o servidor TCP para comunicação externa
      */
@@ -38,6 +71,9 @@ private:
 
     /**
      * @brief Função que inicializa o servidor de API REST para comunicação WEB/Http
+     *
+     * O HttpServer::start() bloqueia no io_context, então roda numa thread
+     * própria: o loop do CLI (trace, spans, admission) precisa da thread principal.
      */
     void initializeApiServer();
 
@@ -52,6 +88,8 @@ private:
     std::vector<std::shared_ptr<IModule>> loadedModules;     /// Lista de Modulos do Aether Inicializados
     int server_fd = 0;                                       /// File descriptor do socket do servidor CLI
     std::unique_ptr<TcpServer> tcpServer;                    /// Servidor TCP para comunicação externa
+    std::unique_ptr<Aether::Api::HttpServer> apiServer;      /// Servidor de API HTTP
+    std::thread apiThread;                                   /// Thread que roda o io_context do apiServer
     std::shared_ptr<ModuleTest> moduleTest;                  /// Módulo de Teste (Ponteiro direto para facilitar o acesso)
     std::shared_ptr<ModulePoseidon> modulePoseidon;          /// Módulo Poseidon (Ponteiro direto para facilitar o acesso)
 };
\ No newline at end of file
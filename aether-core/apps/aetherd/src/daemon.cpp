@@ -1,6 +1,9 @@
 #include "../include/daemon.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -11,6 +14,8 @@
 #include "../../../core/network/TcpServer.hpp"
 #include "../../../core/utils/logger.hpp"
 #include "../../../core/network/ProtocolRouter.hpp"
+#include "../../../core/network/PacketCapture.hpp"
+#include "../../../core/utils/Tracing.hpp"
 #include "api/transport/rest/HttpServer.hpp"
 #include "api/config/ApiConfig.hpp"
 
@@ -18,13 +23,27 @@
 
 class IModule; /// Declaração antecipada da classe IModule
 
+AetherDaemon::AetherDaemon() = default;
+
+/**
+ * @brief Para o servidor de API e aguarda a thread dele
+ */
+AetherDaemon::~AetherDaemon()
+{
+    if (apiServer)
+        apiServer->stop();
+
+    if (apiThread.joinable())
+        apiThread.join();
+}
+
 /**
  * @brief Função que inicia o daemon do Aether
  * @return retorna 0 caso o daemon for finalizado
  */
 int AetherDaemon::initializeAetherDaemon()
 {
-    std::cout << "[Daemon] inicializando Aether daemon..." << std::endl;
+    AETHER_LOG_INFO("Daemon", "inicializando Aether daemon");
 
     AetherCoreLogger::Initialize("/var/log/aether/aether_log"); /// Inicializa o sistema de logs do AetherCore
 
@@ -33,7 +52,7 @@ int AetherDaemon::initializeAetherDaemon()
     initializeTcpServer(); /// Inicializa o servidor TCP para comunicação externa
     initializeApiServer(); /// Inicializa o servidor de API HTTP
 
-    std::cout << "[Daemon] Aether daemon executando com sucesso." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Aether daemon executando com sucesso");
 
     /// Loop principal do daemon
     while (true) {
@@ -44,6 +63,7 @@ int AetherDaemon::initializeAetherDaemon()
 
         char buffer[512];                                                /// Buffer para armazenar o comando recebido
         ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer) -1); /// Lê o comando enviado pelo CLI
+        std::string response;                                            /// Retorno do comando para o CLI
 
         if (bytes_read > 0)
         {
@@ -54,9 +74,12 @@ int AetherDaemon::initializeAetherDaemon()
             write(client_fd, response.c_str(), response.size()); //Envia o retorno do comando para o CLI*/
 
             std::string command(buffer, bytes_read);
-            processCliCommands(command);
+            response = processCliCommands(command);
         }
-        write(client_fd, "ACK", 3); /// Envia um ACK simples para o CLI
+
+        if (response.empty())
+            response = "ACK";
+        write(client_fd, response.c_str(), response.size()); /// Envia o retorno (ou um ACK simples) para o CLI
         close(client_fd);           /// Fecha a conexão com o cliente
     }
 
@@ -71,7 +94,7 @@ int AetherDaemon::initializeAetherDaemon()
  */
 void AetherDaemon::initializeModules()
 {
-    std::cout << "[Daemon] Inicializando Modulos individuais." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Inicializando Modulos individuais");
 
     /// Carrega os Modulos Individuais
     loadedModules = createModules();
@@ -82,7 +105,7 @@ void AetherDaemon::initializeModules()
         modules.push_back(m.get()); // Adiciona ao vetor de ponteiros crus
     }
 
-    std::cout << "[Daemon] Modulos individuais inicializados com sucesso." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Modulos individuais inicializados com sucesso");
 }
 
 /**
@@ -107,7 +130,7 @@ std::vector<std::shared_ptr<IModule>> AetherDaemon::createModules()
  */
 void AetherDaemon::initializeCliSocket()
 {
-    std::cout << "[Daemon] Inicializando Daemon Socket CLI." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Inicializando Daemon Socket CLI");
 
     unlink(SOCKET_PATH); // Exclui um arquivo de socket Unix do Sistema (Garante que não tenha lixo na memoria)
     server_fd = socket(AF_UNIX, SOCK_STREAM, 0); // Cria um Socket do tipo UNIX
@@ -133,18 +156,27 @@ void AetherDaemon::initializeCliSocket()
         perror("listen");
     }
 
-    std::cout << "[Daemon] Socket CLI inicializado com sucesso." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Socket CLI inicializado com sucesso");
 }
 
 /**
  * @brief Função que realiza o processamento dos comandos recebidos pelo CLI
  * @param command comando recebido
  */
-void AetherDaemon::processCliCommands(const std::string& command)
+std::string AetherDaemon::processCliCommands(const std::string& command)
 {
+    if (command.rfind("trace.", 0) == 0)
+        return processTraceCommand(command);
+
+    if (command.rfind("spans.", 0) == 0)
+        return processSpansCommand(command);
+
+    if (command.rfind("admission.", 0) == 0)
+        return processAdmissionCommand(command);
+
     if (command == "core.stop")
     {
-        std::cout << "[CLI] Comando recebido 'core.stop'. Parando todos os modulos..." << std::endl;
+        AETHER_LOG_INFO("CLI", "Comando recebido 'core.stop'. Parando todos os modulos");
 
         StopListener stopListener;                        /// Listener para aguardar confirmação de parada dos módulos
         EventBus::getInstance().subscribe(&stopListener); /// Inscreve o listener no EventBus para ouvir o callback
@@ -159,8 +191,181 @@ void AetherDaemon::processCliCommands(const std::string& command)
 
         EventBus::getInstance().unsubscribe(&stopListener); /// Remove o listener do EventBus
 
-        std::cout << "[CLI] Todos os módulos parados." << std::endl;
+        AETHER_LOG_INFO("CLI", "Todos os módulos parados");
+    }
+
+    return {};
+}
+
+/**
+ * @brief Trata os comandos de captura de pacotes vindos do CLI:
+ *  - trace.on [module=<id>] [device=<deviceExternalId>] [file=<caminho>]
+ *  - trace.off
+ *  - trace.status
+ * @param command comando recebido
+ * @return texto devolvido ao CLI
+ */
+std::string AetherDaemon::processTraceCommand(const std::string& command)
+{
+    std::istringstream tokens(command);
+    std::string action;
+    tokens >> action;
+
+    auto& capture = PacketCapture::instance();
+
+    if (action == "trace.off")
+    {
+        capture.stop();
+        return capture.status();
+    }
+
+    if (action == "trace.status")
+        return capture.status();
+
+    if (action != "trace.on")
+        return "Comando de trace desconhecido: " + action;
+
+    PacketCapture::Filter filter;
+    std::string file = "/var/log/aether/trace.pcap";
+
+    for (std::string token; tokens >> token; )
+    {
+        const auto equals = token.find('=');
+        const std::string key = token.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : token.substr(equals + 1);
+
+        if (key == "module")
+        {
+            try {
+                filter.module = static_cast<uint16_t>(std::stoul(value, nullptr, 0)); // aceita 16 ou 0x10
+            } catch (...) {
+                return "Modulo invalido: " + value;
+            }
+        }
+        else if (key == "device")
+            filter.device = value;
+        else if (key == "file")
+            file = value;
+        else
+            return "Parametro desconhecido: " + token;
+    }
+
+    const std::string error = capture.start(file, std::move(filter));
+    return error.empty() ? capture.status() : error;
+}
+
+/**
+ * @brief Trata os comandos de tracing de latência vindos do CLI:
+ *  - spans.on [sample=<N>] [file=<caminho>]
+ *  - spans.off
+ *  - spans.status
+ * @param command comando recebido
+ * @return texto devolvido ao CLI
+ */
+std::string AetherDaemon::processSpansCommand(const std::string& command)
+{
+    using Aether::Core::Utils::Tracing;
+
+    std::istringstream tokens(command);
+    std::string action;
+    tokens >> action;
+
+    if (action == "spans.off")
+    {
+        Tracing::stop();
+        return Tracing::status();
+    }
+
+    if (action == "spans.status")
+        return Tracing::status();
+
+    if (action != "spans.on")
+        return "Comando de spans desconhecido: " + action;
+
+    std::uint32_t sampleEvery = Tracing::DEFAULT_SAMPLE_EVERY;
+    std::string file = "/var/log/aether/spans.json";
+
+    for (std::string token; tokens >> token; )
+    {
+        const auto equals = token.find('=');
+        const std::string key = token.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : token.substr(equals + 1);
+
+        if (key == "sample")
+        {
+            try {
+                sampleEvery = static_cast<std::uint32_t>(std::stoul(value));
+            } catch (...) {
+                return "Amostragem invalida: " + value;
+            }
+        }
+        else if (key == "file")
+            file = value;
+        else
+            return "Parametro desconhecido: " + token;
     }
+
+    const std::string error = Tracing::start(file, sampleEvery);
+    return error.empty() ? Tracing::status() : error;
+}
+
+/**
+ * @brief Trata os comandos de admissão de conexões TCP vindos do CLI:
+ *  - admission.status
+ *  - admission.set [max_connections=<N>] [max_handshakes=<N>] [ip_rate=<N>] [ip_burst=<N>] [limit_loopback=<0|1>] [backlog=<N>]
+ * @param command comando recebido
+ * @return texto devolvido ao CLI
+ */
+std::string AetherDaemon::processAdmissionCommand(const std::string& command)
+{
+    if (!tcpServer)
+        return "admission: servidor TCP nao iniciado";
+
+    std::istringstream tokens(command);
+    std::string action;
+    tokens >> action;
+
+    if (action != "admission.status" && action != "admission.set")
+        return "Comando de admission desconhecido: " + action;
+
+    auto config = tcpServer->getAdmissionConfig();
+
+    for (std::string token; action == "admission.set" && tokens >> token; )
+    {
+        const auto equals = token.find('=');
+        const std::string key = token.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : token.substr(equals + 1);
+
+        try {
+            if (key == "max_connections")
+                config.maxConnections = std::stoul(value);
+            else if (key == "max_handshakes")
+                config.maxHandshakes = std::stoul(value);
+            else if (key == "ip_rate")
+                config.ipRatePerSecond = std::stod(value);
+            else if (key == "ip_burst")
+                config.ipBurst = std::stod(value);
+            else if (key == "limit_loopback")
+                config.limitLoopback = std::stoi(value) != 0;
+            else if (key == "backlog")
+                config.backlog = std::stoi(value);
+            else
+                return "Parametro desconhecido: " + token;
+        } catch (...) {
+            return "Valor invalido: " + token;
+        }
+    }
+
+    if (action == "admission.set")
+        tcpServer->setAdmissionConfig(config);
+
+    std::ostringstream status;
+    status << "admission: " << tcpServer->getConnectionCount() << "/" << config.maxConnections << " conexoes"
+           << ", max_handshakes=" << config.maxHandshakes
+           << ", ip_rate=" << config.ipRatePerSecond << "/s, ip_burst=" << config.ipBurst
+           << ", limit_loopback=" << (config.limitLoopback ? 1 : 0)
+           << ", backlog=" << config.backlog << " (vale no proximo start)";
+    return status.str();
 }
 
 /**
@@ -168,8 +373,18 @@ void AetherDaemon::processCliCommands(const std::string& command)
  */
 void AetherDaemon::initializeTcpServer()
 {
-    std::cout << "[Daemon] Inicializando TCP Server." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Inicializando TCP Server");
     tcpServer = std::make_unique<TcpServer>(9000); /// Cria o servidor TCP na porta 9000
+
+    // Admissão de conexões (também ajustável em execução: admission set ...)
+    AdmissionControl::Config admissionConfig;
+    admissionConfig.backlog = 1024;          // Fila do listen()
+    admissionConfig.maxConnections = 10000;  // Conexões abertas
+    admissionConfig.maxHandshakes = 512;     // Conexões aguardando o HELLO
+    admissionConfig.ipRatePerSecond = 5;     // Reposição do bucket por IP
+    admissionConfig.ipBurst = 50;            // Conexões seguidas por IP (site atrás de NAT)
+    tcpServer->setAdmissionConfig(admissionConfig);
+    tcpServer->setAcceptors(std::max(1u, std::thread::hardware_concurrency())); /// Um acceptor SO_REUSEPORT por core
     auto router = std::make_shared<ProtocolRouter>();
 
     /// Registra automaticamente todos os módulos que falam TCP
@@ -179,14 +394,14 @@ void AetherDaemon::initializeTcpServer()
         if (handler)
         {
             router->registerModule(handler, m);
-            std::cout << "[Daemon] Módulo registrado no ProtocolRouter: 0x" << std::hex << static_cast<int>(handler->moduleId()) << std::dec << std::endl;
+            AETHER_LOG_INFO("Daemon", "Módulo registrado no ProtocolRouter", AetherCoreLogger::field("moduleId", handler->moduleId()));
         }
     }
 
     tcpServer->setProtocolHandler(router);  /// Define o router como destino de todos os pacotes TCP
     tcpServer->start(); /// Inicia o servidor TCP
 
-    std::cout << "[Daemon] Tcp Server inicializado com Sucesso" << std::endl;
+    AETHER_LOG_INFO("Daemon", "Tcp Server inicializado com Sucesso");
 }
 
 /**
@@ -194,16 +409,24 @@ void AetherDaemon::initializeTcpServer()
  */
 void AetherDaemon::initializeApiServer()
 {
-    std::cout << "[Daemon] Inicializando API Server." << std::endl;
+    AETHER_LOG_INFO("Daemon", "Inicializando API Server");
 
     // Configurações da API
     Aether::Api::ApiConfig apiConfig;
     apiConfig.host = "0.0.0.0";  // Escuta em todas as interfaces
     apiConfig.port = 9001;       // Porta da API
+    apiConfig.horusDatabase = Aether::Api::HorusDatabaseConfig::fromEnvironment(); // Credenciais do Horus fora do código
 
-    // Cria e inicia servidor HTTP
-    Aether::Api::HttpServer server(apiConfig);
-    server.start();
+    // Cria o servidor HTTP e roda o io_context numa thread própria (start() bloqueia)
+    apiServer = std::make_unique<Aether::Api::HttpServer>(apiConfig);
+    apiThread = std::thread([this]()
+    {
+        try {
+            apiServer->start();
+        } catch (const std::exception& e) {
+            AETHER_LOG_ERROR("Daemon", "API Server encerrada com erro", AetherCoreLogger::field("error", e.what()));
+        }
+    });
 
-    std::cout << "[Daemon] API Server inicializada com Sucesso" << std::endl;
+    AETHER_LOG_INFO("Daemon", "API Server inicializada com Sucesso");
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Contagem de alocações do processo (operator new substituído em
+ * allocations.cpp)
+ *
+ * Threads marcadas com excludeThisThread() (clientes do teste de carga,
+ * câmera falsa) não entram na conta, então o total corresponde ao que a
+ * API alocou: threads do io_context, logger, access log.
+ */
+namespace Allocations
+{
+    struct Snapshot
+    {
+        uint64_t count = 0;     /**< Chamadas a operator new */
+        uint64_t bytes = 0;     /**< Bytes pedidos */
+    };
+
+    /** @brief Totais até agora */
+    Snapshot snapshot();
+
+    /** @brief Deixa de contar as alocações da thread atual */
+    void excludeThisThread();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parâmetros do aether-apiload
+ *
+ * Cada combinação de threads x concorrência é uma rodada, com um
+ * HttpServer novo no mesmo processo.
+ */
+struct ApiLoadConfig
+{
+    std::vector<unsigned> threads{2};                   /**< ApiConfig::threads de cada rodada */
+    std::vector<unsigned> concurrency{1, 16, 64};       /**< Conexões keep-alive simultâneas (1 requisição em voo cada) */
+    std::string route = "status";                       /**< status | snapshot */
+    std::chrono::seconds duration{5};                   /**< Medição de cada rodada */
+    std::chrono::seconds warmup{1};                     /**< Aquecimento descartado de cada rodada */
+    uint16_t port = 19081;                              /**< Porta da API em 127.0.0.1 */
+    std::string accessLog = "summary";                  /**< off | summary | detail (AccessLogger) */
+    std::string logDir = "/tmp/aether-apiload";         /**< Onde ficam access log e arquivos de detalhe */
+    std::string logLevel = "warn";                      /**< Nível mínimo do log do core */
+    std::size_t jpegSize = 64 * 1024;                   /**< Tamanho do JPEG da câmera falsa */
+    std::chrono::milliseconds cameraMaxAge{1000};       /**< CameraConfig::snapshotMaxAge (0 = sem cache) */
+    std::chrono::milliseconds cameraLatency{0};         /**< Atraso de cada resposta da câmera falsa */
+    bool json = false;                                  /**< Imprime também uma linha JSON por rodada */
+};
+
+/**
+ * @brief Resultado de uma rodada
+ */
+struct ApiLoadResult
+{
+    unsigned threads = 0;
+    unsigned concurrency = 0;
+    uint64_t requests = 0;                  /**< Respostas recebidas na medição */
+    uint64_t non2xx = 0;                    /**< Respostas com status fora de 2xx */
+    uint64_t errors = 0;                    /**< Erros de conexão/leitura (reconecta e segue) */
+    double seconds = 0;
+    uint64_t allocations = 0;               /**< operator new da API durante a medição */
+    uint64_t allocatedBytes = 0;
+    std::vector<uint32_t> latencyMicros;    /**< Latência de cada requisição (ordenado) */
+
+    double requestsPerSecond() const { return seconds > 0 ? requests / seconds : 0; }
+    double allocationsPerRequest() const { return requests ? static_cast<double>(allocations) / requests : 0; }
+    double bytesPerRequest() const { return requests ? static_cast<double>(allocatedBytes) / requests : 0; }
+
+    /** @brief Percentil (0..100) da latência, em microssegundos */
+    uint32_t percentile(double p) const;
+};
+
+/**
+ * @brief Teste de carga da API HTTP
+ *
+ * Sobe a API (HttpServer) no próprio processo, com a câmera do Horus
+ * apontando para uma FakeCamera local, e dispara GETs em conexões
+ * keep-alive: cada conexão é uma thread que manda a próxima requisição
+ * assim que a resposta chega (laço fechado), então a concorrência é
+ * exatamente o número de conexões.
+ *
+ * As alocações contadas são só as da API (clientes e câmera ficam de
+ * fora, ver allocations.hpp), divididas pelas requisições medidas.
+ */
+class ApiLoad
+{
+public:
+    explicit ApiLoad(ApiLoadConfig config);
+
+    /** @brief Executa todas as rodadas (threads x concorrência) */
+    std::vector<ApiLoadResult> run();
+
+    /** @brief Imprime a tabela de resultados (e JSON se config.json) */
+    void print(const std::vector<ApiLoadResult>& results) const;
+
+private:
+    ApiLoadResult runOne(unsigned threads, unsigned concurrency, uint16_t cameraPort);
+
+    /** @brief Uma conexão cliente: GET, espera a resposta, repete até `end` */
+    void clientLoop(std::chrono::steady_clock::time_point measureStart,
+                    std::chrono::steady_clock::time_point end,
+                    ApiLoadResult& result);
+
+    std::string path() const;
+
+    ApiLoadConfig m_config;
+};
@@ -0,0 +1,289 @@
+#include "../include/apiload.hpp"
+#include "../include/allocations.hpp"
+#include "FakeCamera.hpp"
+
+#include "transport/rest/HttpServer.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    int connectTo(uint16_t port)
+    {
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return fd;
+    }
+
+    bool sendAll(int fd, const std::string& data)
+    {
+        std::size_t offset = 0;
+        while (offset < data.size())
+        {
+            const ssize_t written = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+            if (written <= 0)
+                return false;
+            offset += static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    /**
+     * Lê uma resposta HTTP/1.1 com Content-Length (a API não usa chunked
+     * fora do streaming MJPEG). O buffer é reaproveitado entre requisições.
+     * @return status HTTP, ou -1 em erro de conexão/formato
+     */
+    int readResponse(int fd, std::vector<char>& buffer)
+    {
+        std::size_t size = 0;
+        std::size_t headerEnd = std::string::npos;
+        std::size_t total = 0;
+
+        while (true)
+        {
+            if (size == buffer.size())
+                buffer.resize(buffer.size() * 2);
+
+            const ssize_t received = recv(fd, buffer.data() + size, buffer.size() - size, 0);
+            if (received <= 0)
+                return -1;
+            size += static_cast<std::size_t>(received);
+
+            if (headerEnd == std::string::npos)
+            {
+                const std::string_view view(buffer.data(), size);
+                const auto end = view.find("\r\n\r\n");
+                if (end == std::string_view::npos)
+                    continue;
+                headerEnd = end + 4;
+
+                std::size_t contentLength = 0;
+                for (auto line = view.find("\r\n"); line < end; line = view.find("\r\n", line + 2))
+                {
+                    constexpr std::string_view key = "content-length:";
+                    if (strncasecmp(view.data() + line + 2, key.data(), key.size()) == 0)
+                        contentLength = std::strtoull(view.data() + line + 2 + key.size(), nullptr, 10);
+                }
+                total = headerEnd + contentLength;
+            }
+
+            if (size >= total)
+                break;
+        }
+
+        // "HTTP/1.1 200 OK"
+        return size > 12 ? std::atoi(buffer.data() + 9) : -1;
+    }
+}
+
+uint32_t ApiLoadResult::percentile(double p) const
+{
+    if (latencyMicros.empty())
+        return 0;
+
+    const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(latencyMicros.size())));
+    return latencyMicros[std::clamp<std::size_t>(rank, 1, latencyMicros.size()) - 1];
+}
+
+ApiLoad::ApiLoad(ApiLoadConfig config) : m_config(std::move(config)) {}
+
+std::string ApiLoad::path() const
+{
+    return m_config.route == "snapshot" ? "/api/horus/cameras/1/snapshot" : "/api/core/status";
+}
+
+void ApiLoad::clientLoop(Clock::time_point measureStart, Clock::time_point end, ApiLoadResult& result)
+{
+    Allocations::excludeThisThread();
+
+    const std::string request = "GET " + path() + " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: keep-alive\r\n\r\n";
+    std::vector<char> buffer(m_config.jpegSize + 4096);
+    result.latencyMicros.reserve(1 << 16);
+
+    int fd = -1;
+    while (Clock::now() < end)
+    {
+        if (fd < 0 && (fd = connectTo(m_config.port)) < 0)
+        {
+            ++result.errors;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        const auto start = Clock::now();
+        const int status = sendAll(fd, request) ? readResponse(fd, buffer) : -1;
+        const auto finish = Clock::now();
+
+        if (status < 0)
+        {
+            ++result.errors;
+            close(fd);
+            fd = -1;
+            continue;
+        }
+
+        if (start < measureStart)
+            continue;
+
+        ++result.requests;
+        if (status < 200 || status > 299)
+            ++result.non2xx;
+        result.latencyMicros.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count()));
+    }
+
+    if (fd >= 0)
+        close(fd);
+}
+
+ApiLoadResult ApiLoad::runOne(unsigned threads, unsigned concurrency, uint16_t cameraPort)
+{
+    Aether::Api::ApiConfig config;
+    config.host = "127.0.0.1";
+    config.port = m_config.port;
+    config.threads = threads;
+    config.accessLogPath = m_config.logDir + "/access.log";
+    config.requestDetailsDir = m_config.logDir + "/details";
+    if (m_config.accessLog == "off")
+        config.loggedMethods.clear();
+    if (m_config.accessLog != "detail")
+        config.detailedMethods.clear();
+
+    config.horusDatabase.enabled = false;       // Câmera única = a FakeCamera
+    config.camera.host = "127.0.0.1";
+    config.camera.port = cameraPort;
+    config.camera.user = "admin";
+    config.camera.password = "admin";
+    config.camera.snapshotMaxAge = m_config.cameraMaxAge;
+
+    Aether::Api::HttpServer server(config);
+    std::thread serverThread([&server] { server.start(); });
+
+    const auto start = Clock::now();
+    const auto measureStart = start + m_config.warmup;
+    const auto end = measureStart + m_config.duration;
+
+    std::vector<ApiLoadResult> partial(concurrency);
+    std::vector<std::thread> clients;
+    clients.reserve(concurrency);
+    for (unsigned i = 0; i < concurrency; ++i)
+        clients.emplace_back(&ApiLoad::clientLoop, this, measureStart, end, std::ref(partial[i]));
+
+    std::this_thread::sleep_until(measureStart);
+    const auto allocationsBefore = Allocations::snapshot();
+    std::this_thread::sleep_until(end);
+    const auto allocationsAfter = Allocations::snapshot();
+
+    for (auto& client : clients)
+        client.join();
+
+    server.stop();
+    serverThread.join();
+
+    ApiLoadResult result;
+    result.threads = threads;
+    result.concurrency = concurrency;
+    result.seconds = std::chrono::duration<double>(m_config.duration).count();
+    result.allocations = allocationsAfter.count - allocationsBefore.count;
+    result.allocatedBytes = allocationsAfter.bytes - allocationsBefore.bytes;
+
+    for (auto& client : partial)
+    {
+        result.requests += client.requests;
+        result.non2xx += client.non2xx;
+        result.errors += client.errors;
+        result.latencyMicros.insert(result.latencyMicros.end(), client.latencyMicros.begin(), client.latencyMicros.end());
+    }
+
+    std::sort(result.latencyMicros.begin(), result.latencyMicros.end());
+    return result;
+}
+
+std::vector<ApiLoadResult> ApiLoad::run()
+{
+    FakeCamera::Options cameraOptions;
+    cameraOptions.jpegSize = m_config.jpegSize;
+    cameraOptions.latency = m_config.cameraLatency;
+    cameraOptions.onThreadStart = Allocations::excludeThisThread;
+    FakeCamera camera(cameraOptions);
+
+    std::vector<ApiLoadResult> results;
+    for (const unsigned threads : m_config.threads)
+    {
+        for (const unsigned concurrency : m_config.concurrency)
+        {
+            std::fprintf(stderr, "  rodada: %u threads, %u conexoes...\n", threads, concurrency);
+            results.push_back(runOne(threads, concurrency, camera.port()));
+        }
+    }
+
+    const auto stats = camera.stats();
+    std::fprintf(stderr, "  camera falsa: %llu snapshots, %llu desafios\n",
+                 static_cast<unsigned long long>(stats.snapshots),
+                 static_cast<unsigned long long>(stats.challenges + stats.staleChallenges));
+    return results;
+}
+
+void ApiLoad::print(const std::vector<ApiLoadResult>& results) const
+{
+    std::printf("aether-apiload: GET %s, %llds por rodada (+%llds aquecimento), access log %s, log %s\n",
+                path().c_str(),
+                static_cast<long long>(m_config.duration.count()), static_cast<long long>(m_config.warmup.count()),
+                m_config.accessLog.c_str(), m_config.logLevel.c_str());
+    std::printf("%7s %6s %10s %8s %8s %8s %8s %7s %6s %10s %10s\n",
+                "threads", "conex", "req/s", "p50 us", "p99 us", "p999 us", "max us", "!2xx", "erros", "allocs/req", "bytes/req");
+
+    for (const auto& r : results)
+    {
+        std::printf("%7u %6u %10.0f %8u %8u %8u %8u %7llu %6llu %10.1f %10.0f\n",
+                    r.threads, r.concurrency, r.requestsPerSecond(),
+                    r.percentile(50), r.percentile(99), r.percentile(99.9),
+                    r.latencyMicros.empty() ? 0 : r.latencyMicros.back(),
+                    static_cast<unsigned long long>(r.non2xx), static_cast<unsigned long long>(r.errors),
+                    r.allocationsPerRequest(), r.bytesPerRequest());
+    }
+
+    if (!m_config.json)
+        return;
+
+    for (const auto& r : results)
+    {
+        std::printf(R"({"route":"%s","threads":%u,"concurrency":%u,"access_log":"%s","log_level":"%s","seconds":%.3f,)"
+                    R"("requests":%llu,"rps":%.3f,"p50_us":%u,"p99_us":%u,"p999_us":%u,"max_us":%u,)"
+                    R"("non_2xx":%llu,"errors":%llu,"allocs_per_request":%.3f,"bytes_per_request":%.1f})" "\n",
+                    m_config.route.c_str(), r.threads, r.concurrency, m_config.accessLog.c_str(), m_config.logLevel.c_str(),
+                    r.seconds, static_cast<unsigned long long>(r.requests), r.requestsPerSecond(),
+                    r.percentile(50), r.percentile(99), r.percentile(99.9),
+                    r.latencyMicros.empty() ? 0 : r.latencyMicros.back(),
+                    static_cast<unsigned long long>(r.non2xx), static_cast<unsigned long long>(r.errors),
+                    r.allocationsPerRequest(), r.bytesPerRequest());
+    }
+}
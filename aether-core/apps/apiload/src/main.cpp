@@ -0,0 +1,117 @@
+#include "../include/apiload.hpp"
+
+#include "../../../core/utils/logger.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout <<
+            "Uso: aether-apiload [opcoes]\n"
+            "\n"
+            "Sobe a API HTTP no proprio processo (camera do Horus = camera falsa local)\n"
+            "e mede req/s, latencia e alocacoes por requisicao em conexoes keep-alive.\n"
+            "\n"
+            "  --route status|snapshot     Rota medida (padrao status)\n"
+            "  --threads <n[,n...]>        Threads da API; uma rodada por valor (padrao 2)\n"
+            "  --concurrency <n[,n...]>    Conexoes simultaneas (padrao 1,16,64)\n"
+            "  --duration <s>              Medicao de cada rodada (padrao 5)\n"
+            "  --warmup <s>                Aquecimento de cada rodada (padrao 1)\n"
+            "  --port <n>                  Porta da API em 127.0.0.1 (padrao 19081)\n"
+            "  --access-log off|summary|detail   AccessLogger (padrao summary)\n"
+            "  --log-dir <dir>             Access log e detalhes (padrao /tmp/aether-apiload)\n"
+            "  --log-level trace|debug|info|warn|error   Log do core (padrao warn)\n"
+            "  --jpeg-size <bytes>         JPEG da camera falsa (padrao 65536)\n"
+            "  --camera-max-age <ms>       Cache de snapshot da API; 0 = sempre busca (padrao 1000)\n"
+            "  --camera-latency <ms>       Atraso de cada resposta da camera falsa (padrao 0)\n"
+            "  --json                      Imprime tambem uma linha JSON por rodada\n"
+            "  --help                      Mostra esta ajuda\n";
+    }
+
+    std::vector<unsigned> parseList(const std::string& value)
+    {
+        std::vector<unsigned> list;
+        std::stringstream stream(value);
+        for (std::string item; std::getline(stream, item, ',');)
+        {
+            const auto n = std::stoul(item);
+            if (n == 0)
+                throw std::invalid_argument("valores precisam ser > 0: " + value);
+            list.push_back(static_cast<unsigned>(n));
+        }
+        return list;
+    }
+
+    AetherCoreLogger::Level parseLevel(const std::string& value)
+    {
+        using Level = AetherCoreLogger::Level;
+        if (value == "trace") return Level::Trace;
+        if (value == "debug") return Level::Debug;
+        if (value == "info")  return Level::Info;
+        if (value == "warn")  return Level::Warn;
+        if (value == "error") return Level::Error;
+        throw std::invalid_argument("nivel de log desconhecido: " + value);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ApiLoadConfig config;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("faltou o valor de " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h")         { printUsage(); return 0; }
+            else if (arg == "--json")                   config.json = true;
+            else if (arg == "--route")                  config.route = value();
+            else if (arg == "--threads")                config.threads = parseList(value());
+            else if (arg == "--concurrency")            config.concurrency = parseList(value());
+            else if (arg == "--duration")               config.duration = std::chrono::seconds(std::stol(value()));
+            else if (arg == "--warmup")                 config.warmup = std::chrono::seconds(std::stol(value()));
+            else if (arg == "--port")                   config.port = static_cast<uint16_t>(std::stoul(value()));
+            else if (arg == "--access-log")             config.accessLog = value();
+            else if (arg == "--log-dir")                config.logDir = value();
+            else if (arg == "--log-level")              config.logLevel = value();
+            else if (arg == "--jpeg-size")              config.jpegSize = std::stoul(value());
+            else if (arg == "--camera-max-age")         config.cameraMaxAge = std::chrono::milliseconds(std::stol(value()));
+            else if (arg == "--camera-latency")         config.cameraLatency = std::chrono::milliseconds(std::stol(value()));
+            else
+                throw std::invalid_argument("opcao desconhecida: " + arg);
+        }
+
+        if (config.route != "status" && config.route != "snapshot")
+            throw std::invalid_argument("--route deve ser status ou snapshot");
+        if (config.accessLog != "off" && config.accessLog != "summary" && config.accessLog != "detail")
+            throw std::invalid_argument("--access-log deve ser off, summary ou detail");
+        if (config.duration.count() <= 0)
+            throw std::invalid_argument("--duration precisa ser > 0");
+
+        AetherCoreLogger::setMinLevel(parseLevel(config.logLevel));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "aether-apiload: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    ApiLoad load(config);
+    const auto results = load.run();
+    load.print(results);
+
+    return 0;
+}
@@ -43,6 +43,18 @@ class CliApp
          */
         void handleCoreCommand(const std::vector<std::string>& args);
 
+        /**
+         * @brief Implementa os comandos trace|spans on|off|status (captura de pacotes e tracing de latência do Daemon)
+         * @param args argumentos fornecidos no Shell
+         */
+        void handleTraceCommand(const std::vector<std::string>& args);
+
+        /**
+         * @brief Implementa os comandos admission status|set (limites de conexões TCP do Daemon)
+         * @param args argumentos fornecidos no Shell
+         */
+        void handleAdmissionCommand(const std::vector<std::string>& args);
+
         /**
          * @brief Implementa uma função para exibir os logs do Aether (tail -f)
          * @param args argumentos fornecidos no Shell
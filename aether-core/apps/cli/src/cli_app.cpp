@@ -105,6 +105,10 @@ int CliApp::runShell()
             handleCoreCommand(args);
         } else if (cmd_category == "logs"){
             handleLogsCommand(args);
+        } else if (cmd_category == "trace" || cmd_category == "spans"){
+            handleTraceCommand(args);
+        } else if (cmd_category == "admission"){
+            handleAdmissionCommand(args);
         } else {
             std::cout << "Comandos desconhecido" << std::endl;
         }
@@ -213,6 +217,59 @@ void CliApp::handleCoreCommand(const std::vector<std::string>& args)
     }
 }
 
+/**
+ * @brief Liga/desliga a captura de pacotes (trace, arquivo pcap) ou o
+ * tracing de latência (spans, arquivo JSON) do Daemon
+ * @param args argumentos fornecidos no Shell, ex: trace on module=0x10 device=ESP32
+ */
+void CliApp::handleTraceCommand(const std::vector<std::string>& args)
+{
+    const std::string usage = args[0] == "spans"
+        ? "Uso: spans <on [sample=<N>] [file=<caminho>]|off|status>"
+        : "Uso: trace <on [module=<id>] [device=<id>] [file=<caminho>]|off|status>";
+
+    if (args.size() < 2)
+    {
+        std::cout << usage << std::endl;
+        return;
+    }
+
+    const std::string& action = args[1];
+    if (action != "on" && action != "off" && action != "status")
+    {
+        std::cout << usage << std::endl;
+        return;
+    }
+
+    std::string command = args[0] + "." + action;
+    for (std::size_t i = 2; i < args.size(); ++i)
+        command += " " + args[i];
+
+    std::cout << CliApp::sendCommand(command) << std::endl;
+}
+
+/**
+ * @brief Consulta ou ajusta os limites de admissão de conexões TCP do Daemon
+ * @param args argumentos fornecidos no Shell, ex: admission set ip_rate=10 ip_burst=100
+ */
+void CliApp::handleAdmissionCommand(const std::vector<std::string>& args)
+{
+    const std::string usage = "Uso: admission <status|set [max_connections=<N>] [max_handshakes=<N>] "
+                              "[ip_rate=<N>] [ip_burst=<N>] [limit_loopback=<0|1>] [backlog=<N>]>";
+
+    if (args.size() < 2 || (args[1] != "status" && args[1] != "set"))
+    {
+        std::cout << usage << std::endl;
+        return;
+    }
+
+    std::string command = args[0] + "." + args[1];
+    for (std::size_t i = 2; i < args.size(); ++i)
+        command += " " + args[i];
+
+    std::cout << CliApp::sendCommand(command) << std::endl;
+}
+
 std::string CliApp::sendCommand(std::string command)
 {
     int fd = socket(AF_UNIX , SOCK_STREAM , 0);
@@ -237,7 +294,8 @@ std::string CliApp::sendCommand(std::string command)
     ssize_t bytes_read = read(fd, buffer, sizeof(buffer)-1);
 
     if (bytes_read > 0) {
-        return buffer;
+        close(fd);
+        return std::string(buffer, bytes_read);
     }
 
     close(fd);
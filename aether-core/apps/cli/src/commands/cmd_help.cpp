@@ -20,6 +20,9 @@ int cmd_help(const std::vector<std::string>& arg)
 
     std::cout << "\n  core <start|stop|status>     -  Inicia/Para ou verifica o status de todos os modulos." << std::endl;
     std::cout << "  logs <size>                  -  Exibe os logs do Aetherd (Daemon)" << std::endl;
+    std::cout << "  trace <on|off|status>        -  Captura os frames TCP em pcap (on aceita module=<id> device=<id> file=<caminho>)" << std::endl;
+    std::cout << "  spans <on|off|status>        -  Grava spans de latencia por pacote em JSON (on aceita sample=<N> file=<caminho>)" << std::endl;
+    std::cout << "  admission <status|set>       -  Limites de conexoes TCP (set aceita max_connections= max_handshakes= ip_rate= ip_burst= limit_loopback= backlog=)" << std::endl;
 
     std::cout << "\n\n" << std::endl;
 
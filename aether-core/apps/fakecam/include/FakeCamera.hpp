@@ -0,0 +1,123 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Câmera IP falsa (simulador Dahua/Intelbras) para testes e
+ * benchmarks do Horus sem a câmera real
+ *
+ * Atende GET /cgi-bin/snapshot.cgi?channel=N com HTTP Digest e
+ * keep-alive, devolvendo um JPEG sintético. O comportamento da câmera
+ * real que afeta o CameraClient/CameraService é configurável:
+ *
+ * - qop oferecido no desafio ("auth", "auth,auth-int" ou vazio = RFC 2069)
+ * - validade do nonce: vencido, o próximo pedido recebe 401 com um nonce
+ *   novo, com ou sem stale=true (há câmeras que não mandam o stale)
+ * - latência (fixa + jitter), respostas 500 e conexões derrubadas sem
+ *   resposta, sorteadas por requisição
+ * - máximo de requisições por conexão keep-alive
+ *
+ * Usada pelo aether-apiload (no mesmo processo) e pelo aether-fakecam
+ * (executável, para apontar um aetherd de verdade para ela).
+ */
+class FakeCamera
+{
+public:
+    struct Options
+    {
+        std::string address = "127.0.0.1";                 /**< Endereço de escuta */
+        uint16_t port = 0;                                  /**< Porta (0 = uma livre, ver port()) */
+        unsigned threads = 1;                               /**< Threads do io_context */
+
+        std::string user = "admin";                         /**< Usuário do Digest */
+        std::string password = "admin";                    /**< Senha do Digest */
+        std::string realm = "Login to FakeCam";             /**< realm do desafio */
+        std::string qop = "auth";                           /**< qop oferecido; vazio = RFC 2069 */
+        std::chrono::milliseconds nonceLifetime{0};         /**< Validade de cada nonce (0 = não vence) */
+        bool sendStale = true;                              /**< Nonce vencido responde com stale=true */
+
+        unsigned channels = 16;                             /**< Canais válidos (1..channels); fora disso 404 */
+        std::size_t jpegSize = 64 * 1024;                   /**< Tamanho do JPEG devolvido */
+
+        std::chrono::milliseconds latency{0};               /**< Atraso antes de cada resposta */
+        std::chrono::milliseconds jitter{0};                /**< Atraso extra sorteado em [0, jitter] */
+        double failureRate = 0;                             /**< Fração das requisições respondidas com 500 */
+        double dropRate = 0;                                /**< Fração das conexões derrubadas sem resposta */
+        unsigned keepAliveMax = 0;                          /**< Requisições por conexão (0 = sem limite) */
+
+        std::function<void()> onThreadStart;                /**< Chamado no início de cada thread da câmera */
+    };
+
+    /** @brief Contadores desde a criação */
+    struct Stats
+    {
+        uint64_t snapshots = 0;         /**< 200 com JPEG */
+        uint64_t challenges = 0;        /**< 401 por falta de Authorization */
+        uint64_t staleChallenges = 0;   /**< 401 por nonce vencido */
+        uint64_t authFailures = 0;      /**< 401 por credencial/resposta errada */
+        uint64_t failures = 0;          /**< 500 injetados */
+        uint64_t drops = 0;             /**< Conexões derrubadas sem resposta */
+        uint64_t connections = 0;       /**< Conexões aceitas */
+    };
+
+    /** @brief Sobe a câmera e começa a atender */
+    explicit FakeCamera(Options options);
+    ~FakeCamera();
+
+    FakeCamera(const FakeCamera&) = delete;
+    FakeCamera& operator=(const FakeCamera&) = delete;
+
+    /** @brief Porta em que a câmera está escutando */
+    uint16_t port() const { return m_port; }
+
+    /** @brief Cópia dos contadores */
+    Stats stats() const;
+
+private:
+    class Session;
+
+    /** @brief Resultado da checagem do Authorization */
+    enum class Auth { Missing, Invalid, Stale, Ok };
+
+    void doAccept();
+
+    /** @brief Confere um header Authorization contra o nonce atual */
+    Auth checkAuthorization(const std::string& header, const std::string& target);
+
+    /** @brief Header WWW-Authenticate com o nonce atual (trocando-o se venceu) */
+    std::string challenge(bool stale);
+
+    /** @brief Sorteio uniforme em [0, 1) (gerador por thread) */
+    static double random();
+
+    Options m_options;
+    std::vector<uint8_t> m_jpeg;                            /**< JPEG sintético (SOI + padding + EOI) */
+
+    std::mutex m_nonceMutex;                                /**< Protege o nonce atual */
+    std::string m_nonce;
+    std::chrono::steady_clock::time_point m_nonceIssuedAt;
+
+    boost::asio::io_context m_ioContext;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+    uint16_t m_port = 0;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<uint64_t> m_snapshots{0};
+    std::atomic<uint64_t> m_challenges{0};
+    std::atomic<uint64_t> m_staleChallenges{0};
+    std::atomic<uint64_t> m_authFailures{0};
+    std::atomic<uint64_t> m_failures{0};
+    std::atomic<uint64_t> m_drops{0};
+    std::atomic<uint64_t> m_connections{0};
+};
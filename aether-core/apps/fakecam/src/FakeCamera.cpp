@@ -0,0 +1,321 @@
+#include "../include/FakeCamera.hpp"
+
+#include "services/modules/Horus/DigestAuth.hpp"
+#include "../../../core/utils/Md5.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+using tcp = boost::asio::ip::tcp;
+using Aether::Api::DigestAuth;
+using Aether::Core::Utils::Md5;
+
+namespace
+{
+    std::mt19937_64& generator()
+    {
+        thread_local std::mt19937_64 instance(std::random_device{}());
+        return instance;
+    }
+
+    std::string newNonce()
+    {
+        char nonce[33];
+        std::snprintf(nonce, sizeof(nonce), "%016llx%016llx",
+                      static_cast<unsigned long long>(generator()()),
+                      static_cast<unsigned long long>(generator()()));
+        return nonce;
+    }
+
+    /** Canal do target "/cgi-bin/snapshot.cgi?channel=N", ou 0 se ausente/inválido */
+    unsigned channelOf(std::string_view target)
+    {
+        const auto pos = target.find("channel=");
+        if (pos == std::string_view::npos)
+            return 0;
+
+        return static_cast<unsigned>(std::strtoul(std::string(target.substr(pos + 8)).c_str(), nullptr, 10));
+    }
+}
+
+/**
+ * Uma conexão keep-alive: lê requisição, decide a resposta, espera a
+ * latência configurada, responde e repete.
+ */
+class FakeCamera::Session : public std::enable_shared_from_this<Session>
+{
+public:
+    Session(FakeCamera& camera, tcp::socket socket)
+        : m_camera(camera)
+        , m_stream(std::move(socket))
+        , m_timer(m_stream.get_executor())
+    {
+    }
+
+    void run() { read(); }
+
+private:
+    FakeCamera& m_camera;
+    beast::tcp_stream m_stream;
+    boost::asio::steady_timer m_timer;
+    beast::flat_buffer m_buffer;
+    http::request<http::empty_body> m_request;
+    http::response<http::vector_body<uint8_t>> m_response;
+    unsigned m_served = 0;
+
+    void read()
+    {
+        m_request = {};
+        http::async_read(m_stream, m_buffer, m_request,
+            [self = shared_from_this()](beast::error_code ec, std::size_t)
+            {
+                if (!ec)
+                    self->respond();
+            });
+    }
+
+    void respond()
+    {
+        const auto& options = m_camera.m_options;
+
+        if (options.dropRate > 0 && FakeCamera::random() < options.dropRate)
+        {
+            m_camera.m_drops.fetch_add(1, std::memory_order_relaxed);
+            beast::error_code ignored;
+            m_stream.socket().shutdown(tcp::socket::shutdown_both, ignored);
+            m_stream.close();
+            return;
+        }
+
+        ++m_served;
+        m_response = {};
+        m_response.version(11);
+        m_response.keep_alive(m_request.keep_alive() && (options.keepAliveMax == 0 || m_served < options.keepAliveMax));
+        m_response.set(http::field::server, "FakeCam");
+
+        const std::string target(m_request.target());
+        const unsigned channel = channelOf(target);
+
+        if (target.rfind("/cgi-bin/snapshot.cgi", 0) != 0 || channel == 0 || channel > options.channels)
+        {
+            m_response.result(http::status::not_found);
+        }
+        else
+        {
+            switch (m_camera.checkAuthorization(std::string(m_request[http::field::authorization]), target))
+            {
+                case Auth::Missing:
+                    m_camera.m_challenges.fetch_add(1, std::memory_order_relaxed);
+                    unauthorized(false);
+                    break;
+                case Auth::Invalid:
+                    m_camera.m_authFailures.fetch_add(1, std::memory_order_relaxed);
+                    unauthorized(false);
+                    break;
+                case Auth::Stale:
+                    m_camera.m_staleChallenges.fetch_add(1, std::memory_order_relaxed);
+                    unauthorized(true);
+                    break;
+                case Auth::Ok:
+                    if (options.failureRate > 0 && FakeCamera::random() < options.failureRate)
+                    {
+                        m_camera.m_failures.fetch_add(1, std::memory_order_relaxed);
+                        m_response.result(http::status::internal_server_error);
+                    }
+                    else
+                    {
+                        m_camera.m_snapshots.fetch_add(1, std::memory_order_relaxed);
+                        m_response.result(http::status::ok);
+                        m_response.set(http::field::content_type, "image/jpeg");
+                        m_response.body() = m_camera.m_jpeg;
+                    }
+                    break;
+            }
+        }
+
+        m_response.prepare_payload();
+
+        auto delay = options.latency;
+        if (options.jitter.count() > 0)
+            delay += std::chrono::milliseconds(static_cast<long>(FakeCamera::random() * (options.jitter.count() + 1)));
+
+        if (delay.count() == 0)
+        {
+            write();
+            return;
+        }
+
+        m_timer.expires_after(delay);
+        m_timer.async_wait([self = shared_from_this()](beast::error_code ec)
+        {
+            if (!ec)
+                self->write();
+        });
+    }
+
+    void unauthorized(bool stale)
+    {
+        m_response.result(http::status::unauthorized);
+        m_response.set(http::field::www_authenticate, m_camera.challenge(stale));
+    }
+
+    void write()
+    {
+        http::async_write(m_stream, m_response,
+            [self = shared_from_this()](beast::error_code ec, std::size_t)
+            {
+                if (ec)
+                    return;
+
+                if (self->m_response.keep_alive())
+                {
+                    self->read();
+                    return;
+                }
+
+                beast::error_code ignored;
+                self->m_stream.socket().shutdown(tcp::socket::shutdown_send, ignored);
+            });
+    }
+};
+
+FakeCamera::FakeCamera(Options options)
+    : m_options(std::move(options))
+    , m_acceptor(m_ioContext, tcp::endpoint(boost::asio::ip::make_address(m_options.address), m_options.port))
+{
+    m_nonce = newNonce();
+    m_nonceIssuedAt = std::chrono::steady_clock::now();
+
+    // SOI + APP0 vazio + padding + EOI: suficiente para quem só repassa os bytes
+    m_jpeg.assign(std::max<std::size_t>(m_options.jpegSize, 8), 0x00);
+    m_jpeg[0] = 0xFF; m_jpeg[1] = 0xD8; m_jpeg[2] = 0xFF; m_jpeg[3] = 0xE0;
+    m_jpeg[m_jpeg.size() - 2] = 0xFF; m_jpeg[m_jpeg.size() - 1] = 0xD9;
+
+    m_port = m_acceptor.local_endpoint().port();
+
+    doAccept();
+
+    for (unsigned i = 0; i < std::max(1u, m_options.threads); ++i)
+    {
+        m_threads.emplace_back([this]
+        {
+            if (m_options.onThreadStart)
+                m_options.onThreadStart();
+            m_ioContext.run();
+        });
+    }
+}
+
+FakeCamera::~FakeCamera()
+{
+    m_ioContext.stop();
+    for (auto& thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+FakeCamera::Stats FakeCamera::stats() const
+{
+    Stats stats;
+    stats.snapshots = m_snapshots.load(std::memory_order_relaxed);
+    stats.challenges = m_challenges.load(std::memory_order_relaxed);
+    stats.staleChallenges = m_staleChallenges.load(std::memory_order_relaxed);
+    stats.authFailures = m_authFailures.load(std::memory_order_relaxed);
+    stats.failures = m_failures.load(std::memory_order_relaxed);
+    stats.drops = m_drops.load(std::memory_order_relaxed);
+    stats.connections = m_connections.load(std::memory_order_relaxed);
+    return stats;
+}
+
+double FakeCamera::random()
+{
+    return std::uniform_real_distribution<double>(0.0, 1.0)(generator());
+}
+
+void FakeCamera::doAccept()
+{
+    m_acceptor.async_accept(boost::asio::make_strand(m_ioContext), [this](beast::error_code ec, tcp::socket socket)
+    {
+        if (!ec)
+        {
+            m_connections.fetch_add(1, std::memory_order_relaxed);
+            std::make_shared<Session>(*this, std::move(socket))->run();
+        }
+
+        doAccept();
+    });
+}
+
+/**
+ * Confere o Authorization (RFC 2617 com qop=auth, ou RFC 2069 sem qop).
+ * A resposta é validada contra o nonce que o cliente usou: credencial
+ * certa com nonce antigo (ou vencido) é Stale, não Invalid, como nas
+ * câmeras reais.
+ */
+FakeCamera::Auth FakeCamera::checkAuthorization(const std::string& header, const std::string& target)
+{
+    if (header.rfind("Digest ", 0) != 0)
+        return Auth::Missing;
+
+    const auto param = [&](const char* key) { return DigestAuth::extractParam(header, key); };
+
+    const std::string uri = param("uri");
+    const std::string qop = param("qop");
+
+    if (param("username") != m_options.user || param("realm") != m_options.realm || uri != target)
+        return Auth::Invalid;
+
+    // Cliente precisa usar o qop oferecido (só "auth" é implementado aqui)
+    if (qop != (m_options.qop.empty() ? "" : "auth"))
+        return Auth::Invalid;
+
+    const std::string nonce = param("nonce");
+    const std::string ha1 = Md5::hash(m_options.user + ":" + m_options.realm + ":" + m_options.password);
+    const std::string ha2 = Md5::hash("GET:" + uri);
+    const std::string expected = qop.empty()
+        ? Md5::hash(ha1 + ":" + nonce + ":" + ha2)
+        : Md5::hash(ha1 + ":" + nonce + ":" + param("nc") + ":" + param("cnonce") + ":" + qop + ":" + ha2);
+
+    if (param("response") != expected)
+        return Auth::Invalid;
+
+    std::lock_guard<std::mutex> lock(m_nonceMutex);
+    const bool expired = m_options.nonceLifetime.count() > 0 &&
+                         std::chrono::steady_clock::now() - m_nonceIssuedAt > m_options.nonceLifetime;
+
+    return nonce == m_nonce && !expired ? Auth::Ok : Auth::Stale;
+}
+
+std::string FakeCamera::challenge(bool stale)
+{
+    std::string nonce;
+    {
+        std::lock_guard<std::mutex> lock(m_nonceMutex);
+        const auto now = std::chrono::steady_clock::now();
+        if (m_options.nonceLifetime.count() > 0 && now - m_nonceIssuedAt > m_options.nonceLifetime)
+        {
+            m_nonce = newNonce();
+            m_nonceIssuedAt = now;
+        }
+        nonce = m_nonce;
+    }
+
+    std::string header = "Digest realm=\"" + m_options.realm + "\"";
+    if (!m_options.qop.empty())
+        header += ", qop=\"" + m_options.qop + "\"";
+    header += ", nonce=\"" + nonce + "\", opaque=\"fakecam\"";
+    if (stale && m_options.sendStale)
+        header += ", stale=TRUE";
+
+    return header;
+}
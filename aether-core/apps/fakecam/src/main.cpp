@@ -0,0 +1,116 @@
+#include "../include/FakeCamera.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout <<
+            "Uso: aether-fakecam [opcoes]\n"
+            "\n"
+            "Camera IP falsa (snapshot Dahua/Intelbras com HTTP Digest) para testar o Horus.\n"
+            "Cadastre em horus.came_camera com link_connection http://HOST:PORTA/cgi-bin/snapshot.cgi?channel=1\n"
+            "\n"
+            "  --address <ip>          Endereco de escuta (padrao 127.0.0.1)\n"
+            "  --port <n>              Porta (padrao 8080; 0 = qualquer livre)\n"
+            "  --threads <n>           Threads (padrao 1)\n"
+            "  --user <u> --password <p>   Credenciais do Digest (padrao admin/admin)\n"
+            "  --realm <r>             realm do desafio\n"
+            "  --qop <auth|auth,auth-int|none>   qop oferecido (padrao auth; none = RFC 2069)\n"
+            "  --nonce-lifetime <ms>   Validade do nonce; 0 = nao vence (padrao 0)\n"
+            "  --no-stale              Nonce vencido responde 401 sem stale=true\n"
+            "  --channels <n>          Canais validos 1..n (padrao 16)\n"
+            "  --jpeg-size <bytes>     Tamanho do JPEG (padrao 65536)\n"
+            "  --latency <ms>          Atraso fixo por resposta\n"
+            "  --jitter <ms>           Atraso extra sorteado em [0, jitter]\n"
+            "  --failure-rate <0..1>   Fracao de respostas 500\n"
+            "  --drop-rate <0..1>      Fracao de conexoes derrubadas sem resposta\n"
+            "  --keepalive-max <n>     Requisicoes por conexao; 0 = sem limite\n"
+            "  --help                  Mostra esta ajuda\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FakeCamera::Options options;
+    options.port = 8080;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("faltou o valor de " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h")         { printUsage(); return 0; }
+            else if (arg == "--address")                options.address = value();
+            else if (arg == "--port")                   options.port = static_cast<uint16_t>(std::stoul(value()));
+            else if (arg == "--threads")                options.threads = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--user")                   options.user = value();
+            else if (arg == "--password")               options.password = value();
+            else if (arg == "--realm")                  options.realm = value();
+            else if (arg == "--qop")                    { options.qop = value(); if (options.qop == "none") options.qop.clear(); }
+            else if (arg == "--nonce-lifetime")         options.nonceLifetime = std::chrono::milliseconds(std::stol(value()));
+            else if (arg == "--no-stale")               options.sendStale = false;
+            else if (arg == "--channels")               options.channels = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--jpeg-size")              options.jpegSize = std::stoul(value());
+            else if (arg == "--latency")                options.latency = std::chrono::milliseconds(std::stol(value()));
+            else if (arg == "--jitter")                 options.jitter = std::chrono::milliseconds(std::stol(value()));
+            else if (arg == "--failure-rate")           options.failureRate = std::stod(value());
+            else if (arg == "--drop-rate")              options.dropRate = std::stod(value());
+            else if (arg == "--keepalive-max")          options.keepAliveMax = static_cast<unsigned>(std::stoul(value()));
+            else
+                throw std::invalid_argument("opcao desconhecida: " + arg);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "aether-fakecam: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    // Bloqueia antes de criar as threads da câmera, para só esta thread receber os sinais
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+        FakeCamera camera(options);
+        std::printf("aether-fakecam escutando em %s:%u (Ctrl+C para sair)\n", options.address.c_str(), camera.port());
+        std::fflush(stdout);
+
+        int signal = 0;
+        sigwait(&signals, &signal);
+
+        const auto stats = camera.stats();
+        std::printf("conexoes %llu, snapshots %llu, 401 %llu (stale %llu, credencial %llu), 500 %llu, derrubadas %llu\n",
+                    static_cast<unsigned long long>(stats.connections),
+                    static_cast<unsigned long long>(stats.snapshots),
+                    static_cast<unsigned long long>(stats.challenges + stats.staleChallenges + stats.authFailures),
+                    static_cast<unsigned long long>(stats.staleChallenges),
+                    static_cast<unsigned long long>(stats.authFailures),
+                    static_cast<unsigned long long>(stats.failures),
+                    static_cast<unsigned long long>(stats.drops));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "aether-fakecam: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
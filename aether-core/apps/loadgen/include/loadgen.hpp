@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../../protocols/aether/include/Packet.hpp"
+
+/**
+ * @brief Parâmetros de uma rodada do aether-loadgen
+ */
+struct LoadgenConfig
+{
+    std::string host = "127.0.0.1";             /**< Endereço do aetherd */
+    uint16_t port = 9000;                       /**< Porta TCP do aetherd */
+    unsigned devices = 10;                      /**< Devices simulados (1 conexão e 1 thread cada) */
+    double rate = 10.0;                         /**< DATA_PUSH por segundo, por device (0 = o mais rápido possível) */
+    unsigned window = 1;                        /**< Máximo de DATA_PUSH sem resposta, por device */
+    std::size_t payloadSize = 0;                /**< Tamanho mínimo do payload JSON (completa com padding) */
+    std::chrono::seconds duration{10};          /**< Duração da medição */
+    std::chrono::seconds warmup{2};             /**< Aquecimento antes da medição (latências descartadas) */
+    std::string devicePrefix = "loadgen-";      /**< deviceExternalId = prefixo + índice */
+    std::string sensorId = "SensorTemp01";      /**< sensor_external_id enviado no DATA_PUSH */
+    uint32_t binarySensorId = 0;                /**< sens_sensor.id; != 0 envia DATA_PUSH_BINARY em vez de JSON */
+    unsigned batch = 1;                         /**< Leituras por frame; > 1 envia DATA_PUSH_BATCH (requer binarySensorId) */
+    bool compress = false;                      /**< HELLO v2 pedindo Deflate; payloads grandes vão comprimidos */
+    bool crc = false;                           /**< HELLO v2 com CRC32C; todos os frames (nos dois sentidos) com trailer */
+    bool requestIds = false;                    /**< v2 com request id em cada DATA_PUSH; respostas casadas pelo id */
+    uint16_t module = 0x03;                     /**< Módulo de destino (ModuleId::MODULE_POSEIDON) */
+    bool json = false;                          /**< Imprime o resultado também em JSON (uma linha) */
+};
+
+/**
+ * @brief Resultado de uma rodada
+ */
+struct LoadgenReport
+{
+    unsigned connected = 0;                     /**< Devices que completaram o HELLO */
+    uint64_t sent = 0;                          /**< DATA_PUSH enviados na medição */
+    uint64_t acked = 0;                         /**< Respostas ACK na medição */
+    uint64_t errors = 0;                        /**< Respostas ERROR_GENERIC / MODULE_UNAVAILABLE na medição */
+    uint64_t unanswered = 0;                    /**< Enviados sem resposta até o fim */
+    double seconds = 0;                         /**< Duração real da medição */
+    std::vector<uint32_t> latencyMicros;        /**< Round-trip de cada resposta medida (ordenado) */
+
+    /** @brief Respostas por segundo sustentadas pelo servidor */
+    double packetsPerSecond() const { return seconds > 0 ? (acked + errors) / seconds : 0; }
+
+    /** @brief Percentil (0..100) da latência, em microssegundos */
+    uint32_t percentile(double p) const;
+};
+
+/**
+ * @brief Gerador de carga do protocolo Aether
+ *
+ * Simula N devices: cada um abre uma conexão TCP, faz o HELLO com o
+ * próprio deviceExternalId, espera o ACK e passa a enviar frames
+ * DATA_PUSH de sensor ao módulo Poseidon na taxa configurada.
+ *
+ * A latência é o tempo entre o envio de um DATA_PUSH e a resposta
+ * correspondente (sem request id o servidor responde na ordem em que
+ * recebe, então a N-ésima resposta é do N-ésimo envio; com --ids a
+ * resposta é casada pelo request id). Com --rate, o tempo conta a
+ * partir do horário em que o envio estava agendado, não de quando ele
+ * de fato saiu: se o servidor atrasa e o device fica esperando a janela
+ * liberar, esse atraso aparece na latência (sem coordinated omission).
+ *
+ * Feito para rodar contra um aetherd local com PostgreSQL local: os
+ * devices e o sensor precisam existir no banco do Poseidon, senão o
+ * INSERT falha e as respostas contam como erro.
+ */
+class Loadgen
+{
+public:
+    explicit Loadgen(LoadgenConfig config);
+
+    /**
+     * @brief Executa aquecimento + medição e devolve o resultado
+     */
+    LoadgenReport run();
+
+    /**
+     * @brief Imprime o resultado (texto, e JSON se config.json)
+     */
+    void print(const LoadgenReport& report) const;
+
+private:
+    /** @brief Resultado de um device, juntado no LoadgenReport ao final */
+    struct DeviceResult
+    {
+        bool connected = false;
+        uint64_t sent = 0;
+        uint64_t acked = 0;
+        uint64_t errors = 0;
+        uint64_t unanswered = 0;
+        std::vector<uint32_t> latencyMicros;
+    };
+
+    /**
+     * @brief Loop de um device: conecta, HELLO, DATA_PUSH até o fim
+     * @param index Índice do device (compõe o deviceExternalId)
+     * @param measureStart Início da medição (fim do aquecimento)
+     * @param end Fim da rodada
+     * @param result Onde gravar o resultado
+     */
+    void runDevice(unsigned index,
+                   std::chrono::steady_clock::time_point measureStart,
+                   std::chrono::steady_clock::time_point end,
+                   DeviceResult& result);
+
+    /** @brief Pacote DATA_PUSH com o JSON de sensor (com padding até payloadSize), ou DATA_PUSH_BINARY/BATCH com --binary */
+    ProtocolAether::Packet buildDataPush(unsigned index, uint64_t sequence) const;
+
+    LoadgenConfig m_config;
+    std::atomic<uint64_t> m_responses{0};   /**< Respostas recebidas (todas), para o progresso a cada segundo */
+};
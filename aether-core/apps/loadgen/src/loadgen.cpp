@@ -0,0 +1,444 @@
+#include "../include/loadgen.hpp"
+
+#include "../../../protocols/aether/include/PacketBuilder.hpp"
+#include "../../../protocols/aether/include/CommandType.hpp"
+#include "../../../protocols/aether/include/SensorCodec.hpp"
+#include "../../../protocols/aether/common/ModuleId.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr auto DRAIN_GRACE = std::chrono::seconds(2);               /// Espera pelas respostas pendentes após o fim
+
+    /**
+     * Abre a conexão TCP com o aetherd (TCP_NODELAY: frames pequenos não
+     * podem esperar o Nagle, senão a latência medida é a do Nagle)
+     * @return fd, ou -1 em caso de erro
+     */
+    int connectTo(const std::string& host, uint16_t port)
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo* result = nullptr;
+        if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || !result)
+            return -1;
+
+        int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        if (fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) != 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(result);
+
+        if (fd >= 0)
+        {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        return fd;
+    }
+
+    bool writeAll(int fd, const std::vector<uint8_t>& bytes)
+    {
+        std::size_t offset = 0;
+        while (offset < bytes.size())
+        {
+            const ssize_t written = send(fd, bytes.data() + offset, bytes.size() - offset, MSG_NOSIGNAL);
+            if (written <= 0)
+            {
+                if (written < 0 && errno == EINTR)
+                    continue;
+                return false;
+            }
+            offset += static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    /**
+     * Retira o próximo frame completo do buffer
+     * @param payload Recebe o payload (como veio no fio), se não for nullptr
+     * @param requestId Recebe o request id do frame (0 se não tiver), se não for nullptr
+     * @return tipo do comando, ou -1 se ainda não há frame completo
+     */
+    int takeFrame(std::vector<uint8_t>& buffer, std::vector<uint8_t>* payload = nullptr, uint32_t* requestId = nullptr)
+    {
+        using ProtocolAether::PacketBuilder;
+
+        if (buffer.size() < PacketBuilder::HEADER_SIZE)
+            return -1;
+
+        /// v2: um byte de flags depois da versão (ver Packet.hpp)
+        const std::size_t headerSize = PacketBuilder::headerSize(buffer[2]);
+        if (buffer.size() < headerSize)
+            return -1;
+
+        const std::size_t at = headerSize - 8;
+        const uint32_t length = (static_cast<uint32_t>(buffer[at + 4]) << 24) |
+                                (static_cast<uint32_t>(buffer[at + 5]) << 16) |
+                                (static_cast<uint32_t>(buffer[at + 6]) << 8) |
+                                static_cast<uint32_t>(buffer[at + 7]);
+
+        /// Request id e trailer CRC32C não entram no length (o servidor já valida o que recebe; aqui só pula)
+        const uint8_t flags = headerSize == PacketBuilder::HEADER_SIZE_V2 ? buffer[3] : 0;
+        const bool crc = flags & PacketBuilder::FLAG_CRC;
+        const bool hasId = flags & PacketBuilder::FLAG_REQUEST_ID;
+        const std::size_t payloadStart = headerSize + (hasId ? PacketBuilder::REQUEST_ID_SIZE : 0);
+        const std::size_t frameSize = payloadStart + length + (crc ? PacketBuilder::CRC_SIZE : 0);
+        if (buffer.size() < frameSize)
+            return -1;
+
+        const int type = (buffer[at] << 8) | buffer[at + 1];
+        if (requestId)
+            *requestId = hasId ? (static_cast<uint32_t>(buffer[headerSize]) << 24) |
+                                 (static_cast<uint32_t>(buffer[headerSize + 1]) << 16) |
+                                 (static_cast<uint32_t>(buffer[headerSize + 2]) << 8) |
+                                 static_cast<uint32_t>(buffer[headerSize + 3])
+                               : 0;
+        if (payload)
+            payload->assign(buffer.begin() + payloadStart, buffer.begin() + payloadStart + length);
+        buffer.erase(buffer.begin(), buffer.begin() + frameSize);
+        return type;
+    }
+
+    /** Lê o que estiver disponível no socket; false se a conexão caiu */
+    bool readAvailable(int fd, std::vector<uint8_t>& buffer)
+    {
+        uint8_t chunk[16 * 1024];
+        const ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+            return received < 0 && errno == EINTR;
+
+        buffer.insert(buffer.end(), chunk, chunk + received);
+        return true;
+    }
+}
+
+uint32_t LoadgenReport::percentile(double p) const
+{
+    if (latencyMicros.empty())
+        return 0;
+
+    const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(latencyMicros.size())));
+    return latencyMicros[std::clamp<std::size_t>(rank, 1, latencyMicros.size()) - 1];
+}
+
+Loadgen::Loadgen(LoadgenConfig config) : m_config(std::move(config)) {}
+
+ProtocolAether::Packet Loadgen::buildDataPush(unsigned index, uint64_t sequence) const
+{
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    const double value = 20.0 + static_cast<double>((sequence + index) % 100) / 10.0;
+
+    if (m_config.binarySensorId != 0)
+    {
+        ProtocolAether::SensorReading reading;
+        reading.sensorId = m_config.binarySensorId;
+        reading.value = value;
+        reading.readTimestamp = static_cast<uint32_t>(timestamp);
+
+        if (m_config.batch > 1)
+        {
+            const std::vector<ProtocolAether::SensorReading> readings(m_config.batch, reading);
+            return ProtocolAether::PacketBuilder::build(
+                CommandType::DATA_PUSH_BATCH, m_config.module,
+                ProtocolAether::SensorCodec::encodeBatch(readings.data(), readings.size()));
+        }
+
+        return ProtocolAether::PacketBuilder::build(
+            CommandType::DATA_PUSH_BINARY, m_config.module, ProtocolAether::SensorCodec::encode(reading));
+    }
+
+    char event[256];
+    std::snprintf(event, sizeof(event),
+                  R"({"event":{"type":"sensor","sensor_type":"temperature","sensor_external_id":"%s","value":%.1f,"read_timestamp":%lld})",
+                  m_config.sensorId.c_str(),
+                  value,
+                  static_cast<long long>(timestamp));
+
+    std::string json = event;
+
+    // Padding num campo que o Poseidon ignora, até o tamanho pedido
+    constexpr std::size_t PAD_OVERHEAD = sizeof(R"(,"pad":"")") - 1 + 1;   // + '}' final
+    if (m_config.payloadSize > json.size() + PAD_OVERHEAD)
+        json += R"(,"pad":")" + std::string(m_config.payloadSize - json.size() - PAD_OVERHEAD, 'x') + "\"";
+    json += "}";
+
+    return ProtocolAether::PacketBuilder::build(
+        CommandType::DATA_PUSH, m_config.module, std::vector<uint8_t>(json.begin(), json.end()));
+}
+
+void Loadgen::runDevice(unsigned index, Clock::time_point measureStart, Clock::time_point end, DeviceResult& result)
+{
+    const std::string deviceId = m_config.devicePrefix + std::to_string(index);
+
+    const int fd = connectTo(m_config.host, m_config.port);
+    if (fd < 0)
+    {
+        std::cerr << "[" << deviceId << "] falha ao conectar: " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    using ProtocolAether::PacketBuilder;
+    using ProtocolAether::Codec;
+
+    /// HELLO: com --compress/--crc/--ids vai em v2 ([codecs aceitos][deviceId]); o CRC vai na flag do próprio HELLO
+    const bool v2 = m_config.compress || m_config.crc || m_config.requestIds;
+    PacketBuilder::WireFormat format;
+    format.version = v2 ? PacketBuilder::VERSION_2 : PacketBuilder::VERSION;
+    format.crc = m_config.crc;
+
+    std::vector<uint8_t> helloPayload(deviceId.begin(), deviceId.end());
+    if (v2)
+        helloPayload.insert(helloPayload.begin(), m_config.compress ? static_cast<uint8_t>(1u << static_cast<uint8_t>(Codec::Deflate)) : 0);
+
+    const auto hello = PacketBuilder::encode(
+        PacketBuilder::build(CommandType::HELLO, static_cast<uint16_t>(ModuleId::CORE), helloPayload), format);
+
+    /// Espera o ACK antes de enviar dados: na v2 ele traz o codec escolhido
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> ackPayload;
+    int helloReply = -1;
+    if (writeAll(fd, hello))
+    {
+        while (helloReply < 0)
+        {
+            pollfd pfd{ fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 5000) <= 0 || !readAvailable(fd, buffer))
+                break;
+            helloReply = takeFrame(buffer, &ackPayload);
+        }
+    }
+
+    if (helloReply != static_cast<int>(CommandType::ACK))
+    {
+        std::cerr << "[" << deviceId << "] HELLO recusado ou sem resposta" << std::endl;
+        close(fd);
+        return;
+    }
+    result.connected = true;
+
+    format.codec = m_config.compress && ackPayload.size() == 1 ? static_cast<Codec>(ackPayload[0]) : Codec::None;
+    ProtocolAether::CompressionContext compression;
+
+    using Seconds = std::chrono::duration<double>;
+    const auto interval = m_config.rate > 0
+        ? std::chrono::duration_cast<Clock::duration>(Seconds(1.0 / m_config.rate))
+        : Clock::duration::zero();
+
+    /// Espalha o primeiro envio dos devices ao longo de um intervalo
+    auto next = Clock::now() + interval * index / std::max(1u, m_config.devices);
+    /// Envios sem resposta: (request id, horário agendado). Sem --ids as respostas chegam na
+    /// ordem dos envios; com --ids cada resposta é casada pelo id e pode vir fora de ordem
+    std::deque<std::pair<uint32_t, Clock::time_point>> pending;
+    uint64_t sequence = 0;
+    bool alive = true;
+
+    while (alive)
+    {
+        auto now = Clock::now();
+        const bool sending = now < end;
+
+        if (!sending && (pending.empty() || now >= end + DRAIN_GRACE))
+            break;
+
+        if (sending && pending.size() < m_config.window && (interval == Clock::duration::zero() || now >= next))
+        {
+            const auto requestId = static_cast<uint32_t>(sequence);
+            const auto frame = PacketBuilder::encode(buildDataPush(index, sequence++), format, &compression,
+                                                     m_config.requestIds ? std::optional<uint32_t>(requestId) : std::nullopt);
+            if (!writeAll(fd, frame))
+                break;
+
+            const auto stamp = interval == Clock::duration::zero() ? now : next;
+            pending.emplace_back(requestId, stamp);
+            if (stamp >= measureStart)
+                ++result.sent;
+            next += interval;
+            continue;
+        }
+
+        /// Dorme até o próximo envio agendado ou até chegar resposta
+        auto wait = std::chrono::milliseconds(100);
+        timespec timeout{};
+        if (sending && pending.size() < m_config.window && interval != Clock::duration::zero())
+        {
+            const auto remaining = std::max(Clock::duration::zero(), next - now);
+            timeout.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(remaining).count();
+            timeout.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining % std::chrono::seconds(1)).count();
+        }
+        else
+        {
+            timeout.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+        }
+
+        pollfd pfd{ fd, POLLIN, 0 };
+        const int ready = ppoll(&pfd, 1, &timeout, nullptr);
+        if (ready <= 0)
+            continue;
+
+        alive = readAvailable(fd, buffer);
+        now = Clock::now();
+
+        uint32_t requestId = 0;
+        for (int type; (type = takeFrame(buffer, nullptr, &requestId)) >= 0; )
+        {
+            /// HEARTBEAT do servidor (conexão calada): responde para não ser desconectado
+            if (type == static_cast<int>(CommandType::HEARTBEAT))
+            {
+                const auto beat = PacketBuilder::encode(
+                    PacketBuilder::build(CommandType::HEARTBEAT, static_cast<uint16_t>(ModuleId::CORE)), format, &compression);
+                if (!writeAll(fd, beat))
+                    alive = false;
+                continue;
+            }
+
+            auto request = pending.begin();
+            if (m_config.requestIds)
+                request = std::find_if(pending.begin(), pending.end(), [&](const auto& p) { return p.first == requestId; });
+            if (request == pending.end())
+                continue;   // Frame não solicitado (ex: comando do agendador)
+
+            const auto stamp = request->second;
+            pending.erase(request);
+            m_responses.fetch_add(1, std::memory_order_relaxed);
+
+            if (stamp < measureStart)
+                continue;
+
+            if (type == static_cast<int>(CommandType::ACK) || type == static_cast<int>(CommandType::DATA_PUSH_BATCH_ACK))
+                ++result.acked;
+            else
+                ++result.errors;
+
+            result.latencyMicros.push_back(static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - stamp).count()));
+        }
+    }
+
+    for (const auto& [requestId, stamp] : pending)
+        if (stamp >= measureStart)
+            ++result.unanswered;
+
+    close(fd);
+}
+
+LoadgenReport Loadgen::run()
+{
+    const auto start = Clock::now();
+    const auto measureStart = start + m_config.warmup;
+    const auto end = measureStart + m_config.duration;
+
+    std::vector<DeviceResult> results(m_config.devices);
+    std::vector<std::thread> threads;
+    threads.reserve(m_config.devices);
+
+    for (unsigned i = 0; i < m_config.devices; ++i)
+        threads.emplace_back(&Loadgen::runDevice, this, i, measureStart, end, std::ref(results[i]));
+
+    /// Progresso a cada segundo
+    uint64_t lastResponses = 0;
+    for (auto tick = start + std::chrono::seconds(1); tick <= end; tick += std::chrono::seconds(1))
+    {
+        std::this_thread::sleep_until(tick);
+        const auto responses = m_responses.load(std::memory_order_relaxed);
+        std::cerr << "  t=" << std::chrono::duration_cast<std::chrono::seconds>(tick - start).count() << "s "
+                  << (tick <= measureStart ? "(aquecimento) " : "")
+                  << (responses - lastResponses) << " respostas/s" << std::endl;
+        lastResponses = responses;
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    LoadgenReport report;
+    report.seconds = std::chrono::duration<double>(m_config.duration).count();
+
+    for (auto& result : results)
+    {
+        report.connected += result.connected ? 1 : 0;
+        report.sent += result.sent;
+        report.acked += result.acked;
+        report.errors += result.errors;
+        report.unanswered += result.unanswered;
+        report.latencyMicros.insert(report.latencyMicros.end(), result.latencyMicros.begin(), result.latencyMicros.end());
+    }
+
+    std::sort(report.latencyMicros.begin(), report.latencyMicros.end());
+    return report;
+}
+
+void Loadgen::print(const LoadgenReport& report) const
+{
+    char rate[64] = "sem limite de taxa";
+    if (m_config.rate > 0)
+        std::snprintf(rate, sizeof(rate), "%.1f msg/s por device", m_config.rate);
+
+    char payload[64];
+    if (m_config.binarySensorId != 0 && m_config.batch > 1)
+        std::snprintf(payload, sizeof(payload), "lotes de %u leituras (sensor %u)", m_config.batch, m_config.binarySensorId);
+    else if (m_config.binarySensorId != 0)
+        std::snprintf(payload, sizeof(payload), "payload binario (sensor %u)", m_config.binarySensorId);
+    else
+        std::snprintf(payload, sizeof(payload), "payload JSON >= %zu B", m_config.payloadSize);
+
+    /// Extensões da v2 em uso
+    std::string protocol;
+    if (m_config.compress)   protocol += "+deflate";
+    if (m_config.crc)        protocol += "+crc";
+    if (m_config.requestIds) protocol += "+ids";
+    if (!protocol.empty())
+        protocol = " (v2 " + protocol.substr(1) + ")";
+
+    std::printf("aether-loadgen: %u devices (%u conectados), %s, janela %u, %s%s, %llds (+%llds aquecimento)\n",
+                m_config.devices, report.connected, rate,
+                m_config.window, payload, protocol.c_str(),
+                static_cast<long long>(m_config.duration.count()), static_cast<long long>(m_config.warmup.count()));
+    std::printf("  enviados %llu  ack %llu  erros %llu  sem resposta %llu\n",
+                static_cast<unsigned long long>(report.sent), static_cast<unsigned long long>(report.acked),
+                static_cast<unsigned long long>(report.errors), static_cast<unsigned long long>(report.unanswered));
+    std::printf("  throughput %.1f pacotes/s\n", report.packetsPerSecond());
+    if (m_config.batch > 1)
+        std::printf("  leituras %.1f/s\n", report.packetsPerSecond() * m_config.batch);
+    std::printf("  latencia (us)  p50 %u  p90 %u  p99 %u  p99.9 %u  max %u\n",
+                report.percentile(50), report.percentile(90), report.percentile(99), report.percentile(99.9),
+                report.latencyMicros.empty() ? 0 : report.latencyMicros.back());
+
+    if (m_config.json)
+    {
+        std::printf(R"({"devices":%u,"connected":%u,"rate":%.3f,"window":%u,"payload":%zu,"binary":%s,"batch":%u,"compress":%s,"crc":%s,"ids":%s,"seconds":%.3f,)"
+                    R"("sent":%llu,"acked":%llu,"errors":%llu,"unanswered":%llu,"pps":%.3f,)"
+                    R"("p50_us":%u,"p90_us":%u,"p99_us":%u,"p999_us":%u,"max_us":%u})" "\n",
+                    m_config.devices, report.connected, m_config.rate, m_config.window, m_config.payloadSize,
+                    m_config.binarySensorId != 0 ? "true" : "false", m_config.batch,
+                    m_config.compress ? "true" : "false", m_config.crc ? "true" : "false",
+                    m_config.requestIds ? "true" : "false", report.seconds,
+                    static_cast<unsigned long long>(report.sent), static_cast<unsigned long long>(report.acked),
+                    static_cast<unsigned long long>(report.errors), static_cast<unsigned long long>(report.unanswered),
+                    report.packetsPerSecond(),
+                    report.percentile(50), report.percentile(90), report.percentile(99), report.percentile(99.9),
+                    report.latencyMicros.empty() ? 0 : report.latencyMicros.back());
+    }
+}
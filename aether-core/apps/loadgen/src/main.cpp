@@ -0,0 +1,95 @@
+#include "../include/loadgen.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout <<
+            "Uso: aether-loadgen [opcoes]\n"
+            "\n"
+            "Simula devices Aether (HELLO + DATA_PUSH de sensor) contra um aetherd\n"
+            "e mede pacotes/s sustentados e a latencia ate o ACK.\n"
+            "\n"
+            "  --host <ip>            Endereco do aetherd (padrao 127.0.0.1)\n"
+            "  --port <n>             Porta TCP (padrao 9000)\n"
+            "  --devices <n>          Devices simulados, 1 conexao cada (padrao 10)\n"
+            "  --rate <n>             DATA_PUSH/s por device; 0 = sem limite (padrao 10)\n"
+            "  --window <n>           DATA_PUSH sem resposta por device (padrao 1)\n"
+            "  --payload <bytes>      Tamanho minimo do JSON, completado com padding\n"
+            "  --duration <s>         Duracao da medicao (padrao 10)\n"
+            "  --warmup <s>           Aquecimento descartado (padrao 2)\n"
+            "  --device-prefix <str>  deviceExternalId = prefixo + indice (padrao loadgen-)\n"
+            "  --sensor <id>          sensor_external_id (padrao SensorTemp01)\n"
+            "  --binary <id>          Envia DATA_PUSH_BINARY com este sens_sensor.id em vez de JSON\n"
+            "  --batch <n>            Com --binary, envia DATA_PUSH_BATCH com n leituras por frame\n"
+            "  --compress             HELLO v2 com compressao Deflate dos payloads grandes\n"
+            "  --crc                  HELLO v2 com trailer CRC32C em todos os frames\n"
+            "  --ids                  v2 com request id em cada DATA_PUSH (respostas casadas pelo id)\n"
+            "  --module <id>          Modulo de destino (padrao 3, Poseidon)\n"
+            "  --json                 Imprime tambem uma linha JSON com o resultado\n"
+            "  --help                 Mostra esta ajuda\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    LoadgenConfig config;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("faltou o valor de " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h")                { printUsage(); return 0; }
+            else if (arg == "--json")                           config.json = true;
+            else if (arg == "--host")                           config.host = value();
+            else if (arg == "--port")                           config.port = static_cast<uint16_t>(std::stoul(value()));
+            else if (arg == "--devices")                        config.devices = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--rate")                           config.rate = std::stod(value());
+            else if (arg == "--window")                         config.window = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--payload")                        config.payloadSize = std::stoul(value());
+            else if (arg == "--duration")                       config.duration = std::chrono::seconds(std::stol(value()));
+            else if (arg == "--warmup")                         config.warmup = std::chrono::seconds(std::stol(value()));
+            else if (arg == "--device-prefix")                  config.devicePrefix = value();
+            else if (arg == "--sensor")                         config.sensorId = value();
+            else if (arg == "--binary")                         config.binarySensorId = static_cast<uint32_t>(std::stoul(value()));
+            else if (arg == "--batch")                          config.batch = static_cast<unsigned>(std::stoul(value()));
+            else if (arg == "--compress")                       config.compress = true;
+            else if (arg == "--crc")                            config.crc = true;
+            else if (arg == "--ids")                            config.requestIds = true;
+            else if (arg == "--module")                         config.module = static_cast<uint16_t>(std::stoul(value(), nullptr, 0));
+            else
+                throw std::invalid_argument("opcao desconhecida: " + arg);
+        }
+
+        if (config.devices == 0 || config.window == 0 || config.rate < 0 || config.duration.count() <= 0)
+            throw std::invalid_argument("--devices, --window e --duration precisam ser > 0 e --rate >= 0");
+
+        if (config.batch == 0 || config.batch > 1024 || (config.batch > 1 && config.binarySensorId == 0))
+            throw std::invalid_argument("--batch precisa estar entre 1 e 1024 e requer --binary");
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "aether-loadgen: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    Loadgen loadgen(config);
+    const auto report = loadgen.run();
+    loadgen.print(report);
+
+    return report.connected == 0 ? 1 : 0;
+}
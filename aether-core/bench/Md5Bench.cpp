@@ -0,0 +1,305 @@
+#include "Md5.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(AETHER_BENCH_OPENSSL)
+#include <openssl/evp.h>
+#endif
+
+using Aether::Core::Utils::Md5;
+
+namespace
+{
+    /**
+     * Implementação anterior do Md5::hash (cópia da mensagem com padding +
+     * laço único com if/else por rodada + ostringstream), mantida aqui só
+     * como referência de comparação.
+     */
+    namespace Legacy
+    {
+        constexpr std::uint32_t K[64] = {
+            0xd76aa478,0xe8c7b756,0x242070db,0xc1bdceee,0xf57c0faf,0x4787c62a,0xa8304613,0xfd469501,
+            0x698098d8,0x8b44f7af,0xffff5bb1,0x895cd7be,0x6b901122,0xfd987193,0xa679438e,0x49b40821,
+            0xf61e2562,0xc040b340,0x265e5a51,0xe9b6c7aa,0xd62f105d,0x02441453,0xd8a1e681,0xe7d3fbc8,
+            0x21e1cde6,0xc33707d6,0xf4d50d87,0x455a14ed,0xa9e3e905,0xfcefa3f8,0x676f02d9,0x8d2a4c8a,
+            0xfffa3942,0x8771f681,0x6d9d6122,0xfde5380c,0xa4beea44,0x4bdecfa9,0xf6bb4b60,0xbebfbc70,
+            0x289b7ec6,0xeaa127fa,0xd4ef3085,0x04881d05,0xd9d4d039,0xe6db99e5,0x1fa27cf8,0xc4ac5665,
+            0xf4292244,0x432aff97,0xab9423a7,0xfc93a039,0x655b59c3,0x8f0ccc92,0xffeff47d,0x85845dd1,
+            0x6fa87e4f,0xfe2ce6e0,0xa3014314,0x4e0811a1,0xf7537e82,0xbd3af235,0x2ad7d2bb,0xeb86d391
+        };
+
+        constexpr std::uint32_t S[64] = {
+            7,12,17,22, 7,12,17,22, 7,12,17,22, 7,12,17,22,
+            5, 9,14,20, 5, 9,14,20, 5, 9,14,20, 5, 9,14,20,
+            4,11,16,23, 4,11,16,23, 4,11,16,23, 4,11,16,23,
+            6,10,15,21, 6,10,15,21, 6,10,15,21, 6,10,15,21
+        };
+
+        void transform(std::uint32_t state[4], const std::uint8_t block[64])
+        {
+            std::uint32_t m[16];
+            for (int i = 0; i < 16; ++i)
+            {
+                m[i] = static_cast<std::uint32_t>(block[i * 4])
+                     | (static_cast<std::uint32_t>(block[i * 4 + 1]) << 8)
+                     | (static_cast<std::uint32_t>(block[i * 4 + 2]) << 16)
+                     | (static_cast<std::uint32_t>(block[i * 4 + 3]) << 24);
+            }
+
+            std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+
+            for (std::uint32_t i = 0; i < 64; ++i)
+            {
+                std::uint32_t f;
+                std::uint32_t g;
+
+                if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+                else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+                else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+                else             { f = c ^ (b | ~d);       g = (7 * i) % 16; }
+
+                const std::uint32_t temp = d;
+                d = c;
+                c = b;
+                const std::uint32_t x = a + f + K[i] + m[g];
+                b = b + ((x << S[i]) | (x >> (32 - S[i])));
+                a = temp;
+            }
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+        }
+
+        std::string hash(const std::string& input)
+        {
+            std::uint32_t state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+            const std::uint64_t originalLenBits = static_cast<std::uint64_t>(input.size()) * 8;
+
+            std::string message = input;
+            message.push_back(static_cast<char>(0x80));
+            while (message.size() % 64 != 56)
+                message.push_back(static_cast<char>(0x00));
+            for (int i = 0; i < 8; ++i)
+                message.push_back(static_cast<char>((originalLenBits >> (8 * i)) & 0xff));
+
+            for (std::size_t offset = 0; offset < message.size(); offset += 64)
+                transform(state, reinterpret_cast<const std::uint8_t*>(message.data() + offset));
+
+            std::ostringstream oss;
+            for (const std::uint32_t s : state)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    oss << std::hex << std::setw(2) << std::setfill('0')
+                        << ((s >> (8 * i)) & 0xff);
+                }
+            }
+
+            return oss.str();
+        }
+    }
+
+#if defined(AETHER_BENCH_OPENSSL)
+    std::string opensslHash(const std::string& input)
+    {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int size = 0;
+        EVP_Digest(input.data(), input.size(), digest, &size, EVP_md5(), nullptr);
+
+        Md5::Digest out{};
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = digest[i];
+        return Md5::toHex(out);
+    }
+#endif
+
+    /** Entradas do tamanho típico do Digest (HA1, HA2 e response) */
+    std::string digestLikeInput(std::size_t size, std::size_t seed)
+    {
+        std::string input(size, 'a');
+        for (std::size_t i = 0; i < size; ++i)
+            input[i] = static_cast<char>('a' + (i * 7 + seed * 13) % 26);
+        return input;
+    }
+
+    /**
+     * Confere os vetores da RFC 1321 (e entradas que cruzam as bordas de
+     * bloco) em todas as implementações antes de medir qualquer coisa.
+     */
+    void checkVectors()
+    {
+        const std::pair<const char*, const char*> rfc[] = {
+            { "", "d41d8cd98f00b204e9800998ecf8427e" },
+            { "a", "0cc175b9c0f1b6a831c399e269772661" },
+            { "abc", "900150983cd24fb0d6963f7d28e17f72" },
+            { "message digest", "f96b697d7cb7938d525a2f31aaf161d0" },
+            { "abcdefghijklmnopqrstuvwxyz", "c3fcd3d76192e4007dfb496cca67e13b" },
+            { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+              "d174ab98d277d9f5a5611c2c9f419d9f" },
+            { "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+              "57edf4a22be3c955ac49da2e2107b67a" },
+        };
+
+        bool ok = true;
+        auto fail = [&](const char* what, std::size_t size)
+        {
+            std::fprintf(stderr, "Md5Bench: %s divergente (%zu bytes)\n", what, size);
+            ok = false;
+        };
+
+        for (const auto& [input, expected] : rfc)
+        {
+            if (Md5::hash(input) != expected)
+                fail("Md5::hash", std::string_view(input).size());
+            if (Legacy::hash(input) != expected)
+                fail("Legacy::hash", std::string_view(input).size());
+        }
+
+        // Todas as bordas de padding (55/56/63/64/...) pelos três caminhos
+        std::vector<std::string> inputs;
+        for (std::size_t size = 0; size <= 200; ++size)
+            inputs.push_back(digestLikeInput(size, size));
+
+        std::vector<std::string_view> views(inputs.begin(), inputs.end());
+        std::vector<Md5::Digest> many(views.size());
+        Md5::hashMany(views.data(), many.data(), views.size());
+
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            const std::string expected = Legacy::hash(inputs[i]);
+
+            if (Md5::hash(inputs[i]) != expected)
+                fail("Md5::hash", inputs[i].size());
+
+            Md5 split;
+            split.update(std::string_view(inputs[i]).substr(0, i / 3))
+                 .update(std::string_view(inputs[i]).substr(i / 3));
+            if (Md5::toHex(split.finalize()) != expected)
+                fail("Md5::update", inputs[i].size());
+
+            if (Md5::toHex(many[i]) != expected)
+                fail("Md5::hashMany", inputs[i].size());
+
+#if defined(AETHER_BENCH_OPENSSL)
+            if (opensslHash(inputs[i]) != expected)
+                fail("OpenSSL", inputs[i].size());
+#endif
+        }
+
+        if (!ok)
+            std::exit(1);
+    }
+
+    void BM_Md5Legacy(benchmark::State& state)
+    {
+        const std::string input = digestLikeInput(static_cast<std::size_t>(state.range(0)), 1);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Legacy::hash(input));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    void BM_Md5Hash(benchmark::State& state)
+    {
+        const std::string input = digestLikeInput(static_cast<std::size_t>(state.range(0)), 1);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Md5::hash(input));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    /** Caminho do DigestAuth: contexto incremental + hex em buffer da pilha */
+    void BM_Md5Context(benchmark::State& state)
+    {
+        const std::string input = digestLikeInput(static_cast<std::size_t>(state.range(0)), 1);
+        char hex[Md5::HEX_SIZE];
+        for (auto _ : state)
+        {
+            Md5::toHex(Md5().update(input).finalize(), hex);
+            benchmark::DoNotOptimize(hex);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    /** 64 entradas independentes por iteração; compara com 64 Md5::hash */
+    void BM_Md5HashMany(benchmark::State& state)
+    {
+        constexpr std::size_t count = 64;
+        std::vector<std::string> inputs;
+        for (std::size_t i = 0; i < count; ++i)
+            inputs.push_back(digestLikeInput(static_cast<std::size_t>(state.range(0)), i));
+
+        std::vector<std::string_view> views(inputs.begin(), inputs.end());
+        std::vector<Md5::Digest> outputs(count);
+
+        for (auto _ : state)
+        {
+            Md5::hashMany(views.data(), outputs.data(), count);
+            benchmark::DoNotOptimize(outputs.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count) * state.range(0));
+    }
+
+    void BM_Md5HashManyScalar(benchmark::State& state)
+    {
+        constexpr std::size_t count = 64;
+        std::vector<std::string> inputs;
+        for (std::size_t i = 0; i < count; ++i)
+            inputs.push_back(digestLikeInput(static_cast<std::size_t>(state.range(0)), i));
+
+        std::vector<Md5::Digest> outputs(count);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                outputs[i] = Md5().update(inputs[i]).finalize();
+            benchmark::DoNotOptimize(outputs.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count) * state.range(0));
+    }
+
+#if defined(AETHER_BENCH_OPENSSL)
+    void BM_Md5OpenSsl(benchmark::State& state)
+    {
+        const std::string input = digestLikeInput(static_cast<std::size_t>(state.range(0)), 1);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(opensslHash(input));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+#endif
+}
+
+// 32..128 bytes cobre HA1/HA2/response; 4096 mede a vazão do transform
+BENCHMARK(BM_Md5Legacy)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+BENCHMARK(BM_Md5Hash)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+BENCHMARK(BM_Md5Context)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+BENCHMARK(BM_Md5HashMany)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+BENCHMARK(BM_Md5HashManyScalar)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+#if defined(AETHER_BENCH_OPENSSL)
+BENCHMARK(BM_Md5OpenSsl)->Arg(32)->Arg(64)->Arg(128)->Arg(4096);
+#endif
+
+int main(int argc, char** argv)
+{
+    checkVectors();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "transport/rest/RouteRegistry.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace Aether::Api;
+
+namespace
+{
+    /** Tabela com `count` rotas GET no formato das da API (/api/<modulo>/<recurso>) */
+    RouteRegistry makeRegistry(std::size_t count, std::vector<std::string>& paths)
+    {
+        static const char* modules[] = { "core", "horus", "poseidon", "web" };
+
+        RouteRegistry registry;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            paths.push_back(std::string("/api/") + modules[i % 4] + "/resource" + std::to_string(i));
+            registry.get(paths.back(), [](const HttpRequest&) { return HttpResponse{}; });
+            registry.post(paths.back(), [](const HttpRequest&) { return HttpResponse{}; });
+        }
+        return registry;
+    }
+
+    void BM_RouteRegistryFindHit(benchmark::State& state)
+    {
+        std::vector<std::string> paths;
+        auto registry = makeRegistry(static_cast<std::size_t>(state.range(0)), paths);
+
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(registry.find(HttpMethod::GET, paths[i]));
+            i = (i + 1) % paths.size();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** 404: caminho com prefixo comum às rotas, o pior caso da comparação de strings */
+    void BM_RouteRegistryFindMiss(benchmark::State& state)
+    {
+        std::vector<std::string> paths;
+        auto registry = makeRegistry(static_cast<std::size_t>(state.range(0)), paths);
+        const std::string missing = "/api/poseidon/resource-missing";
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(registry.find(HttpMethod::GET, missing));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+}
+
+BENCHMARK(BM_RouteRegistryFindHit)->Arg(8)->Arg(64);
+BENCHMARK(BM_RouteRegistryFindMiss)->Arg(8)->Arg(64);
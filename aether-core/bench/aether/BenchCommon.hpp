@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../protocols/aether/common/IResponseChannel.hpp"
+#include "../../protocols/aether/common/IProtocolHandler.hpp"
+#include "../../protocols/aether/include/Packet.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Peças comuns aos benchmarks do aether_bench
+ */
+namespace AetherBench
+{
+    /**
+     * @brief Canal que só conta as respostas (o custo do socket fica de fora)
+     */
+    class NullChannel : public IResponseChannel
+    {
+    public:
+        explicit NullChannel(uint64_t id) : m_id(id) {}
+
+        void sendResponse(const ProtocolAether::Packet& pkt) override { m_bytes += pkt.payload.size(); ++m_responses; }
+        uint64_t id() const override { return m_id; }
+
+        uint64_t responses() const { return m_responses; }
+
+    private:
+        uint64_t m_id;
+        uint64_t m_responses = 0;
+        uint64_t m_bytes = 0;
+    };
+
+    /**
+     * @brief Handler que só conta os pacotes entregues pelo Parser
+     */
+    class CountingHandler : public IProtocolHandler
+    {
+    public:
+        uint8_t moduleId() const override { return 0; }
+        void onPacket(const ProtocolAether::Packet& packet, std::shared_ptr<IResponseChannel>) override
+        {
+            ++packets;
+            bytes += packet.payload.size();
+        }
+
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+    };
+
+    /** @brief Payload de DATA_PUSH de sensor como o que os ESP32 enviam ao Poseidon */
+    std::string sensorJson(std::size_t minSize = 0);
+
+    /** @brief Frame DATA_PUSH (Poseidon) já serializado, com payload de tamanho >= payloadSize */
+    std::vector<uint8_t> dataPushFrame(std::size_t payloadSize);
+
+    /** @brief Frame HELLO serializado com o deviceExternalId */
+    std::vector<uint8_t> helloFrame(const std::string& deviceId);
+}
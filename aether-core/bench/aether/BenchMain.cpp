@@ -0,0 +1,63 @@
+#include "BenchCommon.hpp"
+
+#include "../../protocols/aether/include/PacketBuilder.hpp"
+#include "../../protocols/aether/include/CommandType.hpp"
+#include "../../protocols/aether/common/ModuleId.hpp"
+#include "../../core/utils/logger.hpp"
+
+#include <benchmark/benchmark.h>
+
+#ifndef AETHER_BENCH_GIT_COMMIT
+#define AETHER_BENCH_GIT_COMMIT "unknown"
+#endif
+
+namespace AetherBench
+{
+    std::string sensorJson(std::size_t minSize)
+    {
+        std::string json = R"({"event":{"type":"sensor","sensor_type":"temperature","sensor_external_id":"SensorTemp01","value":23.5,"read_timestamp":1700000000})";
+
+        // Padding num campo que o Poseidon ignora
+        if (minSize > json.size() + 10)
+            json += R"(,"pad":")" + std::string(minSize - json.size() - 10, 'x') + "\"";
+        return json + "}";
+    }
+
+    std::vector<uint8_t> dataPushFrame(std::size_t payloadSize)
+    {
+        const auto json = sensorJson(payloadSize);
+        return ProtocolAether::PacketBuilder::encode(ProtocolAether::PacketBuilder::build(
+            CommandType::DATA_PUSH,
+            static_cast<uint16_t>(ModuleId::MODULE_POSEIDON),
+            std::vector<uint8_t>(json.begin(), json.end())));
+    }
+
+    std::vector<uint8_t> helloFrame(const std::string& deviceId)
+    {
+        return ProtocolAether::PacketBuilder::encode(ProtocolAether::PacketBuilder::build(
+            CommandType::HELLO,
+            static_cast<uint16_t>(ModuleId::CORE),
+            std::vector<uint8_t>(deviceId.begin(), deviceId.end())));
+    }
+}
+
+/**
+ * Os caminhos medidos logam (ex: "Handshake OK"); só erros passam, para
+ * o custo do log não entrar na medição nem poluir a saída.
+ *
+ * O commit entra no contexto do JSON (--benchmark_out), para comparar
+ * resultados entre commits.
+ */
+int main(int argc, char** argv)
+{
+    AetherCoreLogger::setMinLevel(AetherCoreLogger::Level::Error);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::AddCustomContext("aether_git_commit", AETHER_BENCH_GIT_COMMIT);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "BenchCommon.hpp"
+
+#include "../../core/eventbus/include/IModule.hpp"
+#include "../../core/network/ProtocolRouter.hpp"
+#include "../../core/network/session/ConnSession.hpp"
+#include "../../core/network/SessionManager.hpp"
+#include "../../core/utils/Md5.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace AetherBench;
+
+namespace
+{
+    /**
+     * Handshake completo: HELLO -> validação -> registro no SessionManager
+     * -> ACK -> destrutor desregistra. É o custo fixo de cada conexão.
+     */
+    void BM_ConnSessionHandshake(benchmark::State& state)
+    {
+        const auto hello = helloFrame("ESP32-BENCH-0001");
+        auto channel = std::make_shared<NullChannel>(1);
+
+        std::vector<uint8_t> bytes;
+        for (auto _ : state)
+        {
+            ConnSession session(channel);
+            bytes.assign(hello.begin(), hello.end());
+            session.feed(bytes);
+            benchmark::DoNotOptimize(session.getState());
+        }
+
+        if (channel->responses() != static_cast<uint64_t>(state.iterations()))
+            state.SkipWithError("Handshake sem ACK");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Mesmo handshake com o HELLO chegando em dois pedaços (cabeçalho e payload) */
+    void BM_ConnSessionHandshakeSplit(benchmark::State& state)
+    {
+        const auto hello = helloFrame("ESP32-BENCH-0001");
+        auto channel = std::make_shared<NullChannel>(1);
+
+        std::vector<uint8_t> bytes;
+        for (auto _ : state)
+        {
+            ConnSession session(channel);
+            bytes.assign(hello.begin(), hello.begin() + 11);
+            session.feed(bytes);
+            bytes.assign(hello.begin() + 11, hello.end());
+            session.feed(bytes);
+            benchmark::DoNotOptimize(session.getState());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /**
+     * Deixa exatamente `count` canais registrados no SessionManager (um por
+     * device conectado), reaproveitando os do benchmark anterior.
+     */
+    std::vector<std::shared_ptr<NullChannel>>& registeredChannels(std::size_t count)
+    {
+        static std::vector<std::shared_ptr<NullChannel>> channels;
+        while (channels.size() > count)
+        {
+            SessionManager::instance().unregisterChannel(channels.back());
+            channels.pop_back();
+        }
+        while (channels.size() < count)
+        {
+            auto channel = std::make_shared<NullChannel>(static_cast<uint16_t>(1000 + channels.size()));
+            SessionManager::instance().registerChannel(channel, "DEV-" + std::to_string(channels.size()));
+            channels.push_back(std::move(channel));
+        }
+        return channels;
+    }
+
+    /** Lookup do Poseidon por pacote: canal -> deviceExternalId */
+    void BM_SessionManagerDeviceLookup(benchmark::State& state)
+    {
+        auto& channels = registeredChannels(static_cast<std::size_t>(state.range(0)));
+        std::shared_ptr<IResponseChannel> channel = channels[channels.size() / 2];
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(SessionManager::instance().getDeviceExternalId(channel));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Lookup do envio reverso (agendador): deviceExternalId -> canal, varre o mapa */
+    void BM_SessionManagerChannelLookup(benchmark::State& state)
+    {
+        auto& channels = registeredChannels(static_cast<std::size_t>(state.range(0)));
+        const std::string deviceId = "DEV-" + std::to_string(channels.size() / 2);
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(SessionManager::instance().getChannelByDeviceExternalId(deviceId));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Módulo que só conta os pacotes que o executor entrega */
+    class NullModule : public IModule, public IProtocolHandler
+    {
+    public:
+        explicit NullModule(uint8_t id) : m_id(id) {}
+
+        void onEvent(const Event&) override {}
+        std::string name() const override { return "bench-" + std::to_string(m_id); }
+        bool isRunning() override { return true; }
+
+        uint8_t moduleId() const override { return m_id; }
+        DispatchLimits dispatchLimits() const override { return { 1, std::size_t{1} << 20 }; }
+        void onPacket(const ProtocolAether::Packet&, std::shared_ptr<IResponseChannel>) override { ++packets; }
+
+        std::atomic<uint64_t> packets{0};
+
+    private:
+        uint8_t m_id;
+    };
+
+    /**
+     * Custo do ProtocolRouter na thread de leitura (busca na tabela, cópia
+     * do pacote, enfileiramento no executor) com `range(0)` módulos
+     * registrados: a busca não depende da quantidade de módulos.
+     */
+    void BM_RouterDispatch(benchmark::State& state)
+    {
+        ProtocolRouter router;
+        std::shared_ptr<NullModule> target;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            auto module = std::make_shared<NullModule>(static_cast<uint8_t>(i + 1));
+            router.registerModule(module, module);
+            target = module;
+        }
+
+        ProtocolAether::Packet packet;
+        packet.module = target->moduleId();
+        packet.type = static_cast<uint16_t>(CommandType::DATA_PUSH_BINARY);
+        packet.payload.assign(16, 0x5A);
+        auto channel = std::make_shared<NullChannel>(1);
+
+        for (auto _ : state)
+            router.onPacket(packet, channel);
+
+        if (channel->responses() != 0)
+            state.SkipWithError("Router recusou pacotes");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Md5::hash no tamanho das entradas do Digest (a comparação completa fica no aether_md5_bench) */
+    void BM_Md5Hash(benchmark::State& state)
+    {
+        const std::string input(static_cast<std::size_t>(state.range(0)), 'a');
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Aether::Core::Utils::Md5::hash(input));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+}
+
+BENCHMARK(BM_ConnSessionHandshake);
+BENCHMARK(BM_ConnSessionHandshakeSplit);
+BENCHMARK(BM_SessionManagerDeviceLookup)->Arg(16)->Arg(1024);
+BENCHMARK(BM_SessionManagerChannelLookup)->Arg(16)->Arg(1024);
+BENCHMARK(BM_RouterDispatch)->Arg(1)->Arg(64);
+BENCHMARK(BM_Md5Hash)->Arg(32)->Arg(64)->Arg(128);
@@ -0,0 +1,98 @@
+#include "BenchCommon.hpp"
+
+#include "PoseidonService.hpp"
+#include "../../protocols/aether/include/PacketBuilder.hpp"
+#include "../../protocols/aether/include/CommandType.hpp"
+#include "../../protocols/aether/include/SensorCodec.hpp"
+#include "../../protocols/aether/common/ModuleId.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace AetherBench;
+
+namespace
+{
+    ProtocolAether::Packet dataPushPacket(const std::string& json)
+    {
+        return ProtocolAether::PacketBuilder::build(
+            CommandType::DATA_PUSH,
+            static_cast<uint16_t>(ModuleId::MODULE_POSEIDON),
+            std::vector<uint8_t>(json.begin(), json.end()));
+    }
+
+    /** Só o json::parse do payload, como feito no início do processJsonPacketDataPush */
+    void BM_PoseidonJsonParse(benchmark::State& state)
+    {
+        const auto packet = dataPushPacket(sensorJson(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _ : state)
+        {
+            auto j = nlohmann::json::parse(packet.payload);
+            benchmark::DoNotOptimize(j);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * packet.payload.size()));
+    }
+
+    /** Extração SAX do evento (PoseidonEventParser), usada no lugar do DOM acima */
+    void BM_PoseidonEventParse(benchmark::State& state)
+    {
+        const auto packet = dataPushPacket(sensorJson(static_cast<std::size_t>(state.range(0))));
+
+        for (auto _ : state)
+        {
+            PoseidonEvent event;
+            auto valid = PoseidonEventParser::parse(packet.payload.data(), packet.payload.size(), event);
+            benchmark::DoNotOptimize(valid);
+            benchmark::DoNotOptimize(event);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * packet.payload.size()));
+    }
+
+    /**
+     * processJsonPacketDataPush inteiro até a porta do banco: parse e checagem
+     * do evento e do sensor. Sem o read_timestamp ele recusa antes de usar o
+     * ConnectionPool, então nenhum PostgreSQL é necessário.
+     */
+    void BM_PoseidonDataPushValidate(benchmark::State& state)
+    {
+        const auto packet = dataPushPacket(
+            R"({"event":{"type":"sensor","sensor_type":"temperature","sensor_external_id":"SensorTemp01","value":23.5}})");
+
+        for (auto _ : state)
+        {
+            auto result = PoseidonService::processJsonPacketDataPush(packet, "ESP32-BENCH-0001");
+            benchmark::DoNotOptimize(result);
+        }
+
+        if (PoseidonService::processJsonPacketDataPush(packet, "ESP32-BENCH-0001").first)
+            state.SkipWithError("Validação deveria recusar antes do banco");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Decode do payload DATA_PUSH_BINARY (a alternativa ao json::parse acima) */
+    void BM_SensorCodecDecode(benchmark::State& state)
+    {
+        ProtocolAether::SensorReading reading;
+        reading.sensorId = static_cast<uint32_t>(state.range(0));
+        reading.value = 23.5;
+        reading.readTimestamp = 1700000000;
+        const auto payload = ProtocolAether::SensorCodec::encode(reading);
+
+        for (auto _ : state)
+        {
+            ProtocolAether::SensorReading out;
+            auto status = ProtocolAether::SensorCodec::decode(payload.data(), payload.size(), out);
+            benchmark::DoNotOptimize(status);
+            benchmark::DoNotOptimize(out);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+    }
+}
+
+BENCHMARK(BM_PoseidonJsonParse)->Arg(0)->Arg(512)->Arg(4096);
+BENCHMARK(BM_PoseidonEventParse)->Arg(0)->Arg(512)->Arg(4096);
+BENCHMARK(BM_PoseidonDataPushValidate);
+BENCHMARK(BM_SensorCodecDecode)->Arg(7)->Arg(UINT32_MAX);
@@ -0,0 +1,220 @@
+#include "BenchCommon.hpp"
+
+#include "../../protocols/aether/include/Parser.hpp"
+#include "../../protocols/aether/include/PacketBuilder.hpp"
+#include "../../protocols/aether/include/CommandType.hpp"
+#include "../../protocols/aether/common/ModuleId.hpp"
+#include "../../core/utils/Crc32c.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace AetherBench;
+
+namespace
+{
+    /** Um frame por feed(), o caso comum de um device enviando devagar */
+    void BM_ParserFeedSingle(benchmark::State& state)
+    {
+        const auto frame = dataPushFrame(static_cast<std::size_t>(state.range(0)));
+        auto channel = std::make_shared<NullChannel>(1);
+        CountingHandler handler;
+        ProtocolAether::Parser parser;
+        parser.setHandler(&handler);
+
+        std::vector<uint8_t> buffer;
+        for (auto _ : state)
+        {
+            buffer.assign(frame.begin(), frame.end());
+            parser.feed(buffer, channel);
+        }
+
+        if (handler.packets != static_cast<uint64_t>(state.iterations()))
+            state.SkipWithError("Parser perdeu pacotes");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+    }
+
+    /** Vários frames numa leitura só (device com fila acumulada / loadgen com janela) */
+    void BM_ParserFeedBurst(benchmark::State& state)
+    {
+        const auto frame = dataPushFrame(128);
+        const auto frames = static_cast<std::size_t>(state.range(0));
+
+        std::vector<uint8_t> burst;
+        burst.reserve(frame.size() * frames);
+        for (std::size_t i = 0; i < frames; ++i)
+            burst.insert(burst.end(), frame.begin(), frame.end());
+
+        auto channel = std::make_shared<NullChannel>(1);
+        CountingHandler handler;
+        ProtocolAether::Parser parser;
+        parser.setHandler(&handler);
+
+        std::vector<uint8_t> buffer;
+        for (auto _ : state)
+        {
+            buffer.assign(burst.begin(), burst.end());
+            parser.feed(buffer, channel);
+        }
+
+        if (handler.packets != static_cast<uint64_t>(state.iterations()) * frames)
+            state.SkipWithError("Parser perdeu pacotes");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * frames));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * burst.size()));
+    }
+
+    /** Um byte por feed(): pior caso de fragmentação TCP (reparse do cabeçalho a cada byte) */
+    void BM_ParserFeedDribble(benchmark::State& state)
+    {
+        const auto frame = dataPushFrame(static_cast<std::size_t>(state.range(0)));
+        auto channel = std::make_shared<NullChannel>(1);
+        CountingHandler handler;
+        ProtocolAether::Parser parser;
+        parser.setHandler(&handler);
+
+        std::vector<uint8_t> buffer;
+        for (auto _ : state)
+        {
+            for (const uint8_t byte : frame)
+            {
+                buffer.push_back(byte);
+                parser.feed(buffer, channel);
+            }
+        }
+
+        if (handler.packets != static_cast<uint64_t>(state.iterations()))
+            state.SkipWithError("Parser perdeu pacotes");
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+    }
+
+    /** Caminho de resposta: build + encode de um ACK sem payload */
+    void BM_PacketBuildEncodeAck(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            auto bytes = ProtocolAether::PacketBuilder::encode(ProtocolAether::PacketBuilder::build(
+                CommandType::ACK, static_cast<uint16_t>(ModuleId::MODULE_POSEIDON)));
+            benchmark::DoNotOptimize(bytes.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /** Caminho de envio reverso / ERROR com texto: payload copiado para o Packet e para os bytes */
+    void BM_PacketBuildEncodePayload(benchmark::State& state)
+    {
+        const auto json = sensorJson(static_cast<std::size_t>(state.range(0)));
+        const std::vector<uint8_t> payload(json.begin(), json.end());
+
+        for (auto _ : state)
+        {
+            auto bytes = ProtocolAether::PacketBuilder::encode(ProtocolAether::PacketBuilder::build(
+                CommandType::DATA_PUSH, static_cast<uint16_t>(ModuleId::MODULE_POSEIDON), payload));
+            benchmark::DoNotOptimize(bytes.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+    }
+
+    /** Envio v2 com Deflate: compressão do payload (JSON com padding) + encode */
+    void BM_PacketEncodeDeflate(benchmark::State& state)
+    {
+        const auto json = sensorJson(static_cast<std::size_t>(state.range(0)));
+        const auto pkt = ProtocolAether::PacketBuilder::build(
+            CommandType::DATA_PUSH, static_cast<uint16_t>(ModuleId::MODULE_POSEIDON),
+            std::vector<uint8_t>(json.begin(), json.end()));
+        ProtocolAether::CompressionContext compression;
+        ProtocolAether::PacketBuilder::WireFormat format;
+        format.version = ProtocolAether::PacketBuilder::VERSION_2;
+        format.codec = ProtocolAether::Codec::Deflate;
+
+        std::size_t wire = 0;
+        for (auto _ : state)
+        {
+            auto bytes = ProtocolAether::PacketBuilder::encode(pkt, format, &compression);
+            wire = bytes.size();
+            benchmark::DoNotOptimize(bytes.data());
+        }
+        state.counters["wire_bytes"] = static_cast<double>(wire);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pkt.payload.size()));
+    }
+
+    /** Recebimento v2 com Deflate: parse + descompressão de um frame por feed() */
+    void BM_ParserFeedDeflate(benchmark::State& state)
+    {
+        const auto json = sensorJson(static_cast<std::size_t>(state.range(0)));
+        ProtocolAether::CompressionContext compression;
+        ProtocolAether::PacketBuilder::WireFormat format;
+        format.version = ProtocolAether::PacketBuilder::VERSION_2;
+        format.codec = ProtocolAether::Codec::Deflate;
+        const auto frame = ProtocolAether::PacketBuilder::encode(
+            ProtocolAether::PacketBuilder::build(CommandType::DATA_PUSH, static_cast<uint16_t>(ModuleId::MODULE_POSEIDON),
+                                                 std::vector<uint8_t>(json.begin(), json.end())),
+            format, &compression);
+
+        auto channel = std::make_shared<NullChannel>(1);
+        CountingHandler handler;
+        ProtocolAether::Parser parser;
+        parser.setHandler(&handler);
+
+        std::vector<uint8_t> buffer;
+        for (auto _ : state)
+        {
+            buffer.assign(frame.begin(), frame.end());
+            parser.feed(buffer, channel);
+        }
+
+        if (handler.packets != static_cast<uint64_t>(state.iterations()))
+            state.SkipWithError("Parser perdeu pacotes");
+        state.counters["wire_bytes"] = static_cast<double>(frame.size());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+    }
+
+    /** Stream corrompido: N bytes de lixo (com 0xAA soltos) antes de um frame válido */
+    void BM_ParserResync(benchmark::State& state)
+    {
+        std::vector<uint8_t> stream(static_cast<std::size_t>(state.range(0)), 0x11);
+        for (std::size_t i = 0; i < stream.size(); i += 7)
+            stream[i] = 0xAA;
+        const auto frame = dataPushFrame(0);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+        auto channel = std::make_shared<NullChannel>(1);
+        CountingHandler handler;
+        ProtocolAether::Parser parser;
+        parser.setHandler(&handler);
+
+        std::vector<uint8_t> buffer;
+        for (auto _ : state)
+        {
+            buffer.assign(stream.begin(), stream.end());
+            parser.feed(buffer, channel);
+        }
+
+        if (handler.packets != static_cast<uint64_t>(state.iterations()))
+            state.SkipWithError("Parser perdeu o frame depois do lixo");
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    }
+
+    /** CRC32C do trailer v2 (instrução da CPU quando houver) */
+    void BM_Crc32c(benchmark::State& state)
+    {
+        const std::vector<uint8_t> data(static_cast<std::size_t>(state.range(0)), 0x5A);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Aether::Core::Utils::Crc32c::compute(data.data(), data.size()));
+
+        state.SetLabel(Aether::Core::Utils::Crc32c::hardware() ? "hardware" : "tabela");
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    }
+}
+
+// 0 = JSON de sensor sem padding (~130 bytes)
+BENCHMARK(BM_ParserFeedSingle)->Arg(0)->Arg(512)->Arg(4096);
+BENCHMARK(BM_ParserFeedBurst)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_ParserFeedDribble)->Arg(0)->Arg(512);
+BENCHMARK(BM_PacketBuildEncodeAck);
+BENCHMARK(BM_PacketBuildEncodePayload)->Arg(0)->Arg(512)->Arg(4096);
+BENCHMARK(BM_PacketEncodeDeflate)->Arg(512)->Arg(4096);
+BENCHMARK(BM_ParserFeedDeflate)->Arg(512)->Arg(4096);
+BENCHMARK(BM_ParserResync)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_Crc32c)->Arg(64)->Arg(4096);
@@ -6,6 +6,8 @@
 
 #include "ConnectionHandle.hpp"
 #include "PostgresDriver.hpp"
+#include "../../utils/Metrics.hpp"
+#include "../../utils/Tracing.hpp"
 
 /**
  * @brief Classe que gerencia um pool de conexões PostgresDriver.
@@ -48,12 +50,20 @@ public:
      */
     ConnectionHandle acquire()
     {
+        static auto& waitTime = Aether::Core::Utils::Metrics::histogram(
+            "aether_db_pool_wait_seconds", "Tempo de espera por uma conexao livre no ConnectionPool");
+
+        Aether::Core::Utils::Span span("db.pool_acquire");
         std::unique_lock<std::mutex> lock(mutex);
 
-        cv.wait(lock, [&] { return !freeConnections.empty(); }); // Aguarda até que haja conexões disponíveis
+        {
+            Aether::Core::Utils::ScopedTimer timer(waitTime);
+            cv.wait(lock, [&] { return !freeConnections.empty(); }); // Aguarda até que haja conexões disponíveis
+        }
 
         PostgresDriver* conn = freeConnections.front();         // Obtém a conexão do topo da fila
         freeConnections.pop();                                  // Remove da fila
+        inUseGauge().add();
 
         return ConnectionHandle(conn, [&](PostgresDriver* c)
         {
@@ -71,9 +81,20 @@ private:
     {
         std::unique_lock<std::mutex> lock(mutex);
         freeConnections.push(conn);  // Adiciona a conexão de volta à fila
+        inUseGauge().sub();
         cv.notify_one();             // Notifica uma thread aguardando por uma conexão
     }
 
+    /**
+     * @brief Conexões emprestadas, somando todos os pools do processo
+     */
+    static Aether::Core::Utils::Gauge& inUseGauge()
+    {
+        static auto& gauge = Aether::Core::Utils::Metrics::gauge(
+            "aether_db_pool_connections_in_use", "Conexoes emprestadas pelos ConnectionPools");
+        return gauge;
+    }
+
     std::string connectionString;                /// String de conexão com o banco de dados
     std::queue<PostgresDriver*> freeConnections; /// Fila de conexões livres
 
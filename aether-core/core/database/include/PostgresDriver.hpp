@@ -75,19 +75,7 @@ public:
      * @param paramValues Array de strings contendo os valores dos parâmetros.
      * @return Ponteiro para PGresult contendo o resultado da query,
      */
-    PGresult* queryParams(const std::string& sql, int nParams, const char* const* paramValues) const
-    {
-        return PQexecParams(
-            m_conn,
-            sql.c_str(),
-            nParams,
-            nullptr,
-            paramValues,
-            nullptr,
-            nullptr,
-            0
-        );
-    }
+    PGresult* queryParams(const std::string& sql, int nParams, const char* const* paramValues) const;
 
 private:
     /**
@@ -1,6 +1,18 @@
 #include "../include/PostgresDriver.hpp"
+#include "../../utils/logger.hpp"
+#include "../../utils/Metrics.hpp"
+#include "../../utils/Tracing.hpp"
 
-#include <iostream>
+namespace
+{
+    /** Latência de PQexec/PQexecParams (métrica aether_db_query_seconds) */
+    Aether::Core::Utils::Histogram& queryLatency()
+    {
+        static auto& histogram = Aether::Core::Utils::Metrics::histogram(
+            "aether_db_query_seconds", "Latencia das queries no PostgreSQL");
+        return histogram;
+    }
+}
 
 /**
  * @brief Construtor do PostgresDriver.
@@ -35,7 +47,8 @@ bool PostgresDriver::connect()
     //Verifica se a conexão foi bem sucedida
     if (PQstatus(m_conn) != CONNECTION_OK)
     {
-        std::cerr << " [Core Database] Falha ao se conectar ao banco de dados! " << PQerrorMessage(m_conn) << std::endl;
+        AETHER_LOG_ERROR("Core Database", "Falha ao se conectar ao banco de dados",
+                         AetherCoreLogger::field("error", PQerrorMessage(m_conn)));
         return false;
     }
     return true;
@@ -71,18 +84,47 @@ bool PostgresDriver::isConnected() const
  */
 PGresult* PostgresDriver::query(const std::string& sql) const
 {
-    PGresult* res = PQexec(m_conn, sql.c_str()); //Executa o SQL no banco de dados
+    PGresult* res;
+    {
+        Aether::Core::Utils::ScopedTimer timer(queryLatency());
+        Aether::Core::Utils::Span span("db.query");
+        res = PQexec(m_conn, sql.c_str()); //Executa o SQL no banco de dados
+    }
 
     //Verifica se ocorreu algum erro na transação com o banco de dados
     if (PQresultStatus(res) != PGRES_TUPLES_OK && PQresultStatus(res) != PGRES_COMMAND_OK)
     {
-        std::cerr << " [Core Database] Falha ao executar SQL: " << PQerrorMessage(m_conn) << std::endl;
+        AETHER_LOG_ERROR("Core Database", "Falha ao executar SQL",
+                         AetherCoreLogger::field("error", PQerrorMessage(m_conn)));
         PQclear(res); //Limpa a memoria da variavel de retorno
         return nullptr;
     }
     return res;
 }
 
+/**
+ * @brief Realiza uma consulta parametrizada usando PQexecParams.
+ * @param sql Comando SQL com placeholders ($1, $2, etc.).
+ * @param nParams Número de parâmetros a serem substituídos.
+ * @param paramValues Array de strings contendo os valores dos parâmetros.
+ * @return Ponteiro para PGresult contendo o resultado da query,
+ */
+PGresult* PostgresDriver::queryParams(const std::string& sql, int nParams, const char* const* paramValues) const
+{
+    Aether::Core::Utils::ScopedTimer timer(queryLatency());
+    Aether::Core::Utils::Span span("db.query");
+    return PQexecParams(
+        m_conn,
+        sql.c_str(),
+        nParams,
+        nullptr,
+        paramValues,
+        nullptr,
+        nullptr,
+        0
+    );
+}
+
 /**
  * @brief Libera a memória associada a um PGresult.
  * @param res Ponteiro retornado por query().
@@ -0,0 +1,214 @@
+#include "AdmissionControl.hpp"
+#include "../utils/Metrics.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <netinet/in.h>
+
+namespace
+{
+    Aether::Core::Utils::Gauge& handshakesGauge()
+    {
+        static auto& gauge = Aether::Core::Utils::Metrics::gauge(
+            "aether_tcp_handshakes_in_progress", "Conexoes admitidas aguardando o HELLO");
+        return gauge;
+    }
+}
+
+void AdmissionControl::Ticket::handshakeDone()
+{
+    if (handshaking.exchange(false, std::memory_order_acq_rel))
+        admission.releaseHandshake();
+}
+
+void AdmissionControl::Ticket::close()
+{
+    handshakeDone();
+    if (open.exchange(false, std::memory_order_acq_rel))
+        admission.releaseConnection();
+}
+
+void AdmissionControl::configure(const Config& config)
+{
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+    cfg = config;
+    maxConnections.store(config.maxConnections, std::memory_order_relaxed);
+    maxHandshakes.store(config.maxHandshakes, std::memory_order_relaxed);
+    limitLoopback.store(config.limitLoopback, std::memory_order_relaxed);
+}
+
+AdmissionControl::Config AdmissionControl::config() const
+{
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+    return cfg;
+}
+
+/**
+ * Reserva as vagas com fetch_add e desfaz se passou do limite: não há lock
+ * entre as threads de accept.
+ * @param peer Endereço de origem
+ * @param ticket Vagas reservadas (só com Accept)
+ * @return Resultado da admissão
+ */
+AdmissionControl::Verdict AdmissionControl::admit(const sockaddr_storage& peer, std::shared_ptr<Ticket>& ticket)
+{
+    IpKey key{};
+    bool loopback = false;
+    if (toKey(peer, key, loopback) && (limitLoopback.load(std::memory_order_relaxed) || !loopback) &&
+        !takeToken(key, Clock::now()))
+        return Verdict::RateLimited;
+
+    if (openConnections.fetch_add(1, std::memory_order_relaxed) >= maxConnections.load(std::memory_order_relaxed))
+    {
+        openConnections.fetch_sub(1, std::memory_order_relaxed);
+        return Verdict::TooManyConnections;
+    }
+
+    if (pendingHandshakes.fetch_add(1, std::memory_order_relaxed) >= maxHandshakes.load(std::memory_order_relaxed))
+    {
+        pendingHandshakes.fetch_sub(1, std::memory_order_relaxed);
+        openConnections.fetch_sub(1, std::memory_order_relaxed);
+        return Verdict::TooManyHandshakes;
+    }
+
+    handshakesGauge().add();
+    ticket = std::make_shared<Ticket>(*this);
+    return Verdict::Accept;
+}
+
+const char* AdmissionControl::describe(Verdict verdict)
+{
+    switch (verdict)
+    {
+        case Verdict::Accept:               return "accepted";
+        case Verdict::RateLimited:          return "rate_limited";
+        case Verdict::TooManyConnections:   return "max_connections";
+        case Verdict::TooManyHandshakes:    return "handshake_limit";
+    }
+    return "unknown";
+}
+
+std::size_t AdmissionControl::IpKeyHash::operator()(const IpKey& key) const noexcept
+{
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    std::memcpy(&hi, key.data(), 8);
+    std::memcpy(&lo, key.data() + 8, 8);
+    return static_cast<std::size_t>((hi * 0x9E3779B97F4A7C15ull) ^ lo);
+}
+
+/**
+ * Repõe o bucket pelo tempo desde a última conexão e consome um token.
+ * @param key IP de origem
+ * @param now Agora
+ * @return false se o bucket está vazio
+ */
+bool AdmissionControl::takeToken(const IpKey& key, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(bucketsMutex);
+
+    auto it = buckets.find(key);
+    if (it == buckets.end())
+    {
+        /// Só IP novo faz o mapa crescer, então só ele paga a limpeza (amortizada)
+        if (buckets.size() >= nextPrune)
+            pruneBuckets(now);
+        it = buckets.emplace(key, Bucket{ cfg.ipBurst, now }).first;
+    } else
+    {
+        const double elapsed = std::chrono::duration<double>(now - it->second.refilled).count();
+        it->second.tokens = std::min(cfg.ipBurst, it->second.tokens + elapsed * cfg.ipRatePerSecond);
+        it->second.refilled = now;
+    }
+
+    Bucket& bucket = it->second;
+
+    if (bucket.tokens < 1.0)
+        return false;
+
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+/**
+ * Descarta os buckets que já teriam voltado a encher: esquecer esses IPs
+ * não muda nenhuma decisão futura. Se o mapa ainda passa da metade do teto,
+ * esquece os mais antigos até a metade. A próxima limpeza fica para quando o
+ * mapa dobrar, então o custo O(n) se dilui nos IPs novos que o fizeram crescer.
+ * @param now Agora
+ */
+void AdmissionControl::pruneBuckets(Clock::time_point now)
+{
+    static auto& evicted = Aether::Core::Utils::Metrics::counter(
+        "aether_tcp_admission_evicted_total", "Buckets por IP esquecidos antes de encher, com o mapa no teto");
+
+    for (auto it = buckets.begin(); it != buckets.end(); )
+    {
+        const double elapsed = std::chrono::duration<double>(now - it->second.refilled).count();
+        if (it->second.tokens + elapsed * cfg.ipRatePerSecond >= cfg.ipBurst)
+            it = buckets.erase(it);
+        else
+            ++it;
+    }
+
+    constexpr std::size_t keep = MAX_TRACKED_IPS / 2;
+    if (buckets.size() > keep)
+    {
+        std::vector<std::pair<Clock::time_point, IpKey>> ages;
+        ages.reserve(buckets.size());
+        for (const auto& [key, bucket] : buckets)
+            ages.emplace_back(bucket.refilled, key);
+
+        const std::size_t excess = ages.size() - keep;
+        std::nth_element(ages.begin(), ages.begin() + static_cast<std::ptrdiff_t>(excess), ages.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (std::size_t i = 0; i < excess; ++i)
+            buckets.erase(ages[i].second);
+        evicted.inc(excess);
+    }
+
+    nextPrune = std::clamp(buckets.size() * 2, MIN_PRUNE_SIZE, MAX_TRACKED_IPS);
+}
+
+/**
+ * Converte o endereço de origem para a chave do bucket.
+ * @param peer Endereço do accept()
+ * @param key IPv6 (IPv4 mapeado em ::ffff:a.b.c.d)
+ * @param loopback true para 127.0.0.0/8 e ::1
+ * @return false se a família não é IPv4/IPv6
+ */
+bool AdmissionControl::toKey(const sockaddr_storage& peer, IpKey& key, bool& loopback)
+{
+    if (peer.ss_family == AF_INET)
+    {
+        const auto& in = reinterpret_cast<const sockaddr_in&>(peer);
+        key.fill(0);
+        key[10] = key[11] = 0xFF;
+        std::memcpy(key.data() + 12, &in.sin_addr, 4);
+        loopback = key[12] == 127;
+        return true;
+    }
+
+    if (peer.ss_family == AF_INET6)
+    {
+        const auto& in6 = reinterpret_cast<const sockaddr_in6&>(peer);
+        std::memcpy(key.data(), &in6.sin6_addr, 16);
+        loopback = IN6_IS_ADDR_LOOPBACK(&in6.sin6_addr) ||
+                   (IN6_IS_ADDR_V4MAPPED(&in6.sin6_addr) && key[12] == 127);
+        return true;
+    }
+
+    return false;
+}
+
+void AdmissionControl::releaseHandshake()
+{
+    pendingHandshakes.fetch_sub(1, std::memory_order_relaxed);
+    handshakesGauge().sub();
+}
+
+void AdmissionControl::releaseConnection()
+{
+    openConnections.fetch_sub(1, std::memory_order_relaxed);
+}
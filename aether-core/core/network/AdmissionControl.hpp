@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <sys/socket.h>
+
+/**
+ * @brief Admissão de conexões do TcpServer
+ *
+ * Cada accept() passa por admit() antes de custar uma thread e uma sessão.
+ * A ordem das verificações é:
+ *
+ * - Token bucket por IP de origem (`ipRatePerSecond`, `ipBurst`): segura a
+ *   tempestade de reconexão de um mesmo site/NAT sem bloquear os outros.
+ * - Máximo de conexões abertas (`maxConnections`).
+ * - Máximo de handshakes em andamento (`maxHandshakes`): conexões que ainda
+ *   não mandaram o HELLO são as mais baratas de abrir e as mais caras de
+ *   manter (slowloris); o LivenessMonitor derruba as que não terminam.
+ *
+ * Uma conexão admitida recebe um Ticket com as duas vagas reservadas. A de
+ * handshake é devolvida quando o HELLO é aceito; a de conexão, quando ela
+ * fecha. As duas devoluções são idempotentes.
+ *
+ * Pode ser chamada de várias threads de accept ao mesmo tempo: os contadores
+ * e os limites são atômicos e só os buckets têm lock. configure() pode ser
+ * chamado com o servidor rodando (comando `admission set` do CLI); só o
+ * backlog espera o próximo start().
+ *
+ * Os buckets de IPs que já voltaram a encher são descartados de tempos em
+ * tempos (quando o mapa dobra desde a última limpeza). Se nem assim ele
+ * couber em MAX_TRACKED_IPS (origens forjadas, todas limitadas), os buckets
+ * mais antigos são esquecidos.
+ */
+class AdmissionControl
+{
+    public:
+        /**
+         * @brief Limites de admissão
+         */
+        struct Config
+        {
+            int backlog = 1024;                     /**< Fila do listen() (o kernel limita em net.core.somaxconn) */
+            std::size_t maxConnections = 10000;     /**< Conexões abertas ao mesmo tempo */
+            std::size_t maxHandshakes = 512;        /**< Conexões aguardando o HELLO */
+            double ipRatePerSecond = 5;             /**< Conexões novas por segundo por IP (reposição do bucket) */
+            double ipBurst = 50;                    /**< Conexões seguidas por IP antes de limitar (tamanho do bucket) */
+            bool limitLoopback = false;             /**< Aplica o bucket a 127.0.0.0/8 e ::1 (loadgen, testes) */
+        };
+
+        /** @brief Resultado de admit() */
+        enum class Verdict : uint8_t
+        {
+            Accept,
+            RateLimited,            /**< Bucket do IP vazio */
+            TooManyConnections,     /**< maxConnections atingido */
+            TooManyHandshakes,      /**< maxHandshakes atingido */
+        };
+
+        /**
+         * @brief Vagas reservadas por uma conexão admitida
+         */
+        class Ticket
+        {
+            public:
+                explicit Ticket(AdmissionControl& admission) : admission(admission) {}
+                ~Ticket() { close(); }
+
+                Ticket(const Ticket&) = delete;
+                Ticket& operator=(const Ticket&) = delete;
+
+                /** @brief HELLO aceito: devolve a vaga de handshake */
+                void handshakeDone();
+
+                /** @brief Conexão fechada: devolve as vagas que ainda estiverem com o ticket */
+                void close();
+
+            private:
+                AdmissionControl& admission;
+                std::atomic<bool> handshaking{true};
+                std::atomic<bool> open{true};
+        };
+
+        AdmissionControl() = default;
+
+        AdmissionControl(const AdmissionControl&) = delete;
+        AdmissionControl& operator=(const AdmissionControl&) = delete;
+
+        /** @brief Troca os limites; vale para os próximos accepts (o backlog, para o próximo start()) */
+        void configure(const Config& config);
+
+        /** @brief Cópia dos limites atuais */
+        Config config() const;
+
+        /**
+         * @brief Decide se uma conexão recém-aceita pode seguir
+         * @param peer Endereço de origem (do accept())
+         * @param ticket Recebe as vagas reservadas se o resultado for Accept
+         */
+        Verdict admit(const sockaddr_storage& peer, std::shared_ptr<Ticket>& ticket);
+
+        /** @brief Nome do resultado, usado no label `reason` das métricas */
+        static const char* describe(Verdict verdict);
+
+        std::size_t connections() const { return openConnections.load(std::memory_order_relaxed); }
+        std::size_t handshakes() const { return pendingHandshakes.load(std::memory_order_relaxed); }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /** @brief IP de origem (IPv4 vai mapeado em IPv6) */
+        using IpKey = std::array<uint8_t, 16>;
+
+        struct IpKeyHash
+        {
+            std::size_t operator()(const IpKey& key) const noexcept;
+        };
+
+        struct Bucket
+        {
+            double tokens;
+            Clock::time_point refilled;
+        };
+
+        static constexpr std::size_t MAX_TRACKED_IPS = 65536;  /**< Teto do mapa de buckets */
+        static constexpr std::size_t MIN_PRUNE_SIZE = 4096;    /**< Abaixo disso o mapa não é limpo */
+
+        bool takeToken(const IpKey& key, Clock::time_point now);
+        void pruneBuckets(Clock::time_point now);
+        static bool toKey(const sockaddr_storage& peer, IpKey& key, bool& loopback);
+
+        void releaseHandshake();
+        void releaseConnection();
+
+        std::atomic<std::size_t> maxConnections{Config{}.maxConnections};
+        std::atomic<std::size_t> maxHandshakes{Config{}.maxHandshakes};
+        std::atomic<bool> limitLoopback{Config{}.limitLoopback};
+        std::atomic<std::size_t> openConnections{0};
+        std::atomic<std::size_t> pendingHandshakes{0};
+
+        mutable std::mutex bucketsMutex;                        /**< Protege cfg (taxa, burst, backlog), buckets e nextPrune */
+        Config cfg;
+        std::unordered_map<IpKey, Bucket, IpKeyHash> buckets;   /**< Um bucket por IP visto recentemente */
+        std::size_t nextPrune = MIN_PRUNE_SIZE;                 /**< Tamanho do mapa que dispara a próxima limpeza */
+};
@@ -0,0 +1,215 @@
+#include "LivenessMonitor.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/Metrics.hpp"
+
+LivenessMonitor::~LivenessMonitor()
+{
+    stop();
+}
+
+void LivenessMonitor::configure(const Config& cfg)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    config = cfg;
+    if (config.tick.count() <= 0)
+        config.tick = std::chrono::milliseconds(1000);
+}
+
+void LivenessMonitor::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running)
+        return;
+
+    running = true;
+    thread = std::thread(&LivenessMonitor::run, this);
+}
+
+void LivenessMonitor::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return;
+        running = false;
+    }
+
+    cv.notify_all();
+    if (thread.joinable())
+        thread.join();
+}
+
+/**
+ * Agenda o prazo do HELLO. A atividade conta a partir de agora, então uma
+ * conexão que fecha o handshake e fica calada recebe o 1º HEARTBEAT depois
+ * de idleTimeout contado do accept.
+ * @param callbacks Ações sobre a conexão
+ * @return Entry da conexão
+ */
+std::shared_ptr<LivenessMonitor::Entry> LivenessMonitor::track(Callbacks callbacks)
+{
+    auto entry = std::make_shared<Entry>(std::move(callbacks));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entry->lastActivity.store(wheel.now(), std::memory_order_relaxed);
+    wheel.schedule(*entry, ticks(config.helloTimeout));
+    entries.insert(entry);
+    return entry;
+}
+
+void LivenessMonitor::untrack(const std::shared_ptr<Entry>& entry)
+{
+    if (!entry)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entry->phase = Entry::Phase::Closed;
+    wheel.cancel(*entry);
+    entries.erase(entry);
+}
+
+/**
+ * Avança a roda uma vez por tick. As decisões são tomadas sob o lock e as
+ * ações (enviar HEARTBEAT, fechar socket) rodam depois de soltá-lo: um
+ * send() lento não segura o track()/untrack() das outras conexões.
+ */
+void LivenessMonitor::run()
+{
+    static auto& helloTimeouts = Aether::Core::Utils::Metrics::counter(
+        "aether_tcp_hello_timeouts_total", "Conexoes sem HELLO dentro do prazo");
+
+    std::vector<Aether::Core::Utils::TimingWheel::Timer*> expired;
+    std::vector<std::pair<std::shared_ptr<Entry>, Action>> actions;
+
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (running)
+    {
+        next += config.tick;
+        if (cv.wait_until(lock, next, [&] { return !running; }))
+            break;
+
+        wheel.advance(expired);
+        now.store(wheel.now(), std::memory_order_relaxed);
+
+        for (auto* timer : expired)
+            onExpired(static_cast<Entry&>(*timer), actions);
+        expired.clear();
+
+        if (actions.empty())
+            continue;
+
+        lock.unlock();
+        for (auto& [entry, action] : actions)
+        {
+            switch (action)
+            {
+                case Action::ExpireHandshake:
+                {
+                    /// O HELLO pode ter terminado depois da decisão; aí a conexão passa a ser vigiada por inatividade
+                    const bool expiredHello = !entry->callbacks.expireHandshake || entry->callbacks.expireHandshake();
+                    if (expiredHello)
+                    {
+                        helloTimeouts.inc();
+                        if (entry->callbacks.close)
+                            entry->callbacks.close();
+                        break;
+                    }
+
+                    std::lock_guard<std::mutex> relock(mutex);
+                    if (entry->phase == Entry::Phase::Handshake)
+                    {
+                        entry->phase = Entry::Phase::Active;
+                        wheel.schedule(*entry, ticks(config.idleTimeout));
+                    }
+                    break;
+                }
+
+                case Action::Heartbeat:
+                    if (entry->callbacks.sendHeartbeat)
+                        entry->callbacks.sendHeartbeat();
+                    break;
+
+                case Action::Close:
+                    if (entry->callbacks.close)
+                        entry->callbacks.close();
+                    break;
+            }
+        }
+        actions.clear();
+        lock.lock();
+    }
+}
+
+/**
+ * Decide o destino de uma Entry vencida (chamado com o lock).
+ * @param entry Entry cujo timer venceu
+ * @param actions Ações a executar fora do lock
+ */
+void LivenessMonitor::onExpired(Entry& entry, std::vector<std::pair<std::shared_ptr<Entry>, Action>>& actions)
+{
+    using Aether::Core::Utils::Metrics;
+    static auto& heartbeats = Metrics::counter("aether_tcp_heartbeats_sent_total", "HEARTBEATs enviados a devices inativos");
+    static auto& idleClosed = Metrics::counter("aether_tcp_idle_closed_total", "Conexoes fechadas por nao responder aos HEARTBEATs");
+
+    const uint64_t current = wheel.now();
+
+    if (entry.phase == Entry::Phase::Handshake)
+    {
+        /// Quem sabe se o HELLO terminou é a sessão, e ela não é consultada sob este lock
+        actions.emplace_back(entry.shared_from_this(), Action::ExpireHandshake);
+        return;
+    }
+
+    if (entry.phase != Entry::Phase::Active)
+        return;
+
+    const uint64_t last = entry.lastActivity.load(std::memory_order_relaxed);
+    const uint64_t idleTicks = ticks(config.idleTimeout);
+
+    if (entry.missedBeats == 0)
+    {
+        /// Houve atividade desde o agendamento: dorme só o que falta
+        if (current - last < idleTicks)
+        {
+            wheel.schedule(entry, idleTicks - (current - last));
+            return;
+        }
+    }
+    else if (last >= entry.beatSentAt)
+    {
+        /// O device respondeu ao HEARTBEAT (qualquer byte conta)
+        entry.missedBeats = 0;
+        wheel.schedule(entry, idleTicks);
+        return;
+    }
+
+    if (entry.missedBeats >= config.maxMissedBeats)
+    {
+        idleClosed.inc();
+        entry.phase = Entry::Phase::Closed;
+        actions.emplace_back(entry.shared_from_this(), Action::Close);
+        AETHER_LOG_INFO("Liveness", "Fechando conexão sem resposta aos HEARTBEATs",
+                        AetherCoreLogger::field("missed", entry.missedBeats));
+        return;
+    }
+
+    ++entry.missedBeats;
+    entry.beatSentAt = current;
+    heartbeats.inc();
+    actions.emplace_back(entry.shared_from_this(), Action::Heartbeat);
+    wheel.schedule(entry, ticks(config.heartbeatInterval));
+}
+
+/**
+ * Converte um prazo em ticks, arredondando para cima.
+ * @param duration Prazo
+ * @return Ticks (no mínimo 1)
+ */
+uint64_t LivenessMonitor::ticks(std::chrono::milliseconds duration) const
+{
+    const auto tick = config.tick.count();
+    const auto count = (duration.count() + tick - 1) / tick;
+    return count < 1 ? 1 : static_cast<uint64_t>(count);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "../utils/TimingWheel.hpp"
+
+/**
+ * @brief Vigia a atividade das conexões TCP e encerra as que morreram
+ *
+ * Cada conexão aceita ganha uma Entry numa timing wheel (O(1) para agendar
+ * e cancelar, com 10k+ conexões). Uma thread avança a roda a cada tick:
+ *
+ * - Handshake: se o HELLO não terminou em `helloTimeout`, a sessão é
+ *   recusada (ConnSession::expireHandshake) e o socket fechado. Bytes
+ *   chegando aos poucos não renovam esse prazo.
+ * - Ativa: sem bytes recebidos por `idleTimeout`, o servidor manda um
+ *   HEARTBEAT e espera `heartbeatInterval` por qualquer byte do device.
+ *   Depois de `maxMissedBeats` heartbeats sem resposta, fecha o socket.
+ *
+ * touch() é chamado a cada recv e só grava o tick atual num atômico; o
+ * timer não é reagendado ali. Quando ele vence, a thread compara com a
+ * última atividade e, se houve, reagenda para o que falta.
+ *
+ * Os callbacks da Entry rodam na thread do monitor, fora do lock.
+ */
+class LivenessMonitor
+{
+    public:
+        /**
+         * @brief Prazos de liveness (arredondados para cima em ticks)
+         */
+        struct Config
+        {
+            std::chrono::milliseconds tick{1000};                   /**< Resolução da roda */
+            std::chrono::milliseconds helloTimeout{10000};          /**< Prazo do handshake */
+            std::chrono::milliseconds idleTimeout{60000};           /**< Silêncio antes do 1º HEARTBEAT */
+            std::chrono::milliseconds heartbeatInterval{15000};     /**< Espera pela resposta de cada HEARTBEAT */
+            unsigned maxMissedBeats = 3;                            /**< HEARTBEATs sem resposta antes de fechar */
+        };
+
+        /**
+         * @brief Ações sobre a conexão; capturam weak_ptr (a conexão pode já ter ido embora)
+         */
+        struct Callbacks
+        {
+            std::function<bool()> expireHandshake;  /**< Recusa o HELLO pendente; false se o handshake já terminou */
+            std::function<void()> sendHeartbeat;    /**< Envia um HEARTBEAT ao device; não pode bloquear (roda na thread da roda) */
+            std::function<void()> close;            /**< Fecha o socket (o fluxo normal de desconexão faz o resto) */
+        };
+
+        /** @brief Conexão vigiada; criada por track() */
+        class Entry : private Aether::Core::Utils::TimingWheel::Timer, public std::enable_shared_from_this<Entry>
+        {
+            public:
+                explicit Entry(Callbacks callbacks) : callbacks(std::move(callbacks)) {}
+
+            private:
+                friend class LivenessMonitor;
+
+                enum class Phase : uint8_t { Handshake, Active, Closed };
+
+                const Callbacks callbacks;
+                std::atomic<uint64_t> lastActivity{0};  /**< Tick do último recv (gravado sem lock) */
+                Phase phase = Phase::Handshake;         /**< Protegido pelo mutex do monitor */
+                unsigned missedBeats = 0;
+                uint64_t beatSentAt = 0;                /**< Tick do último HEARTBEAT */
+        };
+
+        LivenessMonitor() = default;
+        ~LivenessMonitor();
+
+        LivenessMonitor(const LivenessMonitor&) = delete;
+        LivenessMonitor& operator=(const LivenessMonitor&) = delete;
+
+        /** @brief Troca os prazos; vale para as próximas conexões (chamar antes do start()) */
+        void configure(const Config& config);
+
+        void start();   /// Sobe a thread da roda
+        void stop();    /// Para a thread; as entries continuam registradas até o untrack()
+
+        /**
+         * @brief Passa a vigiar uma conexão recém-aceita (começa no prazo do HELLO)
+         * @param callbacks Ações sobre a conexão
+         * @return Entry a ser passada para touch() e untrack()
+         */
+        std::shared_ptr<Entry> track(Callbacks callbacks);
+
+        /** @brief Deixa de vigiar a conexão (chamar na desconexão) */
+        void untrack(const std::shared_ptr<Entry>& entry);
+
+        /** @brief Registra atividade na conexão; só um store atômico */
+        void touch(Entry& entry) const
+        {
+            entry.lastActivity.store(now.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+    private:
+        /** @brief O que fazer com uma Entry vencida, decidido sob o lock e executado fora dele */
+        enum class Action : uint8_t { ExpireHandshake, Heartbeat, Close };
+
+        void run();                                 /// Laço da thread: um advance() por tick
+        void onExpired(Entry& entry, std::vector<std::pair<std::shared_ptr<Entry>, Action>>& actions);
+        uint64_t ticks(std::chrono::milliseconds duration) const;
+
+        Config config;
+        std::atomic<uint64_t> now{0};               /**< Tick atual, lido pelo touch() */
+
+        std::mutex mutex;                           /**< Protege a roda, as entries e as fases */
+        std::condition_variable cv;
+        Aether::Core::Utils::TimingWheel wheel{1024};
+        std::unordered_set<std::shared_ptr<Entry>> entries;     /**< Mantém vivas as entries da roda */
+
+        bool running = false;                       /**< Protegido por mutex */
+        std::thread thread;
+};
@@ -0,0 +1,195 @@
+#include "PacketCapture.hpp"
+#include "SessionManager.hpp"
+#include "../utils/logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t PCAP_MAGIC = 0xa1b2c3d4;     // Timestamps em microssegundos
+    constexpr uint32_t SNAPLEN = 256 * 1024;        // Frames maiores são truncados no arquivo
+    constexpr std::size_t MODULE_OFFSET = 5;        // Campo module no cabeçalho Aether (ver Packet.hpp)
+    constexpr std::size_t MODULE_OFFSET_V2 = 6;     // Na v2 o byte de flags desloca o cabeçalho
+
+    /** Cabeçalho global do pcap (byte order nativo; o leitor detecta pelo magic) */
+    struct PcapFileHeader
+    {
+        uint32_t magic;
+        uint16_t versionMajor;
+        uint16_t versionMinor;
+        int32_t thisZone;
+        uint32_t sigFigs;
+        uint32_t snapLen;
+        uint32_t linkType;
+    };
+
+    /** Cabeçalho de cada registro do pcap */
+    struct PcapRecordHeader
+    {
+        uint32_t seconds;
+        uint32_t micros;
+        uint32_t capturedLength;
+        uint32_t originalLength;
+    };
+}
+
+PacketCapture& PacketCapture::instance()
+{
+    static PacketCapture capture;
+    return capture;
+}
+
+std::string PacketCapture::start(const std::string& path, Filter filter, uint64_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    closeLocked();
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return "Falha ao criar o arquivo de captura: " + path + " (" + std::strerror(errno) + ")";
+
+    const PcapFileHeader header{ PCAP_MAGIC, 2, 4, 0, 0, SNAPLEN, LINKTYPE_AETHER };
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    file_ = file;
+    path_ = path;
+    filter_ = std::move(filter);
+    maxBytes_ = maxBytes;
+    bytes_ = sizeof(header);
+    frames_ = 0;
+    enabled_.store(true, std::memory_order_relaxed);
+
+    AETHER_LOG_INFO("PacketCapture", "Captura ligada",
+                    AetherCoreLogger::field("file", path_),
+                    AetherCoreLogger::field("module", filter_.module ? static_cast<int>(*filter_.module) : -1),
+                    AetherCoreLogger::field("device", filter_.device));
+    return {};
+}
+
+void PacketCapture::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
+}
+
+std::string PacketCapture::status()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!file_)
+    {
+        if (path_.empty())
+            return "trace: desligado";
+        return "trace: desligado (ultimo arquivo: " + path_ + ", " + std::to_string(frames_) + " frames)";
+    }
+
+    std::fflush(file_);
+
+    std::string text = "trace: ligado, arquivo " + path_;
+    text += ", modulo " + (filter_.module ? std::to_string(*filter_.module) : std::string("todos"));
+    text += ", device " + (filter_.device.empty() ? std::string("todos") : filter_.device);
+    text += ", " + std::to_string(frames_) + " frames, " + std::to_string(bytes_) + " bytes";
+    return text;
+}
+
+void PacketCapture::record(Direction direction, uint64_t channelId, const uint8_t* frame, std::size_t size,
+                           std::string_view device)
+{
+    if (!enabled())
+        return;
+
+    // Sem o deviceExternalId em mãos, consulta o SessionManager (só com a captura ligada)
+    std::optional<std::string> registered;
+    if (device.empty())
+    {
+        registered = SessionManager::instance().getDeviceExternalId(channelId);
+        if (registered)
+            device = *registered;
+    }
+
+    writeRecord(direction, channelId, device, frame, size);
+}
+
+void PacketCapture::writeRecord(Direction direction, uint64_t channelId, std::string_view device,
+                                const uint8_t* frame, std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!file_)
+        return;
+
+    if (filter_.module)
+    {
+        if (size < MODULE_OFFSET_V2 + 2)
+            return;
+
+        const std::size_t at = frame[2] == 2 ? MODULE_OFFSET_V2 : MODULE_OFFSET;
+        const uint16_t module = static_cast<uint16_t>((frame[at] << 8) | frame[at + 1]);
+        if (module != *filter_.module)
+            return;
+    }
+
+    if (!filter_.device.empty() && device != filter_.device)
+        return;
+
+    if (device.size() > 255)
+        device = device.substr(0, 255);
+
+    // Pseudo-cabeçalho: direction, deviceLen, channel (32 bits baixos, BE), device
+    uint8_t pseudo[6 + 255];
+    pseudo[0] = static_cast<uint8_t>(direction);
+    pseudo[1] = static_cast<uint8_t>(device.size());
+    pseudo[2] = static_cast<uint8_t>(channelId >> 24);
+    pseudo[3] = static_cast<uint8_t>(channelId >> 16);
+    pseudo[4] = static_cast<uint8_t>(channelId >> 8);
+    pseudo[5] = static_cast<uint8_t>(channelId);
+    std::memcpy(pseudo + 6, device.data(), device.size());
+    const std::size_t pseudoSize = 6 + device.size();
+
+    const std::size_t original = pseudoSize + size;
+    const std::size_t captured = std::min<std::size_t>(original, SNAPLEN);
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+
+    const PcapRecordHeader header{
+        static_cast<uint32_t>(micros / 1'000'000),
+        static_cast<uint32_t>(micros % 1'000'000),
+        static_cast<uint32_t>(captured),
+        static_cast<uint32_t>(original)
+    };
+
+    std::fwrite(&header, sizeof(header), 1, file_);
+    std::fwrite(pseudo, 1, pseudoSize, file_);
+    std::fwrite(frame, 1, captured - pseudoSize, file_);
+
+    bytes_ += sizeof(header) + captured;
+    ++frames_;
+
+    if (bytes_ >= maxBytes_)
+    {
+        AETHER_LOG_WARN("PacketCapture", "Limite do arquivo atingido, captura desligada",
+                        AetherCoreLogger::field("file", path_),
+                        AetherCoreLogger::field("bytes", bytes_));
+        closeLocked();
+    }
+}
+
+void PacketCapture::closeLocked()
+{
+    enabled_.store(false, std::memory_order_relaxed);
+
+    if (!file_)
+        return;
+
+    std::fclose(file_);
+    file_ = nullptr;
+
+    AETHER_LOG_INFO("PacketCapture", "Captura desligada",
+                    AetherCoreLogger::field("file", path_),
+                    AetherCoreLogger::field("frames", frames_));
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Captura dos frames Aether trafegados no TCP, ligada/desligada em
+ * tempo de execução (CLI: trace on|off|status).
+ *
+ * Grava cada frame recebido (Parser / handshake) e enviado
+ * (TcpResponseChannel) num arquivo pcap com LINKTYPE_USER0 (147), que o
+ * Wireshark abre com o dissector tools/wireshark/aether.lua. Cada registro
+ * é um pseudo-cabeçalho seguido do frame Aether original:
+ *
+ * +---------+-----------+--------------------------------------------+
+ * | Byte(s) | Campo     | Descrição                                  |
+ * +---------+-----------+--------------------------------------------+
+ * |   0     | direction | 0 = recebido do device, 1 = enviado        |
+ * |   1     | deviceLen | Tamanho do deviceExternalId (0 = sem id)   |
+ * |  2..5   | channel   | id() do canal, 32 bits baixos (BE)         |
+ * |  6..N   | device    | deviceExternalId (deviceLen bytes)         |
+ * |  N..    | frame     | Frame Aether completo, como no socket      |
+ * +---------+-----------+--------------------------------------------+
+ *
+ * Desligada, o custo nos pontos de captura é uma leitura atômica
+ * (enabled()); o filtro (módulo/device) e a escrita só acontecem com a
+ * captura ligada.
+ */
+class PacketCapture
+{
+public:
+    /** @brief Sentido do frame, do ponto de vista do servidor */
+    enum class Direction : uint8_t
+    {
+        Inbound  = 0,   /**< Device -> servidor */
+        Outbound = 1    /**< Servidor -> device */
+    };
+
+    /** @brief Filtro da captura; campos vazios aceitam tudo */
+    struct Filter
+    {
+        std::optional<uint16_t> module;     /**< Só frames deste módulo (campo module do cabeçalho) */
+        std::string device;                 /**< Só frames deste deviceExternalId */
+    };
+
+    static constexpr uint32_t LINKTYPE_AETHER = 147;                    /**< LINKTYPE_USER0 */
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 64ull * 1024 * 1024;  /**< Limite default do arquivo */
+
+    /** @brief Instância única (a captura é global ao daemon) */
+    static PacketCapture& instance();
+
+    /** @brief true se a captura estiver ligada (caminho rápido dos pontos de captura) */
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Liga a captura, criando (ou truncando) o arquivo pcap
+     * @param path Arquivo de saída
+     * @param filter Módulo/device a capturar
+     * @param maxBytes A captura desliga sozinha ao atingir esse tamanho
+     * @return Mensagem de erro, ou string vazia em caso de sucesso
+     */
+    std::string start(const std::string& path, Filter filter, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /** @brief Desliga a captura e fecha o arquivo */
+    void stop();
+
+    /** @brief Resumo legível do estado (arquivo, filtro, frames e bytes gravados) */
+    std::string status();
+
+    /**
+     * @brief Registra um frame, se a captura estiver ligada e o frame passar no filtro
+     * @param direction Sentido do frame
+     * @param channelId IResponseChannel::id() da conexão
+     * @param frame Frame Aether completo (cabeçalho + payload)
+     * @param size Tamanho do frame
+     * @param device deviceExternalId, quando o chamador já o conhece (ex:
+     * HELLO, antes do registro no SessionManager); vazio = consultar o SessionManager
+     */
+    void record(Direction direction, uint64_t channelId, const uint8_t* frame, std::size_t size,
+                std::string_view device = {});
+
+private:
+    PacketCapture() = default;
+
+    void writeRecord(Direction direction, uint64_t channelId, std::string_view device,
+                     const uint8_t* frame, std::size_t size);
+    void closeLocked();
+
+    static inline std::atomic<bool> enabled_{false};    /**< Lido sem lock nos pontos de captura */
+
+    std::mutex mutex_;                  /**< Protege arquivo, filtro e contadores */
+    std::FILE* file_ = nullptr;         /**< Arquivo pcap aberto (nullptr = desligada) */
+    std::string path_;                  /**< Caminho do arquivo atual/último */
+    Filter filter_;                     /**< Filtro ativo */
+    uint64_t maxBytes_ = DEFAULT_MAX_BYTES;
+    uint64_t bytes_ = 0;                /**< Bytes gravados (inclui cabeçalhos pcap) */
+    uint64_t frames_ = 0;               /**< Frames gravados */
+};
@@ -1,34 +1,119 @@
 #pragma once
-#include <iostream>
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
 
 #include "../../protocols/aether/common/IProtocolHandler.hpp"
+#include "../../protocols/aether/common/RequestChannel.hpp"
 //#include "../../network/session/ConnSession.hpp"
 #include "session/ConnSession.hpp"
 #include "../../protocols/aether/include/Packet.hpp"
+#include "../eventbus/include/EventBus.hpp"
+#include "../eventbus/include/EventTypes.hpp"
+#include "../utils/LaneExecutor.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/Metrics.hpp"
+#include "../utils/Tracing.hpp"
 
 /**
  * Classe que implementa um Handler para gerenciar os pacotes recebidos via TCP e
  * distribuir entre os modulos corretamente, garantindo que cada module receba apenas
  * os pacotes destinados a dele.
+ *
+ * O router roda na thread de leitura da conexão, mas não chama o módulo ali:
+ * cada módulo tem o seu LaneExecutor (IProtocolHandler::dispatchLimits) e o
+ * pacote é enfileirado na lane da conexão. Um módulo lento (ex: insert do
+ * Poseidon) só atrasa os pacotes dele, e os pacotes de um device continuam
+ * chegando ao módulo na ordem em que foram recebidos.
+ *
+ * A busca do módulo é uma tabela de 256 entradas indexada pelo byte do
+ * ModuleId. Registrar ou remover um módulo monta uma tabela nova e a publica
+ * com um store atômico; quem está no meio de um onPacket continua na tabela
+ * antiga, que só é liberada junto com o router.
  */
 class ProtocolRouter : public IProtocolHandler
 {
 public:
+    ProtocolRouter()
+    {
+        tables.push_back(std::make_unique<DispatchTable>());
+        table.store(tables.back().get(), std::memory_order_release);
+        EventBus::getInstance().subscribe(&stateListener);
+    }
+
+    ~ProtocolRouter() override
+    {
+        EventBus::getInstance().unsubscribe(&stateListener);
+    }
+
+    ProtocolRouter(const ProtocolRouter&) = delete;
+    ProtocolRouter& operator=(const ProtocolRouter&) = delete;
+
     /**
      * @brief Registra um módulo capaz de receber pacotes TCP. Cada módulo implementa IProtocolHandler
+     *
+     * Cria o executor do módulo com os limites declarados por ele. Pode ser
+     * chamado com o servidor rodando; um módulo com o mesmo id é substituído
+     * (os pacotes que já estavam na fila dele ainda são entregues).
      * @param handler
      * @param module
      */
     void registerModule(const std::shared_ptr<IProtocolHandler>& handler, const std::shared_ptr<IModule>& module)
     {
+        using Aether::Core::Utils::Metrics;
+
+        if (!handler || !module)
+        {
+            AETHER_LOG_WARN("Router", "Modulo com handler NULL ignorado");
+            return;
+        }
+
+        const uint8_t id = handler->moduleId();
+        const auto limits = handler->dispatchLimits();
+
+        AETHER_LOG_INFO("Router", "Registrando módulo",
+                        AetherCoreLogger::field("id", id),
+                        AetherCoreLogger::field("type", typeid(*module).name()),
+                        AetherCoreLogger::field("workers", limits.workers),
+                        AetherCoreLogger::field("queue", limits.queueCapacity));
+
+        const std::string label = "module=\"" + std::to_string(id) + "\"";
+
+        auto route = std::make_unique<RegisteredModule>();
+        route->handler = handler;
+        route->module = module;
+        route->name = module->name();
+        route->executor = std::make_unique<Aether::Core::Utils::LaneExecutor>(limits.workers, limits.queueCapacity);
+        route->running.store(module->isRunning(), std::memory_order_relaxed);
+        route->packets = &Metrics::counter("aether_router_packets_total", "Pacotes encaminhados aos modulos", label);
+        route->queued = &Metrics::gauge("aether_router_queue_depth", "Pacotes na fila (ou em execucao) do executor do modulo", label);
+        route->queueWait = &Metrics::histogram("aether_router_queue_wait_seconds", "Tempo do pacote na fila do executor do modulo", label);
 
-        std::cout << "[Router] Registrando módulo com ID="
-          << static_cast<int>(handler->moduleId())
-          << " (" << typeid(*module).name() << ")"
-          << std::endl;
+        std::lock_guard<std::mutex> lock(writeMutex);
+        routes.push_back(std::move(route));
+        publish(id, routes.back().get());
+    }
+
+    /**
+     * @brief Remove o módulo do roteamento; os próximos pacotes para ele recebem ERROR_GENERIC
+     *
+     * O executor continua vivo e termina os pacotes que já estavam na fila.
+     * @param id Id do módulo (ModuleId)
+     * @return false se não havia módulo com esse id
+     */
+    bool unregisterModule(uint8_t id)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!(*table.load(std::memory_order_relaxed))[id])
+            return false;
 
-        modules.emplace_back(RegisteredModule{handler, module});;
+        AETHER_LOG_INFO("Router", "Removendo módulo", AetherCoreLogger::field("id", id));
+        publish(id, nullptr);
+        return true;
     }
 
     /**
@@ -53,74 +138,214 @@ public:
 
     /**
      * @brief Chamado pelo Parser sempre que um pacote é considerado valido, decide quem deve receber este pacote
+     *
+     * Se o pacote tem request id, o módulo recebe um RequestChannel: qualquer
+     * resposta enviada por ele (agora ou depois, de outra thread) leva o id.
+     *
+     * O pacote é copiado para o executor do módulo, na lane de channel->id()
+     * (uma conexão por device). Executor cheio: responde MODULE_UNAVAILABLE.
+     * Se a conexão fechar antes de o pacote sair da fila, ele é descartado.
      * @param packet Pacote recebido
      * @param channel Canal de comunicação
      */
     void onPacket( const ProtocolAether::Packet& packet, std::shared_ptr<IResponseChannel> channel ) override
     {
+        using Aether::Core::Utils::Metrics;
+        static auto& dispatchTime = Metrics::histogram("aether_router_dispatch_seconds", "Tempo do onPacket do modulo de destino");
+        static auto& unavailable = Metrics::counter("aether_router_rejected_total", "Pacotes recusados pelo router", "reason=\"module_unavailable\"");
+        static auto& unknown = Metrics::counter("aether_router_rejected_total", "Pacotes recusados pelo router", "reason=\"module_not_found\"");
+        static auto& queueFull = Metrics::counter("aether_router_rejected_total", "Pacotes recusados pelo router", "reason=\"queue_full\"");
+        static auto& channelClosed = Metrics::counter("aether_router_rejected_total", "Pacotes recusados pelo router", "reason=\"channel_closed\"");
+
         /// ==================================================
         ///                      ROUTER
         /// ==================================================
 
+        /// Respostas (inclusive os erros do próprio router) ecoam o request id
+        if (packet.flags & ProtocolAether::PacketBuilder::FLAG_REQUEST_ID)
+            channel = std::make_shared<RequestChannel>(std::move(channel), packet.requestId);
 
-        /// Busca o modulo correto para enviar o pacote
-        auto it = std::find_if(
-            modules.begin(),
-            modules.end(),
-            [&](const auto& m)
-            {
-                if (!m.handler)
-                {
-                    std::cout << "[Router] Modulo com handler NULL ingorado" << std::endl;
-                    return false;
-                }
-                return m.handler->moduleId() == packet.module;
-            }
-        );
+        /// Controle da conexão endereçado ao CORE: respondido aqui, sem passar por módulo
+        if (packet.module == static_cast<uint16_t>(ModuleId::CORE) && handleControl(packet, *channel))
+            return;
+
+        /// Busca o modulo correto para enviar o pacote (o campo module tem 2 bytes, os ids só 1)
+        RegisteredModule* route = packet.module <= 0xFF
+            ? (*table.load(std::memory_order_acquire))[packet.module]
+            : nullptr;
 
-        /// Verifica se o modulo está disponível
-        if (!it->module->isRunning())
+        if (!route)
         {
-            std::string payload = "Modulo indisponível";
+            unknown.inc();
+            /// Responde ao cliente um ERROR_GENERIC indicando a falta de Identificação
+            std::string payload = "Modulo não encontrado";
             auto response = ProtocolAether::PacketBuilder::build(
-                /* CommandType  */CommandType::MODULE_UNAVAILABLE,
+                /* CommandType  */CommandType::ERROR_GENERIC,
                 /* Module */    static_cast<uint16_t>(ModuleId::CORE),
                 /* Payload */   std::vector<uint8_t>(payload.begin(), payload.end())
             );
 
             channel->sendResponse(response);
+            AETHER_LOG_WARN("Router", "Nenhum módulo para o pacote", AetherCoreLogger::field("moduleId", packet.module));
             return;
         }
 
-        /// Encaminha o pacote para o modulo correspondente
-        if (it != modules.end())
+        /// Verifica se o modulo está disponível. O flag é zerado pelo MODULE_STOPPED;
+        /// parado, confirma no módulo (que pode ter sido iniciado de novo)
+        if (!route->running.load(std::memory_order_relaxed))
         {
-            it->handler->onPacket(packet, channel);
+            if (!route->module->isRunning())
+            {
+                unavailable.inc();
+                std::string payload = "Modulo indisponível";
+                auto response = ProtocolAether::PacketBuilder::build(
+                    /* CommandType  */CommandType::MODULE_UNAVAILABLE,
+                    /* Module */    static_cast<uint16_t>(ModuleId::CORE),
+                    /* Payload */   std::vector<uint8_t>(payload.begin(), payload.end())
+                );
+
+                channel->sendResponse(response);
+                return;
+            }
+            route->running.store(true, std::memory_order_relaxed);
         }
-        else
+
+        /// Encaminha o pacote para o executor do modulo correspondente
+        const uint64_t lane = channel->id();
+        auto task = [handler = route->handler, packet, channel, queued = route->queued, queueWait = route->queueWait,
+                     enqueued = std::chrono::steady_clock::now(),
+                     trace = Aether::Core::Utils::Tracing::current()]
         {
-            /// Responde ao cliente um ERROR_GENERIC indicando a falta de Identificação
-            std::string payload = "Modulo não encontrado";
+            Aether::Core::Utils::TraceResume resume(trace);
+            queueWait->observe(std::chrono::steady_clock::now() - enqueued);
+
+            /// A conexão fechou enquanto o pacote esperava na fila: não há a quem responder
+            if (!channel->isOpen())
+            {
+                channelClosed.inc();
+                queued->sub();
+                return;
+            }
+
+            try
+            {
+                Aether::Core::Utils::ScopedTimer timer(dispatchTime);
+                Aether::Core::Utils::Span span("module.onPacket");
+                handler->onPacket(packet, channel);
+            }
+            catch (const std::exception& e)
+            {
+                AETHER_LOG_ERROR("Router", "Excecao no onPacket do modulo",
+                                 AetherCoreLogger::field("moduleId", handler->moduleId()),
+                                 AetherCoreLogger::field("error", e.what()));
+            }
+            queued->sub();
+        };
+
+        route->queued->add();
+        if (!route->executor->submit(lane, std::move(task)))
+        {
+            route->queued->sub();
+            queueFull.inc();
+            std::string payload = "Fila do modulo cheia";
             auto response = ProtocolAether::PacketBuilder::build(
-                /* CommandType  */CommandType::ERROR_GENERIC,
+                /* CommandType  */CommandType::MODULE_UNAVAILABLE,
                 /* Module */    static_cast<uint16_t>(ModuleId::CORE),
                 /* Payload */   std::vector<uint8_t>(payload.begin(), payload.end())
             );
 
             channel->sendResponse(response);
-            std::cout << "[Router] Nenhum módulo para moduleId=" << static_cast<int>(packet.module) << std::endl;
-
+            return;
         }
+        route->packets->inc();
     }
 
 private:
-    /// Definição da estrutura do vector modules
+    /// Definição da estrutura de um modulo registrado
     struct RegisteredModule
     {
         std::shared_ptr<IProtocolHandler> handler;
         std::shared_ptr<IModule> module;
+        std::string name;                           /// module->name(), para casar com o source do MODULE_STOPPED
+        std::unique_ptr<Aether::Core::Utils::LaneExecutor> executor;   /// Threads e fila do modulo
+        std::atomic<bool> running{false};           /// Cache de module->isRunning()
+        Aether::Core::Utils::Counter* packets;      /// aether_router_packets_total{module="<id>"}
+        Aether::Core::Utils::Gauge* queued;         /// aether_router_queue_depth{module="<id>"}
+        Aether::Core::Utils::Histogram* queueWait;  /// aether_router_queue_wait_seconds{module="<id>"}
     };
-    std::vector<RegisteredModule> modules; /// Lista de modulos registrados
+
+    /// Tabela de roteamento: uma entrada por ModuleId (nullptr = sem módulo)
+    using DispatchTable = std::array<RegisteredModule*, 256>;
+
+    /**
+     * @brief Zera o cache de running quando um módulo publica MODULE_STOPPED
+     */
+    class StateListener : public IModule
+    {
+    public:
+        explicit StateListener(ProtocolRouter& router) : router(router) {}
+
+        void onEvent(const Event& event) override
+        {
+            if (event.type != Events::MODULE_STOPPED)
+                return;
+
+            std::lock_guard<std::mutex> lock(router.writeMutex);
+            for (const auto& route : router.routes)
+            {
+                if (route->name == event.source)
+                    route->running.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        std::string name() const override { return "ProtocolRouter"; }
+
+    private:
+        ProtocolRouter& router;
+    };
+
+    /**
+     * @brief Pacotes de controle do CORE. A atividade já foi registrada no
+     * LivenessMonitor quando os bytes chegaram, então HEARTBEAT e PONG só
+     * precisam ser consumidos.
+     * @return false se o pacote não é de controle (segue o roteamento normal)
+     */
+    static bool handleControl(const ProtocolAether::Packet& packet, IResponseChannel& channel)
+    {
+        switch (static_cast<CommandType>(packet.type))
+        {
+            case CommandType::PING:
+                channel.sendResponse(ProtocolAether::PacketBuilder::build(
+                    CommandType::PONG, static_cast<uint16_t>(ModuleId::CORE), packet.payload));
+                return true;
+
+            case CommandType::HEARTBEAT:
+            case CommandType::PONG:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Copia a tabela atual trocando uma entrada e publica a cópia (chamar com writeMutex)
+     * @param id Entrada alterada
+     * @param route Novo módulo da entrada (nullptr remove)
+     */
+    void publish(uint8_t id, RegisteredModule* route)
+    {
+        auto next = std::make_unique<DispatchTable>(*table.load(std::memory_order_relaxed));
+        (*next)[id] = route;
+        table.store(next.get(), std::memory_order_release);
+        tables.push_back(std::move(next));
+    }
+
+    std::atomic<const DispatchTable*> table{nullptr};       /// Tabela atual, lida sem lock no onPacket
+    std::mutex writeMutex;                                  /// Serializa registro/remoção
+    std::vector<std::unique_ptr<DispatchTable>> tables;     /// Todas as tabelas publicadas (leitores podem estar em qualquer uma)
+    std::vector<std::unique_ptr<RegisteredModule>> routes;  /// Todos os módulos já registrados
+    StateListener stateListener{*this};                     /// Inscrito no EventBus enquanto o router existir
     /*std::unordered_map<std::string, ConnSession::SessionInfo> clients;*/
 
 
@@ -1,5 +1,5 @@
 #include "SessionManager.hpp"
-#include <iostream>
+#include "../utils/logger.hpp"
 
 /**
  * @file SessionManager.cpp
@@ -7,10 +7,8 @@
  *
  * A implementação é pequena e intencionalmente explícita para facilitar
  * entendimento e manutenção. Ela usa o id() do IResponseChannel como chave
- * para o mapa interno (uint16_t). Uma alternativa seria usar endereço do
- * ponteiro (pointer value) ou um UID gerado ao criar a conexão; a escolha
- * por channel->id() é baseada na suposição de que cada implementação de
- * IResponseChannel fornece um identificador único por conexão.
+ * para o mapa interno (uint64_t). No TCP o id é um sequencial atribuído no
+ * accept, então nunca se repete durante a vida do processo.
  *
  * Thread-safety:
  * - Todas as operações que acessam `map_` protegem a região crítica com
@@ -40,7 +38,7 @@ SessionManager& SessionManager::instance()
 void SessionManager::registerChannel(const std::shared_ptr<IResponseChannel>& channel, const std::string& deviceExternalId)
 {
     if (!channel) return;
-    uint16_t key = channel->id();
+    uint64_t key = channel->id();
     Entry e;
     e.channel = channel;
     e.deviceExternalId = deviceExternalId;
@@ -48,26 +46,32 @@ void SessionManager::registerChannel(const std::shared_ptr<IResponseChannel>& ch
         std::lock_guard<std::mutex> lk(mutex_);
         map_[key] = std::move(e);
     }
-    std::cout << "[SessionManager] registered channel id=" << key << " device=" << deviceExternalId << std::endl;
+    AETHER_LOG_INFO("SessionManager", "registered channel",
+                    AetherCoreLogger::field("id", key),
+                    AetherCoreLogger::field("device", deviceExternalId));
 }
 
 void SessionManager::unregisterChannel(const std::shared_ptr<IResponseChannel>& channel)
 {
     if (!channel) return;
-    uint16_t key = channel->id();
+    uint64_t key = channel->id();
     {
         std::lock_guard<std::mutex> lk(mutex_);
         map_.erase(key);
     }
-    std::cout << "[SessionManager] unregistered channel id=" << key << std::endl;
+    AETHER_LOG_INFO("SessionManager", "unregistered channel", AetherCoreLogger::field("id", key));
 }
 
 std::optional<std::string> SessionManager::getDeviceExternalId(const std::shared_ptr<IResponseChannel>& channel) const
 {
     if (!channel) return {};
-    uint16_t key = channel->id();
+    return getDeviceExternalId(channel->id());
+}
+
+std::optional<std::string> SessionManager::getDeviceExternalId(uint64_t channelId) const
+{
     std::lock_guard<std::mutex> lk(mutex_);
-    auto it = map_.find(key);
+    auto it = map_.find(channelId);
     if (it == map_.end()) return {};
     // Retorna cópia
     return it->second.deviceExternalId;
@@ -86,7 +90,7 @@ std::shared_ptr<IResponseChannel> SessionManager::getChannelByDeviceExternalId(c
         if (!ch)
         {
             // Canal expirou; remove a entrada para manter o mapa limpo
-            uint16_t key = it->first;
+            uint64_t key = it->first;
             ++it; // avança antes de apagar
             auto erased = map_.erase(key);
             (void)erased;
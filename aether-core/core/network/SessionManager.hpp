@@ -20,8 +20,8 @@
  *
  * Design e regras principais:
  * - É um singleton de processo (SessionManager::instance()).
- * - Usa `IResponseChannel::id()` (uint16_t) como chave no mapa interno.
- *   Isso pressupõe que cada canal tem um id único durante sua vida útil.
+ * - Usa `IResponseChannel::id()` (uint64_t) como chave no mapa interno.
+ *   No TCP é um sequencial atribuído no accept, único na vida do processo.
  * - Protegido por mutex para leituras/escritas concorrentes.
  * - Chamadas típicas:
  *     - `registerChannel(channel, deviceId)` — chamada quando o handshake
@@ -33,9 +33,6 @@
  *       caso exista e ainda esteja vivo (útil para threads que iniciam envio reverso).
  *
  * Observações adicionais sobre robustez:
- * - Se `IResponseChannel::id()` não for único, considere trocar a chave
- *   para outro identificador (por exemplo endereço do shared_ptr ou um
- *   UID gerado ao criar a conexão).
  * - Para evitar race conditions na remoção, sempre chamar `unregisterChannel`
  *   do mesmo contexto onde a sessão/conexão é finalizada.
  */
@@ -85,6 +82,15 @@ public:
      */
     std::optional<std::string> getDeviceExternalId(const std::shared_ptr<IResponseChannel>& channel) const;
 
+    /**
+     * @brief Consulta o deviceExternalId pelo id() do canal, para quem só
+     * tem o identificador (ex: PacketCapture).
+     *
+     * @param channelId Valor de IResponseChannel::id().
+     * @return std::optional<std::string> deviceExternalId quando presente.
+     */
+    std::optional<std::string> getDeviceExternalId(uint64_t channelId) const;
+
     /**
      * @brief Procura e retorna o canal associado a um deviceExternalId.
      *
@@ -110,6 +116,6 @@ private:
         std::string deviceExternalId;            /**< id do dispositivo associado */
     };
 
-    // Usa o id() do IResponseChannel como chave (uint16_t).
-    std::unordered_map<uint16_t, Entry> map_;
+    // Usa o id() do IResponseChannel como chave (uint64_t).
+    std::unordered_map<uint64_t, Entry> map_;
 };
@@ -1,9 +1,10 @@
 #include "TcpConnection.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/Metrics.hpp"
 
 #include <cstring>
 #include <unistd.h>
 #include <sys/socket.h>
-#include <iostream>
 
 /**
  * Construtor da conexão TCP
@@ -15,6 +16,16 @@ TcpConnection::TcpConnection(int socketFd) : socketFd(socketFd), isRunning(false
 TcpConnection::~TcpConnection()
 {
     stop(); /// Para a conexão ao destruir
+
+    /// A última referência pode cair na própria readLoop, quando ela solta os
+    /// callbacks; uma thread não pode esperar a si mesma, então é desanexada
+    if (readThread.joinable())
+    {
+        if (readThread.get_id() == std::this_thread::get_id())
+            readThread.detach();
+        else
+            readThread.join();
+    }
 }
 
 /**
@@ -34,8 +45,8 @@ void TcpConnection::stop()
     if (!isRunning) return;
     isRunning = false;
 
-    shutdown(socketFd, SHUT_RDWR);  /// Encerra as operações de leitura e escrita no socket
-    close(socketFd);                /// Fecha o socket da conexão
+    shutdownSocket();               /// Encerra as operações de leitura e escrita no socket
+    closeSocket();                  /// Fecha o socket da conexão
 
     if (readThread.joinable())
     {
@@ -48,6 +59,9 @@ void TcpConnection::stop()
  */
 void TcpConnection::readLoop()
 {
+    static auto& bytesReceived = Aether::Core::Utils::Metrics::counter(
+        "aether_tcp_received_bytes_total", "Bytes recebidos pelas conexoes TCP");
+
     uint8_t buffer[1024]; /// Buffer para leitura de dados
     while (isRunning)
     {
@@ -56,20 +70,88 @@ void TcpConnection::readLoop()
         {
             break;
         }
-        std::cout << "[TcpConnection] recv() bytes=" << buffer << std::endl;
+        AETHER_LOG_DEBUG("TcpConnection", "recv()",
+                         AetherCoreLogger::field("fd", socketFd),
+                         AetherCoreLogger::field("size", bytesRead),
+                         AetherCoreLogger::field("bytes", AetherCoreLogger::hex(buffer, static_cast<size_t>(bytesRead))));
+        bytesReceived.inc(static_cast<uint64_t>(bytesRead));
         onSocketRead(buffer, bytesRead); /// Chama a função onSocketRead para processar os bytes recebidos
     }
 
     isRunning = false;
 
-    if (onDisconnect)
+    /// Os callbacks seguram a sessão, que segura o canal, que segura esta
+    /// conexão: soltá-los aqui desfaz o ciclo. Saem para variáveis locais
+    /// porque a conexão pode ser destruída junto com eles, no fim da função
+    OnDisconnect disconnected = std::move(onDisconnect);
+    OnBytes received = std::move(onBytesReceived);
+    onDisconnect = nullptr;
+    onBytesReceived = nullptr;
+
+    if (disconnected)
     {
-        onDisconnect();
+        disconnected();
     }
 
+    closeSocket();
+}
+
+/**
+ * Encerra leitura e escrita do socket, se ele ainda for desta conexão
+ */
+void TcpConnection::shutdownSocket()
+{
+    std::shared_lock lock(socketMutex);
+    if (socketOpen)
+        shutdown(socketFd, SHUT_RDWR);
+}
+
+/**
+ * Fecha o socket; stop() e o fim da readLoop podem chamar os dois
+ */
+void TcpConnection::closeSocket()
+{
+    std::unique_lock lock(socketMutex);
+    if (!socketOpen)
+        return;
+
+    socketOpen = false;
     close(socketFd);
 }
 
+bool TcpConnection::isOpen() const
+{
+    std::shared_lock lock(socketMutex);
+    return socketOpen;
+}
+
+/**
+ * Envia dados sem bloquear (usado pelo liveness, que não pode esperar um device lento)
+ * @param data Vetor de bytes a serem enviados
+ * @return true se tudo foi enviado
+ */
+bool TcpConnection::trySendBytes(const std::vector<uint8_t>& data) const
+{
+    std::shared_lock lock(socketMutex);
+    if (!socketOpen)
+        return false;
+
+    const ssize_t bytesSent = ::send(socketFd, data.data(), data.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytesSent == static_cast<ssize_t>(data.size()))
+        return true;
+
+    if (bytesSent > 0)
+    {
+        /// Meio frame no fio: o device não consegue mais se alinhar
+        AETHER_LOG_WARN("TcpConnection", "Envio sem bloqueio parcial, encerrando conexão",
+                        AetherCoreLogger::field("fd", socketFd),
+                        AetherCoreLogger::field("sent", bytesSent),
+                        AetherCoreLogger::field("size", data.size()));
+        shutdown(socketFd, SHUT_RDWR);
+    }
+    return false;
+}
+
 /**
  * Processa os dados recebidos do socket
  * @param data Ponteiro para os dados recebidos (Buffer, string de dados)
@@ -81,23 +163,36 @@ void TcpConnection::onSocketRead(const uint8_t* data, size_t len)
 
     if (onBytesReceived)
     {
-        //std::cout << "[TcpConnection] chamando onBytesReceived" << std::endl;
-        onBytesReceived(recvBuffer); /// Passa o buffer completo para o callback
-        recvBuffer.clear();          /// Limpa o buffer após o processamento
+        /// O callback remove do buffer o que consumiu; um frame incompleto
+        /// fica para ser completado pelo próximo recv()
+        onBytesReceived(recvBuffer);
     }
 
     if (!onBytesReceived)
     {
-        std::cout << "[TcpConnection] onBytesReceived not set\n";
+        AETHER_LOG_WARN("TcpConnection", "onBytesReceived not set", AetherCoreLogger::field("fd", socketFd));
+        recvBuffer.clear();
     }
 }
 
 /**
  * Envia dados através do socket TCP (Servidor -> Cliente)
+ *
+ * O lock compartilhado segura o close() até o fim do envio: depois dele o
+ * número do fd pode ir para outra conexão, e os bytes iriam para outro device.
+ * Um send() travado é acordado pelo shutdownSocket(), que também é compartilhado.
  * @param data Vetor de bytes a serem enviados
  */
 void TcpConnection::sendBytes(const std::vector<uint8_t>& data) const
 {
+    std::shared_lock lock(socketMutex);
+    if (!socketOpen)
+    {
+        AETHER_LOG_DEBUG("TcpConnection", "Envio descartado: conexão fechada",
+                         AetherCoreLogger::field("size", data.size()));
+        return;
+    }
+
     size_t totalSent = 0;
 
     // Envia os dados em um loop para garantir que o buffer completo seja enviado
@@ -107,15 +202,21 @@ void TcpConnection::sendBytes(const std::vector<uint8_t>& data) const
             socketFd,
             data.data() + totalSent,
             data.size() - totalSent,
-            0
+            MSG_NOSIGNAL            /// Device que resetou a conexão vira EPIPE, não SIGPIPE no processo
         );
 
         if (bytesSent <= 0)
         {
-            std::cerr << "[TcpConnection] Erro ao enviar dados! errno=" << errno << " (" << strerror(errno) << ")" << std::endl;
+            const int error = errno;
+            AETHER_LOG_ERROR("TcpConnection", "Erro ao enviar dados",
+                             AetherCoreLogger::field("fd", socketFd),
+                             AetherCoreLogger::field("errno", error),
+                             AetherCoreLogger::field("error", strerror(error)));
             return;
         }
         totalSent += bytesSent;
     }
-    std::cout << "[TcpConnection] " << totalSent << " bytes enviados com sucesso" << std::endl;
+    AETHER_LOG_DEBUG("TcpConnection", "bytes enviados com sucesso",
+                     AetherCoreLogger::field("fd", socketFd),
+                     AetherCoreLogger::field("size", totalSent));
 }
\ No newline at end of file
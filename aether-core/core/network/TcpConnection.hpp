@@ -2,7 +2,10 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
+#include <vector>
 
 class TcpConnection
 {
@@ -25,6 +28,24 @@ public:
     void stop();                                            /// Inicia e para a conexão TCP
     void sendBytes(const std::vector<uint8_t>& data) const; /// Envia uma mensagem pela conexão (Servidor para cliente)
 
+    /**
+     * Envia sem bloquear (MSG_DONTWAIT). Com o buffer do socket cheio nada é
+     * enviado e retorna false; se só parte coube, o stream ficou cortado no
+     * meio de um frame e a conexão é encerrada.
+     * @return true se todos os bytes foram para o kernel
+     */
+    bool trySendBytes(const std::vector<uint8_t>& data) const;
+
+    /**
+     * Acorda o recv() com shutdown(), de qualquer thread; a readLoop sai e
+     * segue o fluxo normal de desconexão. Não faz nada com o socket já fechado
+     * (o fd pode ter sido reaproveitado por outra conexão).
+     */
+    void shutdownSocket();
+
+    /** Indica se o socket ainda é desta conexão (false depois do close()) */
+    bool isOpen() const;
+
     /** Retorna o descritor do socket da conexão */
     int getFd() const { return socketFd; }
 
@@ -34,10 +55,13 @@ public:
 private:
     void readLoop();                                                        /// Loop de leitura de dados do socket
     void onSocketRead(const uint8_t* data, size_t len);                     /// Manipula os dados lidos do socket
+    void closeSocket();                                                     /// Fecha o fd uma única vez
 
     int socketFd;                   /// Socket da conexão
     std::atomic<bool> isRunning;    /// Indica se a conexão está ativa
     std::thread readThread;         /// Thread para leitura de dados
+    mutable std::shared_mutex socketMutex; /// send()/shutdown() compartilham; close() é exclusivo e espera os send() em curso
+    bool socketOpen = true;         /// false depois do close(): o fd não pertence mais a esta conexão
 
     std::vector<uint8_t> recvBuffer;/// Buffer de recepção de dados
     OnBytes onBytesReceived;        /// Callback para mensagem recebida
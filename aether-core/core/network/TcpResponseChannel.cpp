@@ -1,15 +1,24 @@
 #include "TcpResponseChannel.hpp"
 #include "TcpConnection.hpp"
 #include "../../protocols/aether/include/PacketBuilder.hpp"
+#include "PacketCapture.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/Tracing.hpp"
 
-#include <iomanip>
-#include <iostream>
+#include <atomic>
+
+namespace
+{
+    /// Próximo id de canal; começa em 1 (0 = sem canal no Parser e na PacketCapture)
+    std::atomic<uint64_t> nextChannelId{1};
+}
 
 /**
  * @brief Construtor da classe TcpResponseChannel.
  * @param conn Ponteiro compartilhado para a conexão TCP associada.
  */
-TcpResponseChannel::TcpResponseChannel(std::shared_ptr<TcpConnection> conn) : connection(std::move(conn)) {}
+TcpResponseChannel::TcpResponseChannel(std::shared_ptr<TcpConnection> conn)
+    : connection(std::move(conn)), channelId(nextChannelId.fetch_add(1, std::memory_order_relaxed)) {}
 
 /**
  * @brief Envia uma resposta através do canal TCP. (Serializa o pacote e envia os bytes pela conexão)
@@ -21,28 +30,95 @@ TcpResponseChannel::TcpResponseChannel(std::shared_ptr<TcpConnection> conn) : co
  */
 void TcpResponseChannel::sendResponse(const ProtocolAether::Packet& pkt)
 {
+    send(pkt, std::nullopt);
+}
+
+/**
+ * @brief Envia a resposta a uma requisição com request id.
+ *
+ * Chamado pelo RequestChannel; numa conexão v1 o id não tem onde ir e a
+ * resposta sai sem ele.
+ * @param pkt Pacote a ser enviado.
+ * @param requestId Id da requisição respondida.
+ */
+void TcpResponseChannel::sendResponse(const ProtocolAether::Packet& pkt, uint32_t requestId)
+{
+    send(pkt, requestId);
+}
+
+/**
+ * @brief Envia sem esperar pelo sendMutex nem pelo socket.
+ * @param pkt Pacote a ser enviado.
+ * @return false se o canal estava ocupado ou o socket cheio.
+ */
+bool TcpResponseChannel::trySendResponse(const ProtocolAether::Packet& pkt)
+{
+    std::unique_lock lock(sendMutex, std::try_to_lock);
+    if (!lock.owns_lock())
+        return false;
+
+    auto bytes = ProtocolAether::PacketBuilder::encode(pkt, format, &compression, std::nullopt);
+    if (!connection->trySendBytes(bytes))
+        return false;
+
+    if (PacketCapture::enabled())
+        PacketCapture::instance().record(PacketCapture::Direction::Outbound, id(), bytes.data(), bytes.size());
+    return true;
+}
+
+/**
+ * @brief Serializa o pacote no formato da conexão e envia os bytes.
+ * @param pkt Pacote a ser enviado.
+ * @param requestId Request id do frame, se houver.
+ */
+void TcpResponseChannel::send(const ProtocolAether::Packet& pkt, std::optional<uint32_t> requestId)
+{
+    Aether::Core::Utils::Span span("tcp.send");
+
+    /// Serializa e envia sob o mesmo lock: o contexto de compressão é da conexão
+    /// e os frames não podem se intercalar no socket
+    std::lock_guard lock(sendMutex);
+
     /// Serializa o pacote em bytes usando o PacketBuilder
-    auto bytes = ProtocolAether::PacketBuilder::encode(pkt);
+    auto bytes = ProtocolAether::PacketBuilder::encode(pkt, format, &compression, requestId);
 
 
-    /// Debugger para mostrar os bytes enviados
-    std::cout << "[TcpResponseChannel] Enviando " << bytes.size() << " bytes: ";
+    /// Debugger para mostrar os bytes enviados (só existe em build de debug)
+    AETHER_LOG_DEBUG("TcpResponseChannel", "enviando",
+                     AetherCoreLogger::field("size", bytes.size()),
+                     AetherCoreLogger::field("bytes", AetherCoreLogger::hex(bytes.data(), bytes.size())));
 
-    for (auto b : bytes)
-        std::cout << std::hex << std::setw(2) << std::setfill('0') << (int)b << " ";
-    std::cout << std::dec << std::endl;
+    if (PacketCapture::enabled())
+        PacketCapture::instance().record(PacketCapture::Direction::Outbound, id(), bytes.data(), bytes.size());
 
     /// Envia os bytes pela conexão TCP
     connection->sendBytes(bytes);
 }
 
+bool TcpResponseChannel::isOpen() const
+{
+    return connection->isOpen();
+}
+
+/**
+ * @brief Define a versão e o codec dos próximos pacotes enviados.
+ * @param v Versão do cabeçalho.
+ * @param c Codec de compressão.
+ * @param withCrc Acrescenta o trailer CRC32C.
+ */
+void TcpResponseChannel::setProtocol(uint8_t v, ProtocolAether::Codec c, bool withCrc)
+{
+    std::lock_guard lock(sendMutex);
+    format.version = v;
+    format.codec = c;
+    format.crc = withCrc;
+}
+
 /**
  * @brief Obtém o identificador único do canal TCP.
  * @return Identificador único do canal.
  */
-uint16_t TcpResponseChannel::id() const
+uint64_t TcpResponseChannel::id() const
 {
-    return static_cast<uint16_t>(
-        reinterpret_cast<uintptr_t>(connection.get()) & 0xFFFF  /// Usa os últimos 16 bits do ponteiro da conexão como ID
-    );
+    return channelId;
 }
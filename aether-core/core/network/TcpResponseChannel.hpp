@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "../../protocols/aether/common/IResponseChannel.hpp"
 #include "../../protocols/aether/include/Packet.hpp"
+#include "../../protocols/aether/include/PacketBuilder.hpp"
 
 class TcpConnection;
 
@@ -13,6 +15,9 @@ class TcpConnection;
  * A classe TcpResponseChannel herda de IResponseChannel e é responsável por
  * enviar pacotes de resposta através de uma conexão TCP. Ela encapsula uma
  * instância de TcpConnection para gerenciar a comunicação.
+ *
+ * Começa em v1; se o HELLO negociar a v2, setProtocol() passa a serializar
+ * os pacotes com o cabeçalho v2 e a comprimir os payloads grandes.
  */
 class TcpResponseChannel : public IResponseChannel
 {
@@ -29,11 +34,49 @@ class TcpResponseChannel : public IResponseChannel
          */
         void sendResponse(const ProtocolAether::Packet& pkt) override;
 
+        /**
+         * @brief Envia a resposta a uma requisição, com o request id (só na v2).
+         * @param pkt Pacote a ser enviado.
+         * @param requestId Id da requisição respondida.
+         */
+        void sendResponse(const ProtocolAether::Packet& pkt, uint32_t requestId) override;
+
+        /**
+         * @brief Envia um pacote sem bloquear (HEARTBEAT do liveness).
+         *
+         * Desiste se outra thread está enviando por este canal ou se o buffer
+         * do socket está cheio.
+         * @param pkt Pacote a ser enviado.
+         * @return true se o pacote foi inteiro para o kernel.
+         */
+        bool trySendResponse(const ProtocolAether::Packet& pkt);
+
         /**
          * @brief Retorna o identificador do canal de resposta.
-         * @return Identificador do canal.
+         * @return Sequencial do processo atribuído no accept (nunca se repete).
+         */
+        virtual uint64_t id() const override;
+
+        /**
+         * @brief Indica se a conexão TCP ainda tem o socket aberto.
+         * @return false depois da desconexão.
          */
-        virtual uint16_t id() const override;
+        bool isOpen() const override;
+
+        /**
+         * @brief Define a versão do protocolo e o codec negociados no HELLO.
+         * @param version Versão do cabeçalho dos próximos pacotes.
+         * @param codec Codec de compressão (None = nunca comprime).
+         * @param crc Acrescenta o trailer CRC32C em todos os frames (só v2).
+         */
+        void setProtocol(uint8_t version, ProtocolAether::Codec codec, bool crc);
     private:
+        /// Serializa e envia um pacote (com ou sem request id)
+        void send(const ProtocolAether::Packet& pkt, std::optional<uint32_t> requestId);
+
         std::shared_ptr<TcpConnection> connection;  /// Conexão TCP utilizada para enviar respostas.
+        const uint64_t channelId;                   /// Sequencial do canal (id())
+        std::mutex sendMutex;                       /// Os módulos podem responder de threads diferentes
+        ProtocolAether::PacketBuilder::WireFormat format;   /// Versão/codec/CRC negociados no HELLO
+        ProtocolAether::CompressionContext compression;     /// Compressão dos payloads enviados
 };
\ No newline at end of file
@@ -1,11 +1,19 @@
 #include "TcpServer.hpp"
 #include "../../protocols/aether/include/Parser.hpp"
 #include "TcpResponseChannel.hpp"
+#include "SessionManager.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/Metrics.hpp"
 
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
-#include <iostream>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
@@ -13,7 +21,7 @@
  * Construtor do servidor TCP
  * @param port Porta na qual o servidor irá escutar
  */
-TcpServer::TcpServer(const int port) : serverSocket(-1), serverPort(port), isRunning(false), parser(std::make_unique<ProtocolAether::Parser>()) {}
+TcpServer::TcpServer(const int port) : serverPort(port), isRunning(false) {}
 
 /** Destrutor do servidor TCP */
 TcpServer::~TcpServer()
@@ -21,18 +29,74 @@ TcpServer::~TcpServer()
     stop(); /// Para o servidor ao destruir
 }
 
+/**
+ * Define quantas threads aceitam conexões (chamar antes do start()).
+ * @param count Acceptors; com mais de um, cada um escuta num socket próprio com SO_REUSEPORT
+ * @param pinToCores Prende o acceptor i ao core i (as threads das conexões herdam o core)
+ */
+void TcpServer::setAcceptors(const unsigned count, const bool pinToCores)
+{
+    acceptorCount = count > 0 ? count : 1;
+    pinAcceptors = pinToCores;
+}
+
 /** Inicia o servidor TCP */
 void TcpServer::start()
 {
     if (isRunning) return;
     isRunning = true;
 
-    serverSocket = socket(AF_INET, SOCK_STREAM, 0);                 /// Cria o socket do servidor
+    /// Com SO_REUSEPORT o kernel distribui as conexões novas entre os sockets pelo hash da origem
+    try
+    {
+        for (unsigned i = 0; i < acceptorCount; ++i)
+            listenSockets.push_back(openListenSocket(acceptorCount > 1));
+    }
+    catch (...)
+    {
+        for (int fd : listenSockets)
+            close(fd);
+        listenSockets.clear();
+        isRunning = false;
+        throw;
+    }
+
+    liveness.configure(livenessConfig);
+    liveness.start();
+
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < listenSockets.size(); ++i)
+    {
+        const int core = pinAcceptors ? static_cast<int>(i % cores) : -1;
+        acceptThreads.emplace_back(&TcpServer::acceptLoop, this, listenSockets[i], core); /// Inicia a thread para aceitar conexões de clientes
+    }
+
+    AETHER_LOG_INFO("TcpServer", "Escutando",
+                    AetherCoreLogger::field("port", serverPort),
+                    AetherCoreLogger::field("acceptors", acceptorCount),
+                    AetherCoreLogger::field("pinned", pinAcceptors));
+}
+
+/**
+ * Cria, faz o bind e coloca em escuta um socket na porta do servidor.
+ * @param reusePort Liga SO_REUSEPORT (vários acceptors na mesma porta)
+ * @return fd do socket em escuta
+ */
+int TcpServer::openListenSocket(const bool reusePort) const
+{
+    int serverSocket = socket(AF_INET, SOCK_STREAM, 0);             /// Cria o socket do servidor
     if (serverSocket < 0)
     {
         throw std::runtime_error("[Core TCP] Erro ao criar Socket do servidor");
     }
 
+    int enable = 1;
+    if (reusePort && setsockopt(serverSocket, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0)
+    {
+        close(serverSocket);
+        throw std::runtime_error("[Core TCP] Erro ao habilitar SO_REUSEPORT no Socket do servidor");
+    }
+
     sockaddr_in serverAddr{};                                       /// Estrutura para o endereço do servidor
     serverAddr.sin_family = AF_INET;                                /// Família de endereços IPv4
     serverAddr.sin_addr.s_addr = INADDR_ANY;                        /// Aceita conexões de qualquer endereço
@@ -45,9 +109,16 @@ void TcpServer::start()
         throw std::runtime_error("[Core TCP] Erro ao fazer bind do Socket do servidor");
     }
 
-    listen(serverSocket, 10); /// Coloca o servidor em modo de escuta
+    /// Fila de conexões completadas pelo kernel; numa tempestade de reconexão ela segura o pico até o accept
+    const int configured = admission.config().backlog;
+    const int backlog = configured > 0 ? configured : SOMAXCONN;
+    if (listen(serverSocket, backlog) < 0)
+    {
+        close(serverSocket);
+        throw std::runtime_error("[Core TCP] Erro ao colocar o Socket do servidor em escuta");
+    }
 
-    acceptThread = std::thread(&TcpServer::acceptLoop, this); /// Inicia a thread para aceitar conexões de clientes
+    return serverSocket;
 }
 
 /**
@@ -56,14 +127,13 @@ void TcpServer::start()
  * O TcpServer mantém um std::shared_ptr para garantir o ciclo de vida
  * do IProtocolHandler durante toda a execução do servidor.
  *
- * O Parser recebe apenas um ponteiro cru (non-owning pointer),
+ * O Parser de cada conexão recebe apenas um ponteiro cru (non-owning pointer),
  * sendo responsável apenas por chamar o handler quando um pacote
  * completo é parseado, sem gerenciar sua memória.
  */
 void TcpServer::setProtocolHandler(std::shared_ptr<IProtocolHandler> handler)
 {
     protocolHandler = handler;              // mantém vivo
-    parser->setHandler(handler.get());      // apenas observa
 }
 
 /** Para o servidor TCP */
@@ -72,57 +142,167 @@ void TcpServer::stop()
     if (!isRunning) return;
     isRunning = false;
 
-    shutdown(serverSocket, SHUT_RDWR);    /// Encerra as operações de leitura e escrita no socket do servidor
-    close(serverSocket);                  /// Fecha o socket do servidor
+    for (int serverSocket : listenSockets)
+    {
+        shutdown(serverSocket, SHUT_RDWR);  /// Encerra as operações de leitura e escrita no socket do servidor
+        close(serverSocket);                /// Fecha o socket do servidor
+    }
+    listenSockets.clear();
 
-    if (acceptThread.joinable())
+    for (auto &acceptThread : acceptThreads)
     {
-        acceptThread.join();              /// Aguarda a thread de aceitação terminar
+        if (acceptThread.joinable())
+            acceptThread.join();            /// Aguarda as threads de aceitação terminarem
     }
+    acceptThreads.clear();
+
+    liveness.stop();
 
-    for (auto &conn : connections)
+    /// O stop() de cada conexão espera a readLoop, que chama o onDisconnect (e ele pega o lock)
+    std::set<std::shared_ptr<TcpConnection>> remaining;
     {
-        conn->stop();  /// Fecha todas as conexões ativas
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        remaining.swap(connections);
     }
 
-    connections.clear(); /// Limpa a lista de threads de clientes
+    for (auto &conn : remaining)
+    {
+        conn->stop();  /// Fecha todas as conexões ativas
+    }
 }
 
-/** Loop para aceitar conexões de clientes */
-void TcpServer::acceptLoop()
+/**
+ * Loop para aceitar conexões de clientes. Roda uma instância por socket em
+ * escuta; a conexão fica com a thread criada aqui, que herda o core do acceptor.
+ * @param serverSocket Socket em escuta deste acceptor
+ * @param core Core do acceptor (-1 = sem afinidade); aplicado antes do primeiro accept
+ */
+void TcpServer::acceptLoop(const int serverSocket, const int core)
 {
+    if (core >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0)
+        {
+            AETHER_LOG_WARN("TcpServer", "Falha ao fixar o acceptor no core, seguindo sem afinidade",
+                            AetherCoreLogger::field("core", core),
+                            AetherCoreLogger::field("error", strerror(error)));
+        }
+    }
+
+    using Aether::Core::Utils::Metrics;
+    static auto& accepted = Metrics::counter("aether_tcp_connections_accepted_total", "Conexoes TCP aceitas");
+    static auto& active = Metrics::gauge("aether_tcp_connections_active", "Conexoes TCP abertas");
+    static auto& handshakeFailures = Metrics::counter("aether_tcp_handshake_failures_total", "Conexoes encerradas por falha no handshake");
+    static auto& acceptErrors = Metrics::counter("aether_tcp_accept_errors_total", "Falhas do accept por falta de fd ou de memoria");
+
     while (isRunning)
     {
-        int clientSocket = accept(serverSocket, nullptr, nullptr); /// Aceita uma nova conexão de cliente
+        sockaddr_storage peer{};
+        socklen_t peerLen = sizeof(peer);
+        int clientSocket = accept(serverSocket, reinterpret_cast<sockaddr*>(&peer), &peerLen); /// Aceita uma nova conexão de cliente
         if (clientSocket < 0)
         {
+            /// Sem fd ou memória o accept falha na hora e o laço giraria a 100% de CPU; espera liberar
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+            {
+                acceptErrors.inc();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
             continue;   /// Continua se houver erro ao aceitar conexão
         }
 
+        /// Admissão antes de qualquer thread ou sessão: recusar custa só o close()
+        std::shared_ptr<AdmissionControl::Ticket> ticket;
+        const auto verdict = admission.admit(peer, ticket);
+        if (verdict != AdmissionControl::Verdict::Accept)
+        {
+            rejectConnection(clientSocket, verdict);
+            continue;
+        }
+
+        accepted.inc();
+        active.add();
+
+        /// Um send() travado por mais que o intervalo do HEARTBEAT é de um device que parou de ler;
+        /// sem o timeout ele seguraria a thread do módulo para sempre (o liveness envia sem bloquear)
+        const auto sendTimeout = livenessConfig.heartbeatInterval;
+        timeval tv{};
+        tv.tv_sec = static_cast<time_t>(sendTimeout.count() / 1000);
+        tv.tv_usec = static_cast<suseconds_t>((sendTimeout.count() % 1000) * 1000);
+        setsockopt(clientSocket, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
         /// Cria uma nova conexão TCP para o cliente
         auto conn = std::make_shared<TcpConnection>(clientSocket);
-        /// Adiciona a conexão à lista de conexões ativas
-        connections.insert(conn);
-
 
         /// Cria o canal de resposta e a sessão para este cliente
         auto channel = std::make_shared<TcpResponseChannel>(conn);
         auto session = std::make_shared<ConnSession>(channel);
-        sessions[clientSocket] = session;
+
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections.insert(conn);           /// Adiciona a conexão à lista de conexões ativas
+            sessions[clientSocket] = session;
+        }
+
+        /// Liveness: prazo do HELLO e depois HEARTBEAT quando a conexão fica calada
+        LivenessMonitor::Callbacks callbacks;
+        callbacks.expireHandshake = [weak = std::weak_ptr<ConnSession>(session)]
+        {
+            auto s = weak.lock();
+            return !s || s->expireHandshake();
+        };
+        /// Sem bloquear: um device que não lê não atrasa os prazos das outras conexões. Um HEARTBEAT
+        /// que não saiu conta como não respondido, e o device é fechado depois de maxMissedBeats
+        callbacks.sendHeartbeat = [weak = std::weak_ptr<TcpResponseChannel>(channel)]
+        {
+            static auto& skipped = Aether::Core::Utils::Metrics::counter(
+                "aether_tcp_heartbeats_skipped_total", "HEARTBEATs nao enviados por socket cheio ou canal ocupado");
+            if (auto c = weak.lock())
+            {
+                if (!c->trySendResponse(ProtocolAether::PacketBuilder::build(CommandType::HEARTBEAT, static_cast<uint16_t>(ModuleId::CORE))))
+                    skipped.inc();
+            }
+        };
+        callbacks.close = [weak = std::weak_ptr<TcpConnection>(conn)]
+        {
+            if (auto c = weak.lock())
+                c->shutdownSocket();
+        };
+        auto livenessEntry = liveness.track(std::move(callbacks));
+
+        /// Parser da conexão: guarda o frame incompleto e o contexto de descompressão
+        auto parser = std::make_shared<ProtocolAether::Parser>();
+        parser->setHandler(protocolHandler.get());
 
         /// Quando o handshake completar, o feed normal do parser é liberado
-        session->setOnHandshakeComplete([this, channel](std::vector<uint8_t>& bytes)
+        session->setOnHandshakeComplete([parser, channel](std::vector<uint8_t>& bytes)
         {
             parser->feed(bytes, channel);
         });
 
+        /// HELLO aceito: a vaga de handshake volta para a admissão
+        session->setOnEstablished([ticket]()
+        {
+            ticket->handshakeDone();
+        });
+
+        /// HELLO v2: o canal passa a responder na versão/codec/CRC negociados
+        session->setOnProtocolNegotiated([channel](uint8_t version, ProtocolAether::Codec codec, bool crc)
+        {
+            channel->setProtocol(version, codec, crc);
+        });
+
         /// Quando o handshake falhar, encerra a conexão TCP
         session->setOnHandshakeFailed([this, conn]()
         {
-            std::cout << "[TcpServer] Encerrando conexão após falha no handshake fd=" << conn->getFd() << std::endl;
-            sessions.erase(conn->getFd());
-            connections.erase(conn);
-            shutdown(conn->getFd(), SHUT_RDWR);
+            handshakeFailures.inc();
+            AETHER_LOG_WARN("TcpServer", "Encerrando conexão após falha no handshake",
+                            AetherCoreLogger::field("fd", conn->getFd()));
+            conn->shutdownSocket();     /// A readLoop sai e o onDisconnect limpa sessions/connections
         });
 
         /// Chama o callback de conexão de cliente
@@ -132,23 +312,68 @@ void TcpServer::acceptLoop()
         }
 
         /** Define o callback para recebimento de bytes */
-        conn->setOnBytesReceived([session](std::vector<uint8_t>& bytes)
+        conn->setOnBytesReceived([this, session, livenessEntry](std::vector<uint8_t>& bytes)
         {
+            liveness.touch(*livenessEntry);
             session->feed(bytes); /// A sessão decide: handshake ou pipeline normal
         });
 
-        /** Define o callback para desconexão do cliente */
-        conn->setOnDisconnect([this, conn]()
+        /** Define o callback para desconexão do cliente; a conexão e o canal vão
+         *  fracos porque o callback fica guardado na própria conexão */
+        conn->setOnDisconnect([this, weakConn = std::weak_ptr<TcpConnection>(conn),
+                               weakChannel = std::weak_ptr<TcpResponseChannel>(channel),
+                               clientSocket, livenessEntry, ticket]()
         {
+            active.sub();
+            ticket->close();
+            liveness.untrack(livenessEntry);
+
+            /// O device sai do SessionManager já, sem esperar a sessão ser destruída:
+            /// a Schedule e os módulos param de achar o canal fechado pelo deviceId
+            if (auto c = weakChannel.lock())
+                SessionManager::instance().unregisterChannel(c);
+
             if (onClientDisconnected)
             {
-                onClientDisconnected(conn->getFd());
+                onClientDisconnected(clientSocket);
             }
-            sessions.erase(conn->getFd()); /// Remove a sessão ao desconectar
-            connections.erase(conn);
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            sessions.erase(clientSocket); /// Remove a sessão ao desconectar
+            if (auto c = weakConn.lock())
+                connections.erase(c);
         });
 
         /** Inicia a conexão para começar a receber dados */
         conn->start();
     }
-}
\ No newline at end of file
+}
+/**
+ * Fecha uma conexão recusada com RST (SO_LINGER 0): não sobra TIME_WAIT no
+ * servidor e o device vê a recusa na hora.
+ * @param clientSocket Socket recém-aceito
+ * @param verdict Motivo da recusa
+ */
+void TcpServer::rejectConnection(const int clientSocket, const AdmissionControl::Verdict verdict)
+{
+    using Aether::Core::Utils::Metrics;
+    static auto& rateLimited = Metrics::counter("aether_tcp_connections_rejected_total", "Conexoes recusadas pela admissao", "reason=\"rate_limited\"");
+    static auto& maxConnections = Metrics::counter("aether_tcp_connections_rejected_total", "Conexoes recusadas pela admissao", "reason=\"max_connections\"");
+    static auto& handshakeLimit = Metrics::counter("aether_tcp_connections_rejected_total", "Conexoes recusadas pela admissao", "reason=\"handshake_limit\"");
+
+    switch (verdict)
+    {
+        case AdmissionControl::Verdict::RateLimited:        rateLimited.inc(); break;
+        case AdmissionControl::Verdict::TooManyConnections: maxConnections.inc(); break;
+        case AdmissionControl::Verdict::TooManyHandshakes:  handshakeLimit.inc(); break;
+        case AdmissionControl::Verdict::Accept:             break;
+    }
+
+    linger reset{};
+    reset.l_onoff = 1;
+    reset.l_linger = 0;
+    setsockopt(clientSocket, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    close(clientSocket);
+
+    AETHER_LOG_DEBUG("TcpServer", "Conexão recusada pela admissão",
+                     AetherCoreLogger::field("reason", AdmissionControl::describe(verdict)));
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include "AdmissionControl.hpp"
+#include "LivenessMonitor.hpp"
 #include "TcpConnection.hpp"
 #include "../../protocols/aether/common/IProtocolHandler.hpp"
 #include "session/ConnSession.hpp"
@@ -6,9 +8,11 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 /** Espaço de nomes para o protocolo Aether */
 namespace ProtocolAether {
@@ -41,21 +45,33 @@ public:
     void setOnDataReceived(const OnDataReceived& cb) { onDataReceived = cb; }                   /// Define o callback para recebimento de dados
     void setOnClientDisconnected(const OnClientDisconnected& cb) { onClientDisconnected = cb; } /// Define o callback para descon
     void setProtocolHandler(std::shared_ptr<IProtocolHandler> handler);                         /// Define o handler de protocolo
+    void setLivenessConfig(const LivenessMonitor::Config& config) { livenessConfig = config; }  /// Prazos de HELLO/HEARTBEAT (antes do start())
+    void setAdmissionConfig(const AdmissionControl::Config& config) { admission.configure(config); } /// Limites de admissão (o backlog vale no próximo start())
+    AdmissionControl::Config getAdmissionConfig() const { return admission.config(); }        /// Limites de admissão atuais
+    std::size_t getConnectionCount() const { return admission.connections(); }                  /// Conexões admitidas e abertas
+    void setAcceptors(unsigned count, bool pinToCores = false);                                 /// Acceptors com SO_REUSEPORT (antes do start())
 
 private:
-    void acceptLoop();                  /// Loop para aceitar conexões de clientes
+    void acceptLoop(int serverSocket, int core); /// Loop para aceitar conexões de clientes (core -1 = sem afinidade)
+    int openListenSocket(bool reusePort) const; /// Socket em escuta na porta do servidor
     void clientLoop(int clientSocket);  /// Loop para comunicação com o cliente
+    void rejectConnection(int clientSocket, AdmissionControl::Verdict verdict); /// Fecha na hora uma conexão recusada pela admissão
 
-    int serverSocket;                   /// Socket do servidor
     int serverPort;                     /// Porta do servidor
     std::atomic<bool> isRunning;        /// Indica se o servidor está em execução
-    std::thread acceptThread;           /// Thread para aceitar conexões de clientes
+    unsigned acceptorCount = 1;         /// Sockets em escuta, cada um com sua thread de accept
+    bool pinAcceptors = false;          /// Prende cada acceptor (e as conexões dele) a um core
+    std::vector<int> listenSockets;     /// Sockets do servidor (SO_REUSEPORT quando há mais de um)
+    std::vector<std::thread> acceptThreads; /// Threads para aceitar conexões de clientes
 
+    std::mutex connectionsMutex;                                            /// Protege connections/sessions (accept, leitura e liveness mexem neles)
     std::set<std::shared_ptr<TcpConnection>> connections;                   /// Lista de Conexões ativas
     std::unordered_map<int, std::shared_ptr<ConnSession>> sessions;         /// Sessão por socket fd
+    LivenessMonitor liveness;                                               /// Prazo do HELLO e HEARTBEAT das conexões inativas
+    LivenessMonitor::Config livenessConfig;                                 /// Prazos usados pelo liveness
+    AdmissionControl admission;                                             /// Limites por IP, de conexões e de handshakes
     OnClientConnected onClientConnected = nullptr;                          /// Callback para quando um cliente se conecta
     OnDataReceived onDataReceived = nullptr;                                /// Callback para quando dados são recebidos
     OnClientDisconnected onClientDisconnected = nullptr;                    /// Callback para quando um cliente se desconecta
-    std::unique_ptr<ProtocolAether::Parser> parser;                         /// Parser de pacotes
     std::shared_ptr<IProtocolHandler> protocolHandler;                      /// Esse manipulador será responsável por processar os pacotes recebidos e  enviar as respostas adequadas ao cliente.
 };
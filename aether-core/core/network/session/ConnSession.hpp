@@ -1,16 +1,21 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <functional>
-#include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "../../../protocols/aether/common/IResponseChannel.hpp"
 #include "../../../protocols/aether/include/PacketBuilder.hpp"
 #include "../../../protocols/aether/include/CommandType.hpp"
+#include "../../../protocols/aether/include/Compression.hpp"
 #include "../../../protocols/aether/common/ModuleId.hpp"
 #include "../../../core/network/SessionManager.hpp"
+#include "../PacketCapture.hpp"
+#include "../../utils/Crc32c.hpp"
+#include "../../utils/logger.hpp"
 
 /**
  * @brief Representa uma sessão de conexão com um dispositivo remoto.
@@ -24,6 +29,19 @@
  * std::shared_ptr para um IResponseChannel). Ela espera que o chamador
  * alimente os bytes recebidos por meio da função feed() conforme eles
  * chegam da camada de rede.
+ *
+ * O HELLO também escolhe a versão do protocolo da conexão:
+ * - HELLO v1: payload = deviceId; a conexão segue em v1 e o ACK vai vazio.
+ * - HELLO v2: payload = [codecs aceitos:1][deviceId], bit n ligado = aceita
+ *   o Codec n. O servidor escolhe um deles (ou None) e responde com um ACK
+ *   v2 cujo payload é [codec escolhido:1]. Daí em diante os dois lados
+ *   falam v2 e podem comprimir qualquer frame com o codec escolhido.
+ *   Se o HELLO v2 vier com CRC32C (flag CRC), o servidor também passa a
+ *   mandar CRC em todas as respostas, começando pelo ACK.
+ *
+ * feed() roda na thread de leitura da conexão, mas o LivenessMonitor pode
+ * chamar expireHandshake() de outra thread: o handshake é feito sob um
+ * mutex. Ready é estado final, então depois dele feed() não pega lock.
  */
 class ConnSession
 {
@@ -53,6 +71,8 @@ public:
 
     using OnHandshakeComplete = std::function<void(std::vector<uint8_t>&)>; /**< Chamado quando o handshake é concluído com sucesso. Recebe os bytes restantes (se houver). */
     using OnHandshakeFailed   = std::function<void()>;                      /**< Chamado quando o handshake falha e a sessão será encerrada. */
+    using OnProtocolNegotiated = std::function<void(uint8_t, ProtocolAether::Codec, bool)>; /**< Chamado com a versão, o codec e o uso de CRC escolhidos no HELLO v2, antes do ACK. */
+    using OnEstablished       = std::function<void()>;                      /**< Chamado uma vez quando o HELLO é aceito, mesmo sem bytes restantes. */
 
     /**
      * @brief Constrói uma nova ConnSession.
@@ -86,6 +106,14 @@ public:
      */
     void feed(std::vector<uint8_t>& bytes)
     {
+        if (state_.load(std::memory_order_acquire) == SessionState::Ready)
+        {
+            if (onHandshakeComplete_)
+                onHandshakeComplete_(bytes);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(handshakeMutex_);
         if (state_ == SessionState::Handshaking)
         {
             handleHandshake(bytes);
@@ -93,14 +121,34 @@ public:
         }
 
         if (state_ == SessionState::Closing)
-            return; // Conexão marcada para fechar, ignora novos dados
+        {
+            bytes.clear(); // Conexão marcada para fechar, ignora novos dados
+            return;
+        }
 
-        if (state_ == SessionState::Ready && onHandshakeComplete_)
+        if (onHandshakeComplete_)
             onHandshakeComplete_(bytes);
     }
 
+    /**
+     * @brief Recusa o handshake se o HELLO ainda não chegou (prazo do LivenessMonitor).
+     *
+     * Pode ser chamada de qualquer thread. Envia FAIL_HANDSHAKE e chama o
+     * OnHandshakeFailed, como um HELLO inválido.
+     * @return true se a sessão ainda estava em handshake e foi recusada
+     */
+    bool expireHandshake()
+    {
+        std::lock_guard<std::mutex> lock(handshakeMutex_);
+        if (state_ != SessionState::Handshaking)
+            return false;
+
+        rejectHandshake("Timeout do HELLO");
+        return true;
+    }
+
     /** @brief Obtém o estado atual da sessão. */
-    SessionState getState() const { return state_; }
+    SessionState getState() const { return state_.load(std::memory_order_acquire); }
     /** @brief Obtém o identificador externo do dispositivo descoberto durante o handshake. */
     const std::string& getDeviceId() const { return deviceExternalId_; }
 
@@ -108,12 +156,36 @@ public:
     void setOnHandshakeComplete(const OnHandshakeComplete& cb) { onHandshakeComplete_ = cb; }
     /** @brief Registra o callback invocado quando o handshake falha. */
     void setOnHandshakeFailed(const OnHandshakeFailed& cb)     { onHandshakeFailed_ = cb; }
+    /** @brief Registra o callback que aplica a versão/codec negociados no canal. */
+    void setOnProtocolNegotiated(const OnProtocolNegotiated& cb) { onProtocolNegotiated_ = cb; }
+    /** @brief Registra o callback invocado quando o HELLO é aceito (libera a vaga de handshake). */
+    void setOnEstablished(const OnEstablished& cb)             { onEstablished_ = cb; }
+    /** @brief Codec de compressão negociado no HELLO (None na v1). */
+    ProtocolAether::Codec getCodec() const { return codec_; }
 
 private:
     static constexpr uint16_t MAGIC       = 0xAA55; /**< Valor mágico esperado no cabeçalho (big-endian) */
     static constexpr uint16_t CMD_HELLO   = 0x0004; /**< Identificador de comando para HELLO */
     static constexpr uint8_t  VERSION     = 0x01;   /**< Versão do protocolo suportada */
+    static constexpr uint8_t  VERSION_2   = 0x02;   /**< Versão com byte de flags (ver Packet.hpp) */
     static constexpr size_t   HEADER_SIZE = 11;     /**< Tamanho do cabeçalho: 2 (magic) + 1 (versão) + 2 (cmd) + 2 (origem) + 4 (tamanho do payload) */
+    static constexpr size_t   HEADER_SIZE_V2 = 12;  /**< Cabeçalho v2: + 1 (flags) depois da versão */
+    static constexpr uint32_t MAX_HELLO_PAYLOAD = 256; /**< HELLO maior que isso é lixo; não espera ele chegar */
+
+    /**
+     * @brief Escolhe o codec entre os aceitos pelo device (do mais forte ao mais fraco)
+     * @param accepted Bitmask do HELLO v2 (bit n = Codec n)
+     */
+    static ProtocolAether::Codec chooseCodec(uint8_t accepted)
+    {
+        using ProtocolAether::Codec;
+        for (Codec codec : { Codec::Zstd, Codec::Lz4, Codec::Deflate })
+        {
+            if ((accepted & (1u << static_cast<uint8_t>(codec))) && ProtocolAether::CompressionContext::supported(codec))
+                return codec;
+        }
+        return Codec::None;
+    }
 
     /**
      * @brief Processador interno de handshake.
@@ -129,11 +201,15 @@ private:
      * Isso é uma copia do protocolo para dentro do ConnSession, daria pra chamar o parser por fora e remover essa função,
      * mas achei mais simples manter aqui para evitar acoplamento do parser com o ciclo de vida da sessão.
      *
+     * Os bytes que chegarem junto com o HELLO (primeiros pacotes da
+     * aplicação) são devolvidos em bytes e repassados ao OnHandshakeComplete.
+     *
      * @param bytes Novos bytes recebidos para processamento.
      */
     void handleHandshake(std::vector<uint8_t>& bytes)
     {
         buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+        bytes.clear();
 
         if (buffer_.size() < HEADER_SIZE)
             return;
@@ -145,41 +221,110 @@ private:
             return;
         }
 
-        uint16_t cmd = (static_cast<uint16_t>(buffer_[3]) << 8) | buffer_[4];
+        // Na v2 o cabeçalho tem um byte de flags a mais; o resto desloca 1 byte
+        const bool v2 = buffer_[2] == VERSION_2;
+        const size_t headerSize = v2 ? HEADER_SIZE_V2 : HEADER_SIZE;
+        if (buffer_.size() < headerSize)
+            return;
+
+        const size_t at = v2 ? 4 : 3;
+        uint16_t cmd = (static_cast<uint16_t>(buffer_[at]) << 8) | buffer_[at + 1];
         if (cmd != CMD_HELLO)
         {
             rejectHandshake("Primeiro pacote deve ser HELLO");
             return;
         }
 
+        // O HELLO nunca vem comprimido; a única flag aceita é a do CRC
+        const uint8_t flags = v2 ? buffer_[3] : 0;
+        if (flags & ~ProtocolAether::PacketBuilder::FLAG_CRC)
+        {
+            rejectHandshake("HELLO com flags inválidas");
+            return;
+        }
+        const bool crc = flags & ProtocolAether::PacketBuilder::FLAG_CRC;
+
         uint32_t payloadLen =
-            (static_cast<uint32_t>(buffer_[7])  << 24) |
-            (static_cast<uint32_t>(buffer_[8])  << 16) |
-            (static_cast<uint32_t>(buffer_[9])  << 8)  |
-            (static_cast<uint32_t>(buffer_[10]));
+            (static_cast<uint32_t>(buffer_[at + 4]) << 24) |
+            (static_cast<uint32_t>(buffer_[at + 5]) << 16) |
+            (static_cast<uint32_t>(buffer_[at + 6]) << 8)  |
+            (static_cast<uint32_t>(buffer_[at + 7]));
+
+        if (payloadLen > MAX_HELLO_PAYLOAD)
+        {
+            rejectHandshake("HELLO grande demais");
+            return;
+        }
 
-        if (buffer_.size() < HEADER_SIZE + payloadLen)
+        const size_t bodySize = headerSize + payloadLen;
+        const size_t frameSize = bodySize + (crc ? ProtocolAether::PacketBuilder::CRC_SIZE : 0);
+        if (buffer_.size() < frameSize)
             return;
 
+        if (crc)
+        {
+            const uint32_t expected =
+                (static_cast<uint32_t>(buffer_[bodySize])     << 24) |
+                (static_cast<uint32_t>(buffer_[bodySize + 1]) << 16) |
+                (static_cast<uint32_t>(buffer_[bodySize + 2]) << 8)  |
+                (static_cast<uint32_t>(buffer_[bodySize + 3]));
+            if (Aether::Core::Utils::Crc32c::compute(buffer_.data(), bodySize) != expected)
+            {
+                rejectHandshake("CRC32C do HELLO inválido");
+                return;
+            }
+        }
+
+        if (v2 && payloadLen == 0)
+        {
+            rejectHandshake("HELLO v2 sem a lista de codecs");
+            return;
+        }
+
+        // HELLO v2: o primeiro byte do payload é a lista de codecs aceitos
+        const size_t idStart = headerSize + (v2 ? 1 : 0);
+        codec_ = v2 ? chooseCodec(buffer_[headerSize]) : ProtocolAether::Codec::None;
         deviceExternalId_ = std::string(
-            buffer_.begin() + HEADER_SIZE,
-            buffer_.begin() + HEADER_SIZE + payloadLen
+            buffer_.begin() + idStart,
+            buffer_.begin() + bodySize
         );
 
+        // O HELLO não passa pelo Parser; registra aqui, já com o deviceId
+        if (PacketCapture::enabled())
+            PacketCapture::instance().record(PacketCapture::Direction::Inbound, channel_->id(),
+                                             buffer_.data(), frameSize, deviceExternalId_);
+
+        // Sobra do buffer = pacotes que vieram no mesmo recv que o HELLO
+        bytes.assign(buffer_.begin() + frameSize, buffer_.end());
         buffer_.clear();
-        state_ = SessionState::Ready;
+        state_.store(SessionState::Ready, std::memory_order_release);
+
+        if (onEstablished_)
+            onEstablished_();
 
         // Registra o canal no SessionManager para que outros módulos possam consultar o deviceExternalId
         SessionManager::instance().registerChannel(channel_, deviceExternalId_);
 
+        // O canal já precisa estar em v2 para mandar o ACK
+        if (v2 && onProtocolNegotiated_)
+            onProtocolNegotiated_(VERSION_2, codec_, crc);
+
         auto response = ProtocolAether::PacketBuilder::build(
             CommandType::ACK,
             static_cast<uint16_t>(ModuleId::CORE),
-            {}
+            v2 ? std::vector<uint8_t>{ static_cast<uint8_t>(codec_) } : std::vector<uint8_t>{}
         );
+        response.version = v2 ? VERSION_2 : VERSION;
         channel_->sendResponse(response);
 
-        std::cout << "[ConnSession] Handshake OK - deviceId=" << deviceExternalId_ << std::endl;
+        AETHER_LOG_INFO("ConnSession", "Handshake OK",
+                        AetherCoreLogger::field("deviceId", deviceExternalId_),
+                        AetherCoreLogger::field("version", static_cast<int>(response.version)),
+                        AetherCoreLogger::field("codec", static_cast<int>(codec_)),
+                        AetherCoreLogger::field("crc", crc));
+
+        if (!bytes.empty() && onHandshakeComplete_)
+            onHandshakeComplete_(bytes);
     }
 
     /**
@@ -191,7 +336,7 @@ private:
      */
     void rejectHandshake(const std::string& reason)
     {
-        std::cout << "[ConnSession] Handshake FALHOU - " << reason << std::endl;
+        AETHER_LOG_WARN("ConnSession", "Handshake FALHOU", AetherCoreLogger::field("reason", reason));
 
         auto response = ProtocolAether::PacketBuilder::build(
             CommandType::FAIL_HANDSHAKE,
@@ -215,10 +360,14 @@ private:
     }
 
     std::shared_ptr<IResponseChannel> channel_; /**< Canal utilizado para enviar respostas ao cliente remoto */
-    SessionState state_;                        /**< Estado atual do ciclo de vida */
+    std::atomic<SessionState> state_;           /**< Estado atual do ciclo de vida */
+    std::mutex handshakeMutex_;                 /**< Serializa o handshake entre feed() e expireHandshake() */
     std::string deviceExternalId_;              /**< Identificador do dispositivo obtido no handshake */
     std::vector<uint8_t> buffer_;               /**< Buffer utilizado durante o handshake */
     OnHandshakeComplete onHandshakeComplete_;   /**< Callback invocado quando o handshake é concluído */
     OnHandshakeFailed   onHandshakeFailed_;     /**< Callback invocado quando o handshake falha */
+    OnProtocolNegotiated onProtocolNegotiated_; /**< Callback que aplica a versão/codec no canal */
+    OnEstablished       onEstablished_;         /**< Callback invocado quando o HELLO é aceito */
+    ProtocolAether::Codec codec_ = ProtocolAether::Codec::None; /**< Codec negociado no HELLO */
 };
 
@@ -0,0 +1,144 @@
+#include "Crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace Aether::Core::Utils
+{
+    namespace
+    {
+        constexpr std::uint32_t POLY = 0x82F63B78;  // 0x1EDC6F41 refletido
+
+        using Tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+        /** Tabelas do slicing-by-8: tables[k][b] = CRC de b seguido de k bytes zero */
+        constexpr Tables makeTables()
+        {
+            Tables tables{};
+            for (std::uint32_t b = 0; b < 256; ++b)
+            {
+                std::uint32_t crc = b;
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (crc >> 1) ^ ((crc & 1) ? POLY : 0);
+                tables[0][b] = crc;
+            }
+            for (std::size_t k = 1; k < 8; ++k)
+                for (std::size_t b = 0; b < 256; ++b)
+                    tables[k][b] = (tables[k - 1][b] >> 8) ^ tables[0][tables[k - 1][b] & 0xFF];
+            return tables;
+        }
+
+        constexpr Tables TABLES = makeTables();
+
+        /** Fallback portátil: 8 bytes por iteração */
+        std::uint32_t computeTable(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept
+        {
+            while (size >= 8)
+            {
+                std::uint32_t lo = 0;
+                std::uint32_t hi = 0;
+                std::memcpy(&lo, data, 4);
+                std::memcpy(&hi, data + 4, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                lo = __builtin_bswap32(lo);
+                hi = __builtin_bswap32(hi);
+#endif
+                lo ^= crc;
+                crc = TABLES[7][lo & 0xFF] ^ TABLES[6][(lo >> 8) & 0xFF] ^
+                      TABLES[5][(lo >> 16) & 0xFF] ^ TABLES[4][lo >> 24] ^
+                      TABLES[3][hi & 0xFF] ^ TABLES[2][(hi >> 8) & 0xFF] ^
+                      TABLES[1][(hi >> 16) & 0xFF] ^ TABLES[0][hi >> 24];
+                data += 8;
+                size -= 8;
+            }
+            while (size--)
+                crc = (crc >> 8) ^ TABLES[0][(crc ^ *data++) & 0xFF];
+            return crc;
+        }
+
+#if defined(__x86_64__)
+        __attribute__((target("sse4.2")))
+        std::uint32_t computeHardware(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept
+        {
+            std::uint64_t crc64 = crc;
+            while (size >= 8)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, data, 8);
+                crc64 = _mm_crc32_u64(crc64, word);
+                data += 8;
+                size -= 8;
+            }
+            crc = static_cast<std::uint32_t>(crc64);
+            while (size--)
+                crc = _mm_crc32_u8(crc, *data++);
+            return crc;
+        }
+
+        bool cpuHasCrc() noexcept { return __builtin_cpu_supports("sse4.2"); }
+#elif defined(__aarch64__) && defined(__linux__)
+        __attribute__((target("+crc")))
+        std::uint32_t computeHardware(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept
+        {
+            while (size >= 8)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, data, 8);
+                crc = __crc32cd(crc, word);
+                data += 8;
+                size -= 8;
+            }
+            while (size--)
+                crc = __crc32cb(crc, *data++);
+            return crc;
+        }
+
+        bool cpuHasCrc() noexcept { return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0; }
+#else
+        std::uint32_t computeHardware(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept
+        {
+            return computeTable(data, size, crc);
+        }
+
+        bool cpuHasCrc() noexcept { return false; }
+#endif
+
+        using ComputeFn = std::uint32_t (*)(const std::uint8_t*, std::size_t, std::uint32_t) noexcept;
+
+        /** Implementação escolhida uma vez para o processo */
+        ComputeFn implementation() noexcept
+        {
+            static const ComputeFn fn = cpuHasCrc() ? &computeHardware : &computeTable;
+            return fn;
+        }
+    }
+
+    /**
+     * Calcula o CRC32C de um bloco, continuando um CRC anterior.
+     * @param data Bytes de entrada
+     * @param size Quantidade de bytes
+     * @param crc CRC dos blocos anteriores (0 para começar)
+     * @return CRC32C acumulado
+     */
+    std::uint32_t Crc32c::compute(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept
+    {
+        return ~implementation()(data, size, ~crc);
+    }
+
+    /**
+     * Informa se o CRC está sendo calculado pela instrução da CPU.
+     * @return true com SSE4.2 (x86-64) ou extensão CRC (ARMv8)
+     */
+    bool Crc32c::hardware() noexcept
+    {
+        return implementation() == &computeHardware;
+    }
+}
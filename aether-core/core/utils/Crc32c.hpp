@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Aether::Core::Utils
+{
+    /**
+     * @brief CRC32C (Castagnoli, polinômio 0x1EDC6F41)
+     *
+     * Usado no trailer de integridade dos frames Aether v2. Escolhe a
+     * implementação uma vez, na primeira chamada:
+     * - x86-64 com SSE4.2: instrução crc32 (8 bytes por instrução);
+     * - ARMv8 com a extensão CRC: instruções crc32c*;
+     * - senão, tabela slicing-by-8 (8 bytes por iteração, sem instrução especial).
+     *
+     * Incremental: compute(b, nb, compute(a, na)) == compute(a + b).
+     * @code
+     *   Crc32c::compute(reinterpret_cast<const uint8_t*>("123456789"), 9) == 0xE3069283
+     * @endcode
+     */
+    class Crc32c
+    {
+        public:
+            /**
+             * @brief Calcula o CRC32C de um bloco
+             * @param data Bytes de entrada
+             * @param size Quantidade de bytes
+             * @param crc CRC dos blocos anteriores (0 para começar)
+             */
+            static std::uint32_t compute(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) noexcept;
+
+            /** @brief true se a CPU tem instrução de CRC32C e ela está em uso */
+            static bool hardware() noexcept;
+    };
+}
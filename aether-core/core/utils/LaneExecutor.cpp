@@ -0,0 +1,97 @@
+#include "LaneExecutor.hpp"
+
+#include <algorithm>
+
+namespace Aether::Core::Utils
+{
+    LaneExecutor::LaneExecutor(std::size_t lanes, std::size_t capacity)
+        : m_capacity(std::max<std::size_t>(capacity, 1))
+    {
+        lanes = std::max<std::size_t>(lanes, 1);
+        m_lanes.reserve(lanes);
+        for (std::size_t i = 0; i < lanes; ++i)
+            m_lanes.push_back(std::make_unique<Lane>());
+
+        /// As threads só sobem depois do vetor pronto: run() não toca em m_lanes
+        for (auto& lane : m_lanes)
+            lane->thread = std::thread([this, l = lane.get()] { run(*l); });
+    }
+
+    LaneExecutor::~LaneExecutor()
+    {
+        for (auto& lane : m_lanes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(lane->mutex);
+                lane->stopping = true;
+            }
+            lane->cv.notify_one();
+        }
+
+        for (auto& lane : m_lanes)
+        {
+            if (lane->thread.joinable())
+                lane->thread.join();
+        }
+    }
+
+    /**
+     * Reserva uma vaga no contador global antes de tocar na lane: a
+     * recusa por fila cheia não pega lock nenhum.
+     * @param key Chave de ordenação
+     * @param task Tarefa
+     * @return false se não havia vaga ou o executor está parando
+     */
+    bool LaneExecutor::submit(std::uint64_t key, Task task)
+    {
+        if (m_pending.fetch_add(1, std::memory_order_relaxed) >= m_capacity)
+        {
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        /// Fibonacci hashing: ids derivados de ponteiros têm os bits baixos
+        /// zerados, então a lane sai dos 32 bits altos do produto
+        const std::uint64_t mixed = (key * 0x9E3779B97F4A7C15ull) >> 32;
+        Lane& lane = *m_lanes[(mixed * m_lanes.size()) >> 32];
+
+        {
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            if (lane.stopping)
+            {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            lane.queue.push_back(std::move(task));
+        }
+
+        lane.cv.notify_one();
+        return true;
+    }
+
+    /**
+     * Executa as tarefas da lane uma por vez, fora do lock. Ao parar,
+     * termina o que já estava na fila antes de sair.
+     * @param lane Lane desta thread
+     */
+    void LaneExecutor::run(Lane& lane)
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(lane.mutex);
+                lane.cv.wait(lock, [&] { return lane.stopping || !lane.queue.empty(); });
+
+                if (lane.queue.empty())
+                    return;
+
+                task = std::move(lane.queue.front());
+                lane.queue.pop_front();
+            }
+
+            task();
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aether::Core::Utils
+{
+    /**
+     * @brief Executor com N lanes (uma thread e uma fila FIFO cada) e
+     * capacidade total limitada
+     *
+     * Cada tarefa vai para a lane escolhida pela chave: tarefas com a mesma
+     * chave rodam na ordem em que foram enviadas, e chaves diferentes rodam
+     * em paralelo (até N ao mesmo tempo). O ProtocolRouter usa um executor
+     * por módulo, com a conexão como chave, para manter a ordem dos pacotes
+     * de cada device sem que um módulo lento trave a thread de leitura.
+     *
+     * submit() nunca bloqueia: com `capacity` tarefas pendentes (somando as
+     * lanes) a tarefa é recusada e quem enviou decide o que responder.
+     *
+     * @code
+     *   LaneExecutor executor(4, 1024);
+     *   if (!executor.submit(deviceKey, [=] { ... }))
+     *       ...; // fila cheia
+     * @endcode
+     */
+    class LaneExecutor
+    {
+        public:
+            using Task = std::function<void()>;
+
+            /**
+             * @param lanes Quantidade de threads (mínimo 1)
+             * @param capacity Máximo de tarefas pendentes, na fila ou executando (mínimo 1)
+             */
+            LaneExecutor(std::size_t lanes, std::size_t capacity);
+
+            /** @brief Executa o que ainda está nas filas e encerra as threads */
+            ~LaneExecutor();
+
+            LaneExecutor(const LaneExecutor&) = delete;
+            LaneExecutor& operator=(const LaneExecutor&) = delete;
+
+            /**
+             * @brief Enfileira uma tarefa na lane da chave
+             * @param key Chave de ordenação (tarefas com a mesma chave não rodam em paralelo)
+             * @param task Tarefa; exceções que escaparem dela encerram o processo
+             * @return false se o executor está cheio ou parando (a tarefa é descartada)
+             */
+            bool submit(std::uint64_t key, Task task);
+
+            /** @brief Tarefas pendentes, na fila ou executando */
+            std::size_t pending() const { return m_pending.load(std::memory_order_relaxed); }
+
+            std::size_t lanes() const { return m_lanes.size(); }
+            std::size_t capacity() const { return m_capacity; }
+
+        private:
+            /** @brief Uma thread com a sua fila; alinhada para as lanes não dividirem linha de cache */
+            struct alignas(64) Lane
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                std::deque<Task> queue;
+                bool stopping = false;          /**< Protegido por mutex */
+                std::thread thread;
+            };
+
+            /** @brief Laço da thread de uma lane */
+            void run(Lane& lane);
+
+            std::vector<std::unique_ptr<Lane>> m_lanes;
+            const std::size_t m_capacity;
+            std::atomic<std::size_t> m_pending{0};  /**< Soma das lanes, para o limite de capacidade */
+    };
+}
@@ -1,19 +1,16 @@
 #include "Md5.hpp"
 
+#include <algorithm>
 #include <cstring>
-#include <sstream>
-#include <iomanip>
-#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace Aether::Core::Utils
 {
     namespace
     {
-        inline std::uint32_t leftRotate(std::uint32_t x, std::uint32_t c)
-        {
-            return (x << c) | (x >> (32 - c));
-        }
-
         // Constantes do algoritmo MD5 (RFC 1321)
         constexpr std::uint32_t K[64] = {
             0xd76aa478,0xe8c7b756,0x242070db,0xc1bdceee,0xf57c0faf,0x4787c62a,0xa8304613,0xfd469501,
@@ -26,107 +23,323 @@ namespace Aether::Core::Utils
             0x6fa87e4f,0xfe2ce6e0,0xa3014314,0x4e0811a1,0xf7537e82,0xbd3af235,0x2ad7d2bb,0xeb86d391
         };
 
-        constexpr std::uint32_t S[64] = {
+        constexpr int S[64] = {
             7,12,17,22, 7,12,17,22, 7,12,17,22, 7,12,17,22,
             5, 9,14,20, 5, 9,14,20, 5, 9,14,20, 5, 9,14,20,
             4,11,16,23, 4,11,16,23, 4,11,16,23, 4,11,16,23,
             6,10,15,21, 6,10,15,21, 6,10,15,21, 6,10,15,21
         };
-    }
 
-    /**
-     * Processa um bloco de 64 bytes atualizando o estado MD5
-     */
-    void Md5::transform(std::uint32_t state[4], const std::uint8_t block[64])
-    {
-        std::uint32_t m[16];
-        for (int i = 0; i < 16; ++i)
+        constexpr std::uint32_t INITIAL_STATE[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+        // Operações das rodadas para 1 lane (escalar). As versões SSE2 mais
+        // abaixo têm os mesmos nomes, então compress() serve para os dois.
+        inline std::uint32_t vAdd(std::uint32_t a, std::uint32_t b) { return a + b; }
+        inline std::uint32_t vAnd(std::uint32_t a, std::uint32_t b) { return a & b; }
+        inline std::uint32_t vOr(std::uint32_t a, std::uint32_t b) { return a | b; }
+        inline std::uint32_t vXor(std::uint32_t a, std::uint32_t b) { return a ^ b; }
+        inline std::uint32_t vAndNot(std::uint32_t a, std::uint32_t b) { return ~a & b; }
+        inline std::uint32_t vNot(std::uint32_t a) { return ~a; }
+        inline std::uint32_t vRotl(std::uint32_t x, int c) { return (x << c) | (x >> (32 - c)); }
+        inline std::uint32_t vConst(std::uint32_t k, std::uint32_t) { return k; }
+
+#if defined(__SSE2__)
+        inline __m128i vAdd(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+        inline __m128i vAnd(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+        inline __m128i vOr(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+        inline __m128i vXor(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+        inline __m128i vAndNot(__m128i a, __m128i b) { return _mm_andnot_si128(a, b); }
+        inline __m128i vNot(__m128i a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+        inline __m128i vRotl(__m128i x, int c)
         {
-            m[i] = static_cast<std::uint32_t>(block[i * 4])
-                 | (static_cast<std::uint32_t>(block[i * 4 + 1]) << 8)
-                 | (static_cast<std::uint32_t>(block[i * 4 + 2]) << 16)
-                 | (static_cast<std::uint32_t>(block[i * 4 + 3]) << 24);
+            return _mm_or_si128(_mm_sll_epi32(x, _mm_cvtsi32_si128(c)),
+                                _mm_srl_epi32(x, _mm_cvtsi32_si128(32 - c)));
         }
+        inline __m128i vConst(std::uint32_t k, __m128i) { return _mm_set1_epi32(static_cast<int>(k)); }
+#endif
 
-        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        /**
+         * As 64 etapas do MD5 sobre um bloco já carregado em m[16], uma
+         * rodada por laço (sem desvio por etapa). V é std::uint32_t (1
+         * mensagem) ou __m128i (4 mensagens, uma por lane).
+         */
+        template <typename V>
+        inline void compress(V state[4], const V m[16])
+        {
+            V a = state[0], b = state[1], c = state[2], d = state[3];
+
+            auto step = [&](V f, int i, int g)
+            {
+                const V temp = d;
+                d = c;
+                c = b;
+                b = vAdd(b, vRotl(vAdd(vAdd(a, f), vAdd(vConst(K[i], a), m[g])), S[i]));
+                a = temp;
+            };
+
+            for (int i = 0; i < 16; ++i)
+                step(vOr(vAnd(b, c), vAndNot(b, d)), i, i);
+
+            for (int i = 16; i < 32; ++i)
+                step(vOr(vAnd(d, b), vAndNot(d, c)), i, (5 * i + 1) % 16);
+
+            for (int i = 32; i < 48; ++i)
+                step(vXor(vXor(b, c), d), i, (3 * i + 5) % 16);
+
+            for (int i = 48; i < 64; ++i)
+                step(vXor(c, vOr(b, vNot(d))), i, (7 * i) % 16);
 
-        for (std::uint32_t i = 0; i < 64; ++i)
+            state[0] = vAdd(state[0], a);
+            state[1] = vAdd(state[1], b);
+            state[2] = vAdd(state[2], c);
+            state[3] = vAdd(state[3], d);
+        }
+
+        inline std::uint32_t loadLe32(const std::uint8_t* p)
+        {
+            return static_cast<std::uint32_t>(p[0])
+                 | (static_cast<std::uint32_t>(p[1]) << 8)
+                 | (static_cast<std::uint32_t>(p[2]) << 16)
+                 | (static_cast<std::uint32_t>(p[3]) << 24);
+        }
+
+        inline void storeLe32(std::uint8_t* p, std::uint32_t v)
         {
-            std::uint32_t f;
-            std::uint32_t g;
+            p[0] = static_cast<std::uint8_t>(v);
+            p[1] = static_cast<std::uint8_t>(v >> 8);
+            p[2] = static_cast<std::uint8_t>(v >> 16);
+            p[3] = static_cast<std::uint8_t>(v >> 24);
+        }
 
-            if (i < 16)
+        /**
+         * Dígito hexadecimal minúsculo sem desvio: para n > 9, (9 - n) é
+         * negativo e o shift aritmético vira -1, somando o salto de
+         * '9' + 1 até 'a' (39).
+         */
+        inline char hexDigit(unsigned n)
+        {
+            return static_cast<char>('0' + n + (((9 - static_cast<int>(n)) >> 8) & 39));
+        }
+
+#if defined(__SSE2__)
+        /** Quantidade de blocos de 64 bytes da mensagem já com padding */
+        inline std::size_t paddedBlockCount(std::size_t length)
+        {
+            return (length + 8) / 64 + 1;
+        }
+
+        /**
+         * Monta o bloco `index` da mensagem com o padding do MD5 (0x80,
+         * zeros e o tamanho em bits nos 8 últimos bytes do último bloco),
+         * sem copiar a mensagem inteira.
+         */
+        void paddedBlock(std::string_view input, std::size_t index, std::uint8_t out[64])
+        {
+            const std::size_t offset = index * 64;
+
+            if (offset + 64 <= input.size())
+            {
+                std::memcpy(out, input.data() + offset, 64);
+                return;
+            }
+
+            std::memset(out, 0, 64);
+
+            if (offset <= input.size())
             {
-                f = (b & c) | (~b & d);
-                g = i;
+                const std::size_t tail = input.size() - offset;
+                std::memcpy(out, input.data() + offset, tail);
+                out[tail] = 0x80;
             }
-            else if (i < 32)
+
+            if (index + 1 == paddedBlockCount(input.size()))
             {
-                f = (d & b) | (~d & c);
-                g = (5 * i + 1) % 16;
+                const std::uint64_t bits = static_cast<std::uint64_t>(input.size()) * 8;
+                for (int i = 0; i < 8; ++i)
+                    out[56 + i] = static_cast<std::uint8_t>(bits >> (8 * i));
             }
-            else if (i < 48)
+        }
+
+        /**
+         * Hash de exatamente 4 entradas, uma por lane SSE2. Lanes com menos
+         * blocos que a maior ficam com o estado congelado (máscara) nos
+         * blocos que sobram.
+         */
+        void hashFour(const std::string_view* inputs, Md5::Digest* outputs)
+        {
+            std::size_t blocks[4];
+            std::size_t maxBlocks = 0;
+            for (int lane = 0; lane < 4; ++lane)
             {
-                f = b ^ c ^ d;
-                g = (3 * i + 5) % 16;
+                blocks[lane] = paddedBlockCount(inputs[lane].size());
+                maxBlocks = std::max(maxBlocks, blocks[lane]);
             }
-            else
+
+            __m128i state[4];
+            for (int i = 0; i < 4; ++i)
+                state[i] = _mm_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+
+            alignas(16) std::uint8_t buffer[4][64] = {};
+
+            for (std::size_t block = 0; block < maxBlocks; ++block)
             {
-                f = c ^ (b | ~d);
-                g = (7 * i) % 16;
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    if (block < blocks[lane])
+                        paddedBlock(inputs[lane], block, buffer[lane]);
+                }
+
+                __m128i m[16];
+                for (int j = 0; j < 16; ++j)
+                {
+                    m[j] = _mm_set_epi32(
+                        static_cast<int>(loadLe32(buffer[3] + 4 * j)),
+                        static_cast<int>(loadLe32(buffer[2] + 4 * j)),
+                        static_cast<int>(loadLe32(buffer[1] + 4 * j)),
+                        static_cast<int>(loadLe32(buffer[0] + 4 * j)));
+                }
+
+                __m128i next[4] = { state[0], state[1], state[2], state[3] };
+                compress(next, m);
+
+                const __m128i active = _mm_set_epi32(
+                    block < blocks[3] ? -1 : 0,
+                    block < blocks[2] ? -1 : 0,
+                    block < blocks[1] ? -1 : 0,
+                    block < blocks[0] ? -1 : 0);
+
+                for (int i = 0; i < 4; ++i)
+                    state[i] = _mm_or_si128(_mm_and_si128(active, next[i]), _mm_andnot_si128(active, state[i]));
             }
 
-            const std::uint32_t temp = d;
-            d = c;
-            c = b;
-            b = b + leftRotate(a + f + K[i] + m[g], S[i]);
-            a = temp;
-        }
+            alignas(16) std::uint32_t words[4][4];
+            for (int i = 0; i < 4; ++i)
+                _mm_store_si128(reinterpret_cast<__m128i*>(words[i]), state[i]);
 
-        state[0] += a;
-        state[1] += b;
-        state[2] += c;
-        state[3] += d;
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                for (int i = 0; i < 4; ++i)
+                    storeLe32(outputs[lane].data() + 4 * i, words[i][lane]);
+            }
+        }
+#endif
     }
 
     /**
-     * Calcula o hash MD5 e retorna em formato hexadecimal minúsculo,
-     * usado diretamente pelo protocolo HTTP Digest Authentication.
+     * Processa um bloco de 64 bytes atualizando o estado MD5
      */
-    std::string Md5::hash(const std::string& input)
+    void Md5::transform(std::uint32_t state[4], const std::uint8_t block[64])
     {
-        std::uint32_t state[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+        std::uint32_t m[16];
+        for (int i = 0; i < 16; ++i)
+            m[i] = loadLe32(block + i * 4);
 
-        const std::uint64_t originalLenBits = static_cast<std::uint64_t>(input.size()) * 8;
+        compress(state, m);
+    }
 
-        std::string message = input;
-        message.push_back(static_cast<char>(0x80));
+    void Md5::reset()
+    {
+        std::memcpy(m_state, INITIAL_STATE, sizeof(m_state));
+        m_length = 0;
+    }
 
-        while (message.size() % 64 != 56)
-        {
-            message.push_back(static_cast<char>(0x00));
-        }
+    /**
+     * Completa o bloco parcial pendente, processa os blocos inteiros
+     * direto da entrada (sem cópia) e guarda o resto para a próxima chamada.
+     */
+    Md5& Md5::update(std::string_view data)
+    {
+        auto input = reinterpret_cast<const std::uint8_t*>(data.data());
+        std::size_t size = data.size();
 
-        for (int i = 0; i < 8; ++i)
+        std::size_t buffered = static_cast<std::size_t>(m_length % 64);
+        m_length += size;
+
+        if (buffered > 0)
         {
-            message.push_back(static_cast<char>((originalLenBits >> (8 * i)) & 0xff));
+            const std::size_t take = std::min(size, 64 - buffered);
+            std::memcpy(m_buffer + buffered, input, take);
+            buffered += take;
+            input += take;
+            size -= take;
+
+            if (buffered < 64)
+                return *this;
+
+            transform(m_state, m_buffer);
         }
 
-        for (std::size_t offset = 0; offset < message.size(); offset += 64)
+        for (; size >= 64; input += 64, size -= 64)
+            transform(m_state, input);
+
+        if (size > 0)
+            std::memcpy(m_buffer, input, size);
+
+        return *this;
+    }
+
+    Md5::Digest Md5::finalize()
+    {
+        const std::uint64_t lengthBits = m_length * 8;
+        std::size_t buffered = static_cast<std::size_t>(m_length % 64);
+
+        m_buffer[buffered++] = 0x80;
+
+        if (buffered > 56)
         {
-            transform(state, reinterpret_cast<const std::uint8_t*>(message.data() + offset));
+            std::memset(m_buffer + buffered, 0, 64 - buffered);
+            transform(m_state, m_buffer);
+            buffered = 0;
         }
 
-        std::ostringstream oss;
-        for (const std::uint32_t s : state)
+        std::memset(m_buffer + buffered, 0, 56 - buffered);
+        for (int i = 0; i < 8; ++i)
+            m_buffer[56 + i] = static_cast<std::uint8_t>(lengthBits >> (8 * i));
+
+        transform(m_state, m_buffer);
+
+        Digest digest;
+        for (int i = 0; i < 4; ++i)
+            storeLe32(digest.data() + 4 * i, m_state[i]);
+
+        return digest;
+    }
+
+    void Md5::toHex(const Digest& digest, char* out)
+    {
+        for (std::size_t i = 0; i < DIGEST_SIZE; ++i)
         {
-            for (int i = 0; i < 4; ++i)
-            {
-                oss << std::hex << std::setw(2) << std::setfill('0')
-                    << ((s >> (8 * i)) & 0xff);
-            }
+            out[2 * i]     = hexDigit(digest[i] >> 4);
+            out[2 * i + 1] = hexDigit(digest[i] & 0x0f);
         }
+    }
+
+    std::string Md5::toHex(const Digest& digest)
+    {
+        std::string hex(HEX_SIZE, '\0');
+        toHex(digest, hex.data());
+        return hex;
+    }
+
+    /**
+     * Calcula o hash MD5 e retorna em formato hexadecimal minúsculo,
+     * usado diretamente pelo protocolo HTTP Digest Authentication.
+     */
+    std::string Md5::hash(std::string_view input)
+    {
+        return toHex(Md5().update(input).finalize());
+    }
+
+    void Md5::hashMany(const std::string_view* inputs, Digest* outputs, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        for (; i + 4 <= count; i += 4)
+            hashFour(inputs + i, outputs + i);
+#endif
 
-        return oss.str();
+        for (; i < count; ++i)
+            outputs[i] = Md5().update(inputs[i]).finalize();
     }
 }
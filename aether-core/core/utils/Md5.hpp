@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace Aether::Core::Utils
 {
@@ -12,19 +15,81 @@ namespace Aether::Core::Utils
      * usada para o cálculo de HA1/HA2/response do HTTP Digest Authentication
      * (RFC 2617), necessário para autenticar nas câmeras IP.
      *
-     * @see CameraService
+     * Uso incremental, sem montar strings temporárias:
+     * @code
+     *   char ha2[Md5::HEX_SIZE];
+     *   Md5::toHex(Md5().update("GET").update(":").update(uri).finalize(), ha2);
+     * @endcode
+     *
+     * hashMany() calcula vários hashes independentes de uma vez, 4 por vez
+     * em paralelo nos registradores SSE2 quando disponíveis (multi-buffer).
+     *
+     * @see DigestAuth
      */
     class Md5
     {
         public:
+            static constexpr std::size_t DIGEST_SIZE = 16;  /**< Tamanho do hash em bytes */
+            static constexpr std::size_t HEX_SIZE = 32;     /**< Tamanho do hash em hexadecimal */
+
+            /** @brief Hash MD5 em bytes */
+            using Digest = std::array<std::uint8_t, DIGEST_SIZE>;
+
+            /** @brief Cria um contexto pronto para update() */
+            Md5() { reset(); }
+
+            /** @brief Volta o contexto ao estado inicial (reaproveita o objeto) */
+            void reset();
+
+            /**
+             * @brief Acrescenta bytes ao hash
+             * @param data Bytes de entrada (não precisam estar num único buffer)
+             * @return O próprio contexto, pra encadear chamadas
+             */
+            Md5& update(std::string_view data);
+
+            /**
+             * @brief Finaliza e devolve o hash. Depois disso, só reset()
+             * deixa o contexto utilizável de novo.
+             */
+            Digest finalize();
+
+            /**
+             * @brief Converte o hash em hexadecimal minúsculo, sem alocação
+             * @param digest Hash em bytes
+             * @param out Destino com pelo menos HEX_SIZE bytes (sem '\0')
+             */
+            static void toHex(const Digest& digest, char* out);
+
+            /** @brief Converte o hash em hexadecimal minúsculo (32 caracteres) */
+            static std::string toHex(const Digest& digest);
+
             /**
              * @brief Calcula o hash MD5 de uma string
              * @param input Texto de entrada
              * @return Hash MD5 em hexadecimal minúsculo (32 caracteres)
              */
-            static std::string hash(const std::string& input);
+            static std::string hash(std::string_view input);
+
+            /**
+             * @brief Calcula o MD5 de várias entradas independentes
+             *
+             * Com SSE2, processa 4 entradas por vez (uma por lane de 32 bits);
+             * o que sobrar (count % 4), ou sem SSE2, vai pelo caminho escalar.
+             * Vale a pena a partir de algumas entradas de mesmo tamanho
+             * aproximado -- ver bench/Md5Bench.cpp.
+             *
+             * @param inputs Entradas
+             * @param outputs Destino dos hashes (mesma quantidade de inputs)
+             * @param count Quantidade de entradas
+             */
+            static void hashMany(const std::string_view* inputs, Digest* outputs, std::size_t count);
 
         private:
             static void transform(std::uint32_t state[4], const std::uint8_t block[64]);
+
+            std::uint32_t m_state[4];      /**< Estado A, B, C, D */
+            std::uint64_t m_length;        /**< Bytes processados até agora */
+            std::uint8_t m_buffer[64];     /**< Bloco parcial ainda não processado */
     };
 }
@@ -0,0 +1,288 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace Aether::Core::Utils
+{
+    namespace
+    {
+        enum class MetricType { Counter, Gauge, Histogram };
+
+        /** Todas as séries de um nome (ex: aether_router_packets_total{module="16"} e {module="17"}) */
+        struct Family
+        {
+            MetricType type;
+            std::string help;
+            std::map<std::string, std::unique_ptr<Counter>> counters;
+            std::map<std::string, std::unique_ptr<Gauge>> gauges;
+            std::map<std::string, std::unique_ptr<Histogram>> histograms;
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::map<std::string, Family> families;  /**< Ordenado, pra saída estável */
+        };
+
+        Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        const char* typeName(MetricType type)
+        {
+            switch (type)
+            {
+                case MetricType::Counter:   return "counter";
+                case MetricType::Gauge:     return "gauge";
+                case MetricType::Histogram: return "summary";
+            }
+            return "untyped";
+        }
+
+        Family& familyFor(Registry& reg, const std::string& name, const std::string& help, MetricType type)
+        {
+            auto [it, inserted] = reg.families.try_emplace(name, Family{type, help, {}, {}, {}});
+            if (!inserted && it->second.type != type)
+                throw std::invalid_argument("Metrica '" + name + "' ja registrada como " + typeName(it->second.type));
+            return it->second;
+        }
+
+        template <typename T>
+        T& seriesFor(std::map<std::string, std::unique_ptr<T>>& series, const std::string& labels)
+        {
+            auto& entry = series[labels];
+            if (!entry)
+                entry = std::make_unique<T>();
+            return *entry;
+        }
+
+        /** Escapa HELP conforme o formato texto (\\ e \n) */
+        void appendHelp(std::string& out, const std::string& help)
+        {
+            for (const char c : help)
+            {
+                if (c == '\\')
+                    out += "\\\\";
+                else if (c == '\n')
+                    out += "\\n";
+                else
+                    out += c;
+            }
+        }
+
+        /** nome{labels[,extra]} */
+        void appendSeries(std::string& out, const std::string& name, const std::string& labels, const char* extra = nullptr)
+        {
+            out += name;
+            if (labels.empty() && !extra)
+                return;
+
+            out += '{';
+            out += labels;
+            if (extra)
+            {
+                if (!labels.empty())
+                    out += ',';
+                out += extra;
+            }
+            out += '}';
+        }
+
+        void appendValue(std::string& out, double value)
+        {
+            char buffer[32];
+            const int size = std::snprintf(buffer, sizeof(buffer), " %.9g\n", value);
+            out.append(buffer, static_cast<std::size_t>(size));
+        }
+
+        void appendValue(std::string& out, std::uint64_t value)
+        {
+            out += ' ';
+            out += std::to_string(value);
+            out += '\n';
+        }
+
+        void appendValue(std::string& out, std::int64_t value)
+        {
+            out += ' ';
+            out += std::to_string(value);
+            out += '\n';
+        }
+    }
+
+    /**
+     * Shards distribuídos em round-robin na 1ª escrita de cada thread.
+     */
+    std::size_t metricShard()
+    {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t shard = next.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+        return shard;
+    }
+
+    std::uint64_t Counter::value() const
+    {
+        std::uint64_t total = 0;
+        for (const auto& cell : m_cells)
+            total += cell.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * Valores < 8 têm bucket próprio. Acima disso, o expoente (posição do
+     * bit mais alto) escolhe o grupo e os 3 bits seguintes o sub-bucket.
+     */
+    std::size_t Histogram::bucketFor(std::uint64_t micros)
+    {
+        if (micros < SUB_BUCKETS)
+            return static_cast<std::size_t>(micros);
+
+        const std::size_t exponent = static_cast<std::size_t>(std::bit_width(micros)) - 1;
+        if (exponent >= MAX_EXPONENT)
+            return BUCKETS - 1;
+
+        const std::size_t shift = exponent - SUB_BUCKET_BITS;
+        const std::size_t sub = static_cast<std::size_t>(micros >> shift) & (SUB_BUCKETS - 1);
+        return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+    }
+
+    std::uint64_t Histogram::bucketUpperBound(std::size_t index)
+    {
+        if (index < SUB_BUCKETS)
+            return index;
+
+        const std::size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        const std::size_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+    }
+
+    void Histogram::observe(std::uint64_t micros)
+    {
+        auto& shard = m_shards[metricShard()];
+        shard.buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+        shard.sumMicros.fetch_add(micros, std::memory_order_relaxed);
+    }
+
+    Histogram::Snapshot Histogram::snapshot() const
+    {
+        Snapshot result;
+        for (const auto& shard : m_shards)
+        {
+            for (std::size_t i = 0; i < BUCKETS; ++i)
+                result.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+            result.sumMicros += shard.sumMicros.load(std::memory_order_relaxed);
+        }
+
+        // count vem dos buckets pra ficar coerente com os quantis
+        for (const auto bucket : result.buckets)
+            result.count += bucket;
+
+        return result;
+    }
+
+    std::uint64_t Histogram::Snapshot::quantile(double q) const
+    {
+        if (count == 0)
+            return 0;
+
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+                return bucketUpperBound(i);
+        }
+        return bucketUpperBound(BUCKETS - 1);
+    }
+
+    Counter& Metrics::counter(const std::string& name, const std::string& help, const std::string& labels)
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        return seriesFor(familyFor(reg, name, help, MetricType::Counter).counters, labels);
+    }
+
+    Gauge& Metrics::gauge(const std::string& name, const std::string& help, const std::string& labels)
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        return seriesFor(familyFor(reg, name, help, MetricType::Gauge).gauges, labels);
+    }
+
+    Histogram& Metrics::histogram(const std::string& name, const std::string& help, const std::string& labels)
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        return seriesFor(familyFor(reg, name, help, MetricType::Histogram).histograms, labels);
+    }
+
+    std::string Metrics::renderPrometheus()
+    {
+        static constexpr std::pair<double, const char*> QUANTILES[] = {
+            {0.5, "quantile=\"0.5\""},
+            {0.9, "quantile=\"0.9\""},
+            {0.99, "quantile=\"0.99\""},
+            {0.999, "quantile=\"0.999\""},
+        };
+
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        std::string out;
+        out.reserve(reg.families.size() * 256);
+
+        for (const auto& [name, family] : reg.families)
+        {
+            out += "# HELP ";
+            out += name;
+            out += ' ';
+            appendHelp(out, family.help);
+            out += "\n# TYPE ";
+            out += name;
+            out += ' ';
+            out += typeName(family.type);
+            out += '\n';
+
+            for (const auto& [labels, counter] : family.counters)
+            {
+                appendSeries(out, name, labels);
+                appendValue(out, counter->value());
+            }
+
+            for (const auto& [labels, gauge] : family.gauges)
+            {
+                appendSeries(out, name, labels);
+                appendValue(out, gauge->value());
+            }
+
+            for (const auto& [labels, histogram] : family.histograms)
+            {
+                const auto snapshot = histogram->snapshot();
+
+                for (const auto& [q, label] : QUANTILES)
+                {
+                    appendSeries(out, name, labels, label);
+                    appendValue(out, static_cast<double>(snapshot.quantile(q)) / 1e6);
+                }
+
+                appendSeries(out, name + "_sum", labels);
+                appendValue(out, static_cast<double>(snapshot.sumMicros) / 1e6);
+                appendSeries(out, name + "_count", labels);
+                appendValue(out, snapshot.count);
+            }
+        }
+
+        return out;
+    }
+}
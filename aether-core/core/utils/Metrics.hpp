@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Aether::Core::Utils
+{
+    /**
+     * @brief Número de células de cada métrica. Cada thread escreve sempre
+     * na mesma célula (escolhida na 1ª escrita), então threads diferentes
+     * quase nunca disputam a mesma linha de cache.
+     */
+    inline constexpr std::size_t METRIC_SHARDS = 8;
+
+    /** @brief Célula de uma thread, isolada na própria linha de cache */
+    struct alignas(64) MetricCell
+    {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    /** @brief Índice da célula da thread atual (0..METRIC_SHARDS-1) */
+    std::size_t metricShard();
+
+    /**
+     * @brief Contador monotônico (ex: pacotes recebidos)
+     *
+     * inc() é um fetch_add relaxed na célula da thread, sem lock.
+     */
+    class Counter
+    {
+        public:
+            /** @brief Soma @p n ao contador */
+            void inc(std::uint64_t n = 1)
+            {
+                m_cells[metricShard()].value.fetch_add(n, std::memory_order_relaxed);
+            }
+
+            /** @brief Valor atual (soma das células) */
+            std::uint64_t value() const;
+
+        private:
+            std::array<MetricCell, METRIC_SHARDS> m_cells;  /**< Uma célula por shard */
+    };
+
+    /**
+     * @brief Valor que sobe e desce (ex: conexões ativas)
+     *
+     * Um único atômico: set() precisa de um valor só, e gauges são
+     * atualizados bem menos que contadores.
+     */
+    class Gauge
+    {
+        public:
+            void set(std::int64_t v) { m_value.store(v, std::memory_order_relaxed); }
+            void add(std::int64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+            void sub(std::int64_t n = 1) { m_value.fetch_sub(n, std::memory_order_relaxed); }
+            std::int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+        private:
+            alignas(64) std::atomic<std::int64_t> m_value{0};  /**< Valor atual */
+    };
+
+    /**
+     * @brief Histograma de durações, em microssegundos, no estilo HDR
+     *
+     * Buckets log-lineares: 8 sub-buckets por potência de 2, então o erro
+     * de qualquer quantil é no máximo 12,5%, de 1us até ~12 dias, com
+     * tamanho fixo. observe() só incrementa o bucket e a soma
+     * da célula da thread.
+     *
+     * Exportado como summary do Prometheus (quantis 0.5, 0.9, 0.99 e 0.999,
+     * acumulados desde o início do processo, mais _sum e _count), em segundos.
+     */
+    class Histogram
+    {
+        public:
+            static constexpr std::size_t SUB_BUCKET_BITS = 3;                                   /**< 2^3 = 8 sub-buckets */
+            static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+            static constexpr std::size_t MAX_EXPONENT = 40;                                     /**< Valores acima de 2^40 us vão pro último bucket */
+            static constexpr std::size_t BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+            /** @brief Registra uma duração em microssegundos */
+            void observe(std::uint64_t micros);
+
+            /** @brief Registra uma duração */
+            template <typename Rep, typename Period>
+            void observe(std::chrono::duration<Rep, Period> duration)
+            {
+                const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+                observe(static_cast<std::uint64_t>(micros < 0 ? 0 : micros));
+            }
+
+            /** @brief Retrato do histograma (soma das células) */
+            struct Snapshot
+            {
+                std::array<std::uint64_t, BUCKETS> buckets{};
+                std::uint64_t count = 0;
+                std::uint64_t sumMicros = 0;
+
+                /** @brief Maior valor do bucket que contém o quantil @p q (0..1), em microssegundos */
+                std::uint64_t quantile(double q) const;
+            };
+
+            Snapshot snapshot() const;
+
+            /** @brief Bucket de um valor */
+            static std::size_t bucketFor(std::uint64_t micros);
+
+            /** @brief Maior valor que cai no bucket @p index */
+            static std::uint64_t bucketUpperBound(std::size_t index);
+
+        private:
+            /** @brief Dados de uma thread */
+            struct alignas(64) Shard
+            {
+                std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+                std::atomic<std::uint64_t> sumMicros{0};
+            };
+
+            std::array<Shard, METRIC_SHARDS> m_shards;  /**< Uma célula por shard */
+    };
+
+    /**
+     * @brief Mede o tempo do escopo e registra no histograma ao sair
+     *
+     * @code
+     *   static auto& latency = Metrics::histogram("aether_db_query_seconds", "Latência das queries");
+     *   ScopedTimer timer(latency);
+     * @endcode
+     */
+    class ScopedTimer
+    {
+        public:
+            explicit ScopedTimer(Histogram& histogram)
+                : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+
+            ~ScopedTimer() { m_histogram.observe(std::chrono::steady_clock::now() - m_start); }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Histogram& m_histogram;
+            std::chrono::steady_clock::time_point m_start;
+    };
+
+    /**
+     * @brief Registro global das métricas do Aether
+     *
+     * As métricas são criadas na 1ª consulta e nunca removidas, então a
+     * referência devolvida vale pra sempre. A consulta tem lock; o caminho
+     * quente guarda a referência (static local ou membro) e só chama
+     * inc()/observe():
+     *
+     * @code
+     *   static auto& packets = Metrics::counter("aether_parser_packets_total", "Pacotes Aether parseados");
+     *   packets.inc();
+     * @endcode
+     *
+     * Nomes seguem a convenção do Prometheus (snake_case, prefixo aether_,
+     * _total em contadores, _seconds em histogramas). @p labels é o
+     * conteúdo entre chaves, ex: `module="16"`; cada combinação de labels
+     * é uma série própria da mesma família.
+     *
+     * Uma família tem um único tipo: pedir um counter com o nome de um
+     * gauge já registrado lança std::invalid_argument.
+     *
+     * @see MetricsController - GET /api/core/metrics
+     */
+    class Metrics
+    {
+        public:
+            static Counter& counter(const std::string& name, const std::string& help, const std::string& labels = {});
+            static Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = {});
+            static Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = {});
+
+            /**
+             * @brief Todas as métricas no formato texto do Prometheus (versão 0.0.4)
+             * @return Corpo da resposta de /api/core/metrics
+             */
+            static std::string renderPrometheus();
+    };
+}
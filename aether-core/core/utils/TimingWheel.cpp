@@ -0,0 +1,67 @@
+#include "TimingWheel.hpp"
+
+#include <bit>
+
+namespace Aether::Core::Utils
+{
+    TimingWheel::TimingWheel(std::size_t slots)
+        : m_slots(std::bit_ceil(slots < 2 ? std::size_t{2} : slots)), m_mask(m_slots.size() - 1)
+    {
+        /// Lista vazia: a sentinela aponta para ela mesma
+        for (auto& head : m_slots)
+            head.prev = head.next = &head;
+    }
+
+    /**
+     * Insere no fim da lista do slot do prazo.
+     * @param timer Timer a agendar
+     * @param ticks Ticks a partir de agora
+     */
+    void TimingWheel::schedule(Timer& timer, std::uint64_t ticks)
+    {
+        if (timer.scheduled())
+            unlink(timer);
+
+        timer.deadline = m_now + (ticks == 0 ? 1 : ticks);
+
+        Timer& head = m_slots[timer.deadline & m_mask];
+        timer.prev = head.prev;
+        timer.next = &head;
+        head.prev->next = &timer;
+        head.prev = &timer;
+    }
+
+    void TimingWheel::cancel(Timer& timer)
+    {
+        if (timer.scheduled())
+            unlink(timer);
+    }
+
+    /**
+     * Percorre só o slot do novo tick; quem ainda tem voltas pela frente fica.
+     * @param expired Recebe os timers vencidos
+     */
+    void TimingWheel::advance(std::vector<Timer*>& expired)
+    {
+        ++m_now;
+        Timer& head = m_slots[m_now & m_mask];
+
+        for (Timer* timer = head.next; timer != &head; )
+        {
+            Timer* next = timer->next;
+            if (timer->deadline <= m_now)
+            {
+                unlink(*timer);
+                expired.push_back(timer);
+            }
+            timer = next;
+        }
+    }
+
+    void TimingWheel::unlink(Timer& timer)
+    {
+        timer.prev->next = timer.next;
+        timer.next->prev = timer.prev;
+        timer.prev = timer.next = nullptr;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Aether::Core::Utils
+{
+    /**
+     * @brief Timing wheel com hash (Varghese & Lauck): agenda, cancela e
+     * reagenda timers em O(1), com qualquer quantidade de timers
+     *
+     * O tempo anda em ticks (quem chama decide quanto vale um tick). O timer
+     * com prazo no tick T fica no slot T % slots; timers com prazo mais de
+     * uma volta à frente ficam no mesmo slot e são pulados até a volta deles.
+     * Cada advance() só olha o slot do tick atual.
+     *
+     * O Timer é intrusivo (o dono herda dele ou o guarda como membro) e
+     * não aloca nada ao agendar. Não é thread-safe: o dono protege a roda.
+     *
+     * @code
+     *   struct Conn : TimingWheel::Timer { ... };
+     *   wheel.schedule(conn, 30);            // expira daqui a 30 ticks
+     *   std::vector<TimingWheel::Timer*> expired;
+     *   wheel.advance(expired);              // a cada tick
+     * @endcode
+     */
+    class TimingWheel
+    {
+        public:
+            /** @brief Nó de um timer; fica ligado na lista do slot enquanto agendado */
+            struct Timer
+            {
+                Timer* prev = nullptr;
+                Timer* next = nullptr;
+                std::uint64_t deadline = 0;    /**< Tick em que expira */
+
+                bool scheduled() const { return prev != nullptr; }
+            };
+
+            /** @param slots Quantidade de slots (arredondada para potência de 2) */
+            explicit TimingWheel(std::size_t slots = 1024);
+
+            TimingWheel(const TimingWheel&) = delete;
+            TimingWheel& operator=(const TimingWheel&) = delete;
+
+            /** @brief Tick atual */
+            std::uint64_t now() const { return m_now; }
+
+            /**
+             * @brief Agenda (ou reagenda) o timer
+             * @param timer Timer; se já estava agendado, sai da posição anterior
+             * @param ticks Ticks a partir de agora (0 conta como 1)
+             */
+            void schedule(Timer& timer, std::uint64_t ticks);
+
+            /** @brief Cancela o timer (nada acontece se não estava agendado) */
+            void cancel(Timer& timer);
+
+            /**
+             * @brief Avança um tick
+             * @param expired Recebe os timers vencidos, já desagendados
+             */
+            void advance(std::vector<Timer*>& expired);
+
+        private:
+            static void unlink(Timer& timer);
+
+            std::vector<Timer> m_slots;         /**< Sentinela da lista circular de cada slot */
+            std::size_t m_mask;
+            std::uint64_t m_now = 0;
+    };
+}
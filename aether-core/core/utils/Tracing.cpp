@@ -0,0 +1,342 @@
+#include "Tracing.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aether::Core::Utils
+{
+    namespace
+    {
+        constexpr std::size_t RING_CAPACITY = 8192;                         // Spans por thread (potência de 2)
+        constexpr auto EXPORT_INTERVAL = std::chrono::milliseconds(200);
+
+        /** Um span terminado */
+        struct SpanEvent
+        {
+            const char* name;
+            std::uint64_t traceId;
+            std::int64_t startNs;
+            std::int64_t endNs;
+        };
+
+        /**
+         * Ring SPSC de uma thread: só a dona escreve (push), só o exportador lê (drain).
+         */
+        class SpanRing
+        {
+            public:
+                explicit SpanRing(std::uint32_t threadId) : m_threadId(threadId) {}
+
+                void push(const SpanEvent& event)
+                {
+                    const auto head = m_head.load(std::memory_order_relaxed);
+                    if (head - m_tail.load(std::memory_order_acquire) == RING_CAPACITY)
+                    {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    m_events[head & (RING_CAPACITY - 1)] = event;
+                    m_head.store(head + 1, std::memory_order_release);
+                }
+
+                template <typename Fn>
+                void drain(Fn&& fn)
+                {
+                    const auto tail = m_tail.load(std::memory_order_relaxed);
+                    const auto head = m_head.load(std::memory_order_acquire);
+
+                    for (auto i = tail; i != head; ++i)
+                        fn(m_events[i & (RING_CAPACITY - 1)]);
+
+                    m_tail.store(head, std::memory_order_release);
+                }
+
+                bool empty() const
+                {
+                    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+                }
+
+                std::uint64_t takeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+                std::uint32_t threadId() const { return m_threadId; }
+
+            private:
+                alignas(64) std::atomic<std::uint64_t> m_head{0};
+                alignas(64) std::atomic<std::uint64_t> m_tail{0};
+                std::atomic<std::uint64_t> m_dropped{0};
+                std::uint32_t m_threadId;
+                SpanEvent m_events[RING_CAPACITY];
+        };
+
+        /**
+         * Estado global: rings registrados por thread e a thread de exportação.
+         * Mesmo esquema do logger: o ring é shared_ptr (thread dona + exportador)
+         * e é liberado quando a dona terminou e ele esvaziou.
+         */
+        struct TracingState
+        {
+            std::mutex registryMutex;
+            std::vector<std::shared_ptr<SpanRing>> rings;
+            std::atomic<std::uint32_t> nextThreadId{1};
+
+            std::mutex controlMutex;            // Protege tudo abaixo
+            std::condition_variable wakeUp;
+            std::thread worker;
+            bool running = false;
+            std::FILE* file = nullptr;
+            std::string path;
+            std::atomic<std::uint32_t> sampleEvery{Tracing::DEFAULT_SAMPLE_EVERY};  // Lido sem lock no TraceScope
+            std::int64_t originNs = 0;          // ts 0 do arquivo
+            std::uint64_t written = 0;
+            std::uint64_t dropped = 0;
+            std::string output;
+
+            std::atomic<std::uint64_t> packets{0};
+            std::atomic<std::uint64_t> nextTraceId{1};
+
+            /** Drena os rings; com file nulo só descarta (ex: sobras de uma sessão anterior) */
+            void flush()
+            {
+                output.clear();
+
+                {
+                    std::lock_guard<std::mutex> lock(registryMutex);
+                    for (auto& ring : rings)
+                    {
+                        ring->drain([&](const SpanEvent& event) { append(event, ring->threadId()); });
+                        dropped += ring->takeDropped();
+                    }
+
+                    rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                               [](const std::shared_ptr<SpanRing>& ring)
+                                               { return ring.use_count() == 1 && ring->empty(); }),
+                                rings.end());
+                }
+
+                if (file && !output.empty())
+                {
+                    std::fwrite(output.data(), 1, output.size(), file);
+                    std::fflush(file);
+                }
+            }
+
+            /** Evento "X" (complete) do formato Chrome trace-event, tempos em microssegundos */
+            void append(const SpanEvent& event, std::uint32_t threadId)
+            {
+                if (!file || event.startNs < originNs)
+                    return;
+
+                char line[256];
+                const int size = std::snprintf(
+                    line, sizeof(line),
+                    "%s{\"name\":\"%s\",\"cat\":\"aether\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"pid\":1,\"tid\":%u,\"args\":{\"trace\":%llu}}",
+                    written == 0 ? "\n" : ",\n",
+                    event.name,
+                    static_cast<double>(event.startNs - originNs) / 1000.0,
+                    static_cast<double>(event.endNs - event.startNs) / 1000.0,
+                    threadId,
+                    static_cast<unsigned long long>(event.traceId));
+
+                if (size > 0 && static_cast<std::size_t>(size) < sizeof(line))
+                {
+                    output.append(line, static_cast<std::size_t>(size));
+                    ++written;
+                }
+            }
+
+            void run()
+            {
+                std::unique_lock<std::mutex> lock(controlMutex);
+                while (running)
+                {
+                    wakeUp.wait_for(lock, EXPORT_INTERVAL);
+                    flush();
+                }
+            }
+
+            /** Para o exportador, grava o pendente e fecha o JSON */
+            void shutdown()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(controlMutex);
+                    running = false;
+                }
+                wakeUp.notify_one();
+
+                if (worker.joinable())
+                    worker.join();
+
+                std::lock_guard<std::mutex> lock(controlMutex);
+                if (!file)
+                    return;
+
+                flush();
+                std::fputs("\n]\n", file);
+                std::fclose(file);
+                file = nullptr;
+            }
+
+            ~TracingState()
+            {
+                // Processo terminando sem stop(): fecha o arquivo como JSON válido
+                shutdown();
+            }
+        };
+
+        TracingState& state()
+        {
+            static TracingState instance;
+            return instance;
+        }
+
+        SpanRing& localRing()
+        {
+            thread_local std::shared_ptr<SpanRing> ring = []
+            {
+                auto& st = state();
+                auto created = std::make_shared<SpanRing>(st.nextThreadId.fetch_add(1, std::memory_order_relaxed));
+                std::lock_guard<std::mutex> lock(st.registryMutex);
+                st.rings.push_back(created);
+                return created;
+            }();
+
+            return *ring;
+        }
+
+        thread_local std::uint64_t currentTrace = 0;    // Trace do pacote em processamento nesta thread
+    }
+
+    std::int64_t Tracing::now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::string Tracing::start(const std::string& path, std::uint32_t sampleEvery)
+    {
+        stop();
+
+        auto& st = state();
+        std::lock_guard<std::mutex> lock(st.controlMutex);
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return "Falha ao criar o arquivo de spans: " + path + " (" + std::strerror(errno) + ")";
+
+        std::fputs("[", file);
+
+        st.flush();                             // Descarta spans de uma sessão anterior
+        st.dropped = 0;
+        st.written = 0;
+        st.file = file;
+        st.path = path;
+        st.sampleEvery.store(std::max<std::uint32_t>(sampleEvery, 1), std::memory_order_relaxed);
+        st.originNs = now();
+        st.packets.store(0, std::memory_order_relaxed);
+        st.running = true;
+        st.worker = std::thread([&st] { st.run(); });
+
+        s_enabled.store(true, std::memory_order_release);
+        return {};
+    }
+
+    void Tracing::stop()
+    {
+        s_enabled.store(false, std::memory_order_release);
+        state().shutdown();
+    }
+
+    std::string Tracing::status()
+    {
+        auto& st = state();
+        std::lock_guard<std::mutex> lock(st.controlMutex);
+
+        if (!st.file)
+        {
+            if (st.path.empty())
+                return "spans: desligado";
+            return "spans: desligado (ultimo arquivo: " + st.path + ", " + std::to_string(st.written) + " spans)";
+        }
+
+        return "spans: ligado, arquivo " + st.path +
+               ", 1 a cada " + std::to_string(st.sampleEvery.load(std::memory_order_relaxed)) + " pacotes, " +
+               std::to_string(st.written) + " spans gravados, " +
+               std::to_string(st.dropped) + " descartados";
+    }
+
+    void Tracing::record(const char* name, std::int64_t startNs, std::int64_t endNs)
+    {
+        if (currentTrace == 0)
+            return;
+
+        localRing().push({ name, currentTrace, startNs, endNs });
+    }
+
+    std::uint64_t Tracing::current()
+    {
+        return currentTrace;
+    }
+
+    /**
+     * Amostra 1 a cada sampleEvery pacotes: o contador global só é tocado
+     * com o tracing ligado.
+     */
+    TraceScope::TraceScope(const char* name, std::int64_t startNs)
+        : m_name(name)
+    {
+        if (!Tracing::enabled())
+            return;
+
+        auto& st = state();
+        const auto sampleEvery = st.sampleEvery.load(std::memory_order_relaxed);
+        if (st.packets.fetch_add(1, std::memory_order_relaxed) % sampleEvery != 0)
+            return;
+
+        m_traceId = st.nextTraceId.fetch_add(1, std::memory_order_relaxed);
+        m_previous = currentTrace;
+        m_start = startNs ? startNs : Tracing::now();
+        currentTrace = m_traceId;
+    }
+
+    TraceScope::~TraceScope()
+    {
+        if (!m_traceId)
+            return;
+
+        Tracing::record(m_name, m_start, Tracing::now());
+        currentTrace = m_previous;
+    }
+
+    TraceResume::TraceResume(std::uint64_t traceId)
+    {
+        m_previous = currentTrace;
+        currentTrace = traceId;
+    }
+
+    TraceResume::~TraceResume()
+    {
+        currentTrace = m_previous;
+    }
+
+    Span::Span(const char* name)
+        : m_name(name)
+    {
+        if (currentTrace != 0)
+            m_start = Tracing::now();
+    }
+
+    Span::~Span()
+    {
+        if (m_start != 0)
+            Tracing::record(m_name, m_start, Tracing::now());
+    }
+}
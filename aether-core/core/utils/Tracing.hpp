@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Aether::Core::Utils
+{
+    /**
+     * @brief Tracing de latência por pacote (spans), exportado no formato
+     * Chrome trace-event JSON (abre em chrome://tracing ou ui.perfetto.dev)
+     *
+     * Cada pacote Aether amostrado ganha um trace (TraceScope, criado no
+     * Parser). O trace atual fica num thread_local e cada etapa só declara
+     * um Span:
+     *
+     * @code
+     *   Span span("db.query");
+     *   PQexec(...);
+     * @endcode
+     *
+     * Quando o pacote troca de thread (o ProtocolRouter entrega ao executor
+     * do módulo), quem enfileira guarda Tracing::current() e a thread que
+     * executa abre um TraceResume com ele.
+     *
+     * Os spans terminados vão para um ring buffer da própria thread (sem
+     * lock) e uma thread de exportação grava o arquivo a cada 200ms. Ring
+     * cheio descarta o span (contado em status()).
+     *
+     * Desligado, Span e TraceScope custam uma leitura de thread_local /
+     * atômico. Ligado, só 1 a cada `sampleEvery` pacotes é rastreado.
+     *
+     * Controlado pelo CLI: spans on [sample=N] [file=...] | off | status.
+     */
+    class Tracing
+    {
+        public:
+            static constexpr std::uint32_t DEFAULT_SAMPLE_EVERY = 100;     /**< 1 a cada 100 pacotes */
+
+            /**
+             * @brief Liga o tracing, criando (ou truncando) o arquivo JSON
+             * @param path Arquivo de saída
+             * @param sampleEvery Rastreia 1 a cada N pacotes (1 = todos)
+             * @return Mensagem de erro, ou string vazia em caso de sucesso
+             */
+            static std::string start(const std::string& path, std::uint32_t sampleEvery = DEFAULT_SAMPLE_EVERY);
+
+            /** @brief Desliga o tracing, grava o que falta e fecha o arquivo */
+            static void stop();
+
+            /** @brief Resumo legível do estado (arquivo, amostragem, spans gravados/descartados) */
+            static std::string status();
+
+            /** @brief true se o tracing estiver ligado */
+            static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+            /** @brief Relógio dos spans (steady_clock, em nanossegundos) */
+            static std::int64_t now();
+
+            /**
+             * @brief Registra um span já medido no trace atual da thread
+             * @param name Nome do span; precisa ser um literal (só o ponteiro é guardado)
+             * @param startNs Início (now())
+             * @param endNs Fim (now())
+             */
+            static void record(const char* name, std::int64_t startNs, std::int64_t endNs);
+
+            /** @brief Trace atual da thread (0 = nenhum), para continuar em outra thread */
+            static std::uint64_t current();
+
+        private:
+            friend class TraceScope;
+            friend class TraceResume;
+            friend class Span;
+
+            static inline std::atomic<bool> s_enabled{false};  /**< Lido sem lock em cada pacote */
+    };
+
+    /**
+     * @brief Trace de um pacote: decide a amostragem e torna o trace o
+     * atual da thread até o fim do escopo, registrando um span raiz
+     */
+    class TraceScope
+    {
+        public:
+            /**
+             * @param name Nome do span raiz (literal)
+             * @param startNs Início do span raiz; 0 = agora (útil quando o
+             *        trabalho começou antes de se saber que havia um pacote)
+             */
+            explicit TraceScope(const char* name, std::int64_t startNs = 0);
+            ~TraceScope();
+
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+
+            /** @brief true se este pacote foi amostrado */
+            bool sampled() const { return m_traceId != 0; }
+
+        private:
+            const char* m_name;
+            std::uint64_t m_traceId = 0;        /**< 0 = não amostrado */
+            std::uint64_t m_previous = 0;       /**< Trace atual antes deste escopo */
+            std::int64_t m_start = 0;
+    };
+
+    /**
+     * @brief Torna um trace capturado em outra thread (Tracing::current())
+     * o atual desta thread até o fim do escopo
+     */
+    class TraceResume
+    {
+        public:
+            /** @param traceId Valor de Tracing::current() na thread de origem (0 = nada a fazer) */
+            explicit TraceResume(std::uint64_t traceId);
+            ~TraceResume();
+
+            TraceResume(const TraceResume&) = delete;
+            TraceResume& operator=(const TraceResume&) = delete;
+
+        private:
+            std::uint64_t m_previous = 0;       /**< Trace atual antes deste escopo */
+    };
+
+    /**
+     * @brief Mede o escopo como um span do trace atual da thread (se houver)
+     */
+    class Span
+    {
+        public:
+            /** @param name Nome do span; precisa ser um literal (só o ponteiro é guardado) */
+            explicit Span(const char* name);
+            ~Span();
+
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+        private:
+            const char* m_name;
+            std::int64_t m_start = 0;           /**< 0 = fora de um trace amostrado */
+    };
+}
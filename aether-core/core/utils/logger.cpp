@@ -1,12 +1,463 @@
 #include "logger.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
-// Definição das variáveis estáticas
-std::ofstream AetherCoreLogger::logFile;
-std::mutex AetherCoreLogger::sMutex;
+namespace
+{
+    using Clock = std::chrono::system_clock;
+
+    constexpr std::size_t BUFFER_CAPACITY = 8 * 1024;                   // Bytes por thread (potência de 2); uma thread por conexão
+    constexpr std::size_t MAX_MESSAGE = 4 * 1024;                       // Mensagens maiores são truncadas
+    constexpr std::size_t OVERFLOW_CAPACITY = 4 * 1024 * 1024;          // Bytes da fila compartilhada de quem encheu o próprio buffer
+    constexpr auto SINK_INTERVAL = std::chrono::milliseconds(50);       // Cadência da thread de escrita
+
+    /** Cabeçalho de cada mensagem dentro do buffer da thread */
+    struct RecordHeader
+    {
+        std::uint32_t size;     // Bytes de texto após o cabeçalho
+        std::uint8_t level;
+        std::int64_t time;      // Nanossegundos desde a época (system_clock)
+    };
+
+    /** Mensagem já retirada do buffer, pronta pra ser escrita */
+    struct Record
+    {
+        std::int64_t time;
+        AetherCoreLogger::Level level;
+        std::string text;
+    };
+
+    /**
+     * Fila circular de bytes de uma única thread produtora (a dona) e um
+     * único consumidor (o sink). head só é escrito pela produtora e tail
+     * só pelo sink, então nenhum dos dois lados precisa de lock.
+     */
+    class ThreadBuffer
+    {
+    public:
+        ThreadBuffer() {}   // Construtor próprio: make_shared não zera m_data
+
+        bool push(AetherCoreLogger::Level level, std::int64_t time, std::string_view text)
+        {
+            const RecordHeader header{ static_cast<std::uint32_t>(text.size()), static_cast<std::uint8_t>(level), time };
+            const std::size_t need = sizeof(header) + text.size();
+
+            const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+            const std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+            if (BUFFER_CAPACITY - (head - tail) < need)
+                return false;
+
+            copyIn(head, &header, sizeof(header));
+            copyIn(head + sizeof(header), text.data(), text.size());
+            m_head.store(head + need, std::memory_order_release);
+            return true;
+        }
+
+        void drain(std::vector<Record>& out)
+        {
+            std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            const std::uint64_t head = m_head.load(std::memory_order_acquire);
+
+            while (tail < head)
+            {
+                RecordHeader header;
+                copyOut(tail, &header, sizeof(header));
+
+                Record record{ header.time, static_cast<AetherCoreLogger::Level>(header.level), std::string(header.size, '\0') };
+                copyOut(tail + sizeof(header), record.text.data(), header.size);
+                out.push_back(std::move(record));
+
+                tail += sizeof(header) + header.size;
+            }
+
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        std::size_t used() const
+        {
+            return static_cast<std::size_t>(m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+        }
+
+        bool empty() const
+        {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void copyIn(std::uint64_t position, const void* data, std::size_t size)
+        {
+            const std::size_t offset = position & (BUFFER_CAPACITY - 1);
+            const std::size_t first = std::min(size, BUFFER_CAPACITY - offset);
+            std::memcpy(m_data + offset, data, first);
+            std::memcpy(m_data, static_cast<const char*>(data) + first, size - first);
+        }
+
+        void copyOut(std::uint64_t position, void* data, std::size_t size) const
+        {
+            const std::size_t offset = position & (BUFFER_CAPACITY - 1);
+            const std::size_t first = std::min(size, BUFFER_CAPACITY - offset);
+            std::memcpy(data, m_data + offset, first);
+            std::memcpy(static_cast<char*>(data) + first, m_data, size - first);
+        }
+
+        alignas(64) std::atomic<std::uint64_t> m_head{0};
+        alignas(64) std::atomic<std::uint64_t> m_tail{0};
+        char m_data[BUFFER_CAPACITY];
+    };
+
+    const char* levelName(AetherCoreLogger::Level level)
+    {
+        switch (level)
+        {
+            case AetherCoreLogger::Level::Trace: return "TRACE";
+            case AetherCoreLogger::Level::Debug: return "DEBUG";
+            case AetherCoreLogger::Level::Info:  return "INFO ";
+            case AetherCoreLogger::Level::Warn:  return "WARN ";
+            case AetherCoreLogger::Level::Error: return "ERROR";
+        }
+        return "?????";
+    }
+
+    /**
+     * "YYYY-MM-DD HH:MM:SS" só é recalculado (localtime_r + strftime)
+     * quando o segundo muda; os milissegundos são acrescentados à parte.
+     */
+    class TimestampCache
+    {
+    public:
+        void append(std::string& out, std::int64_t nanoseconds)
+        {
+            const std::int64_t seconds = nanoseconds / 1'000'000'000;
+
+            if (seconds != m_second)
+            {
+                const std::time_t time = static_cast<std::time_t>(seconds);
+                std::tm local{};
+                localtime_r(&time, &local);
+                m_size = std::strftime(m_text, sizeof(m_text), "%Y-%m-%d %H:%M:%S", &local);
+                m_second = seconds;
+            }
+
+            const int millis = static_cast<int>((nanoseconds / 1'000'000) % 1000);
+            out.append(m_text, m_size);
+            out += '.';
+            out += static_cast<char>('0' + millis / 100);
+            out += static_cast<char>('0' + millis / 10 % 10);
+            out += static_cast<char>('0' + millis % 10);
+        }
+
+    private:
+        std::int64_t m_second = -1;
+        char m_text[32] = {};
+        std::size_t m_size = 0;
+    };
+
+    void formatLine(std::string& out, TimestampCache& timestamps, const Record& record)
+    {
+        timestamps.append(out, record.time);
+        out += " | ";
+        out += levelName(record.level);
+        out += " | ";
+        out += record.text;
+        out += '\n';
+    }
+
+    std::int64_t nowNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Estado global do logger: buffers registrados por thread e a thread de
+     * escrita. Os buffers são shared_ptr: a thread dona e o sink têm cada um
+     * uma referência, e o sink libera o buffer quando a dona terminou e não
+     * sobrou nada pra drenar.
+     *
+     * O buffer de cada thread é pequeno (há uma thread por conexão). Uma
+     * rajada que não cabe nele vai para a fila compartilhada `overflow`, com
+     * lock; só quando ela também enche a mensagem é descartada.
+     */
+    struct LoggerState
+    {
+        std::mutex registryMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+        std::mutex overflowMutex;           // Protege overflow/overflowBytes/dropped
+        std::vector<Record> overflow;
+        std::size_t overflowBytes = 0;
+        std::uint64_t dropped = 0;
+
+        /** Guarda na fila compartilhada uma mensagem que não coube no buffer da thread */
+        bool pushOverflow(AetherCoreLogger::Level level, std::int64_t time, std::string_view text)
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            if (overflowBytes + text.size() > OVERFLOW_CAPACITY)
+            {
+                ++dropped;
+                return false;
+            }
+
+            overflowBytes += text.size();
+            overflow.push_back({ time, level, std::string(text) });
+            return true;
+        }
+
+        std::mutex sinkMutex;               // Protege file/running/worker e a escrita síncrona
+        std::condition_variable wakeUp;
+        std::thread worker;
+        bool running = false;
+        std::atomic<bool> async{false};
+        std::FILE* file = nullptr;
+
+        std::atomic<std::uint8_t> minLevel{AETHER_LOG_MIN_LEVEL};
+
+        TimestampCache timestamps;          // Usado só pelo sink (ou sob sinkMutex)
+        std::vector<Record> pending;
+        std::string output;
+
+        /** Drena todos os buffers e grava em ordem de horário */
+        void flush()
+        {
+            std::uint64_t droppedNow = 0;
+            {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                for (auto& buffer : buffers)
+                    buffer->drain(pending);
+
+                // Buffers de threads que já terminaram (só o sink os referencia)
+                buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                             [](const std::shared_ptr<ThreadBuffer>& buffer)
+                                             { return buffer.use_count() == 1 && buffer->empty(); }),
+                              buffers.end());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(overflowMutex);
+                std::move(overflow.begin(), overflow.end(), std::back_inserter(pending));
+                overflow.clear();
+                overflowBytes = 0;
+                droppedNow = std::exchange(dropped, 0);
+            }
+
+            if (droppedNow > 0)
+            {
+                pending.push_back({ nowNanoseconds(), AetherCoreLogger::Level::Warn,
+                                    "[Logger] " + std::to_string(droppedNow) + " mensagem(ns) descartada(s), buffer cheio" });
+            }
+
+            if (pending.empty())
+                return;
+
+            std::stable_sort(pending.begin(), pending.end(),
+                             [](const Record& a, const Record& b) { return a.time < b.time; });
+
+            output.clear();
+            for (const auto& record : pending)
+                formatLine(output, timestamps, record);
+            pending.clear();
+
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            std::fflush(stdout);
+
+            if (file)
+            {
+                std::fwrite(output.data(), 1, output.size(), file);
+                std::fflush(file);
+            }
+        }
+
+        ~LoggerState()
+        {
+            // Processo terminando sem Shutdown(): grava o pendente e para o sink
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                async.store(false, std::memory_order_release);
+                running = false;
+            }
+            wakeUp.notify_one();
+            if (worker.joinable())
+                worker.join();
+            if (file)
+                std::fclose(file);
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(sinkMutex);
+            while (running)
+            {
+                wakeUp.wait_for(lock, SINK_INTERVAL);
+                flush();
+            }
+            flush();
+        }
+    };
+
+    LoggerState& state()
+    {
+        static LoggerState instance;
+        return instance;
+    }
+
+    ThreadBuffer& localBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = []
+        {
+            auto created = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(state().registryMutex);
+            state().buffers.push_back(created);
+            return created;
+        }();
+
+        return *buffer;
+    }
+}
+
+void AetherCoreLogger::Initialize(const std::string& filename)
+{
+    AETHER_LOG_INFO("Daemon", "Inicializando sistema de log", field("file", filename));
+
+    auto& logger = state();
+    {
+        std::lock_guard<std::mutex> lock(logger.sinkMutex);
+        if (logger.running)
+            return;
+
+        logger.file = std::fopen(filename.c_str(), "a");
+        logger.running = true;
+        logger.worker = std::thread([&logger] { logger.run(); });
+        logger.async.store(true, std::memory_order_release);
+    }
+
+    if (!logger.file)
+        AETHER_LOG_ERROR("Daemon", "Falha ao abrir arquivo de log, seguindo so no console", field("file", filename));
+    else
+        AETHER_LOG_INFO("Daemon", "Sistema de log inicializado com sucesso");
+}
+
+void AetherCoreLogger::Log(const std::string& message)
+{
+    write(Level::Info, {}, message);
+}
+
+void AetherCoreLogger::Shutdown()
+{
+    auto& logger = state();
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(logger.sinkMutex);
+        if (!logger.running)
+            return;
+
+        logger.async.store(false, std::memory_order_release);
+        logger.running = false;
+        worker = std::move(logger.worker);
+    }
+
+    logger.wakeUp.notify_one();
+    worker.join();
+
+    std::lock_guard<std::mutex> lock(logger.sinkMutex);
+    if (logger.file)
+    {
+        std::fclose(logger.file);
+        logger.file = nullptr;
+    }
+}
+
+void AetherCoreLogger::setMinLevel(Level level)
+{
+    state().minLevel.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+}
+
+bool AetherCoreLogger::enabled(Level level)
+{
+    return static_cast<std::uint8_t>(level) >= state().minLevel.load(std::memory_order_relaxed);
+}
+
+std::string& AetherCoreLogger::scratch()
+{
+    thread_local std::string line;
+    return line;
+}
+
+void AetherCoreLogger::submit(Level level, std::string_view text)
+{
+    if (text.size() > MAX_MESSAGE)
+        text = text.substr(0, MAX_MESSAGE);
+
+    auto& logger = state();
+    const std::int64_t now = nowNanoseconds();
+
+    if (logger.async.load(std::memory_order_acquire))
+    {
+        // Acorda o sink antes da hora só se o buffer estiver enchendo
+        auto& buffer = localBuffer();
+        if (!buffer.push(level, now, text))
+        {
+            logger.pushOverflow(level, now, text);
+            logger.wakeUp.notify_one();
+        } else if (buffer.used() > BUFFER_CAPACITY / 2)
+        {
+            logger.wakeUp.notify_one();
+        }
+        return;
+    }
+
+    // Sem thread de escrita: grava na hora, no stderr
+    std::lock_guard<std::mutex> lock(logger.sinkMutex);
+    std::string line;
+    formatLine(line, logger.timestamps, Record{ now, level, std::string(text) });
+    std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+void AetherCoreLogger::appendText(std::string& out, std::string_view text)
+{
+    const bool quote = text.empty() || text.find_first_of(" =\"") != std::string_view::npos;
+    if (!quote)
+    {
+        out += text;
+        return;
+    }
+
+    out += '"';
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+void AetherCoreLogger::appendHex(std::string& out, const Hex& bytes)
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    const auto* data = static_cast<const std::uint8_t*>(bytes.data);
+    const std::size_t start = out.size();
+    out.resize(start + bytes.size * 2);
+
+    for (std::size_t i = 0; i < bytes.size; ++i)
+    {
+        out[start + 2 * i]     = DIGITS[data[i] >> 4];
+        out[start + 2 * i + 1] = DIGITS[data[i] & 0x0f];
+    }
+}
 
 /**
  * @brief Retorna o timestamp atual no formato "YYYY-MM-DD HH:MM:SS".
@@ -14,14 +465,13 @@ std::mutex AetherCoreLogger::sMutex;
  */
 std::string AetherCoreLogger::returnCurrentTimeStamp()
 {
-    const auto now = std::chrono::system_clock::now();                          // Obtém o horário atual
-    const std::time_t time_now = std::chrono::system_clock::to_time_t(now);     // Converte converte de time_point para time_t
+    const std::time_t time_now = Clock::to_time_t(Clock::now());                 // Converte de time_point para time_t
 
     std::tm local_tm{};                                                          // Estrutura para tempo local
     localtime_r(&time_now, &local_tm);                                           // Converte para horário local de forma thread-safe
 
-    std::ostringstream oss;
-    oss << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S");                       // Formata para o formato esperado
+    char text[32];
+    const std::size_t size = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local_tm);
 
-    return oss.str();
-}
\ No newline at end of file
+    return std::string(text, size);
+}
@@ -1,68 +1,117 @@
 #pragma once
 
-#include <fstream>
-#include <iostream>
-#include <mutex>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Níveis de log, do mais verboso ao mais grave. AETHER_LOG_MIN_LEVEL define,
+ * em tempo de compilação, o menor nível que chega a existir no binário:
+ * as macros abaixo dele viram ((void)0) e nem os argumentos são avaliados.
+ *
+ * Default: DEBUG em build de desenvolvimento, INFO em release (NDEBUG).
+ * Pode ser sobrescrito com -DAETHER_LOG_MIN_LEVEL=0..4.
+ */
+#define AETHER_LOG_LEVEL_TRACE 0
+#define AETHER_LOG_LEVEL_DEBUG 1
+#define AETHER_LOG_LEVEL_INFO  2
+#define AETHER_LOG_LEVEL_WARN  3
+#define AETHER_LOG_LEVEL_ERROR 4
+
+#ifndef AETHER_LOG_MIN_LEVEL
+#  ifdef NDEBUG
+#    define AETHER_LOG_MIN_LEVEL AETHER_LOG_LEVEL_INFO
+#  else
+#    define AETHER_LOG_MIN_LEVEL AETHER_LOG_LEVEL_DEBUG
+#  endif
+#endif
 
 /** @class AetherCoreLogger
  * @brief Classe responsável pelo registro de logs do sistema AetherCore.
  *
- * Esta classe fornece funcionalidades para inicializar o sistema de log,
- * registrar mensagens de log e finalizar o sistema de log.
+ * Log assíncrono com níveis e campos estruturados (key=value):
+ * - Cada thread escreve num buffer próprio (fila SPSC sem lock); o
+ *   caminho quente só formata a mensagem e copia os bytes pra fila
+ * - Uma thread de escrita (sink) drena os buffers, formata o timestamp
+ *   (cacheado por segundo) e grava no console e no arquivo de log
+ * - Buffer cheio descarta a mensagem em vez de travar quem loga; a
+ *   quantidade descartada é registrada pelo próprio sink
+ *
+ * Antes de Initialize() (ou depois de Shutdown()), as mensagens são
+ * escritas direto no stderr, de forma síncrona.
+ *
+ * Uso, sempre pelas macros (que respeitam AETHER_LOG_MIN_LEVEL):
+ * @code
+ *   AETHER_LOG_INFO("SessionManager", "canal registrado",
+ *                   AetherCoreLogger::field("id", key),
+ *                   AetherCoreLogger::field("device", deviceId));
+ *   // 2025-01-01 12:00:00.123 | INFO  | [SessionManager] canal registrado id=7 device=ESP32
+ * @endcode
  */
 class AetherCoreLogger
 {
 public:
-    /**
-     * @brief Inicializa o sistema de log com o arquivo especificado.
-     *
-     * @param filename Nome do arquivo onde os logs serão armazenados.
-     */
-    static void Initialize(const std::string &filename)
+    /** @brief Nível de uma mensagem de log */
+    enum class Level : std::uint8_t
     {
-        std::cerr << "[Daemon] Inicializando Sistema de log" << std::endl;
+        Trace = AETHER_LOG_LEVEL_TRACE,
+        Debug = AETHER_LOG_LEVEL_DEBUG,
+        Info  = AETHER_LOG_LEVEL_INFO,
+        Warn  = AETHER_LOG_LEVEL_WARN,
+        Error = AETHER_LOG_LEVEL_ERROR
+    };
 
-        logFile.open(filename, std::ios::out | std::ios::app);
-        if (!logFile.is_open())
-        {
-            std::cerr << "[Daemon] Falha ao abrir aquivo de log: " << filename << std::endl;
-            return;
-        }
+    /** @brief Campo estruturado key=value de uma mensagem */
+    template <typename T>
+    struct Field
+    {
+        std::string_view key;   /**< Nome do campo */
+        const T& value;         /**< Valor (referência válida só durante a chamada) */
+    };
 
-        static TeeBuffer coutTee(std::cout.rdbuf(), logFile.rdbuf());           /// Redireciona std::cout
-        static TeeBuffer cerrTee(std::cerr.rdbuf(), logFile.rdbuf());           /// Redireciona std::cerr
+    /** @brief Bytes brutos, registrados em hexadecimal (dump de pacotes) */
+    struct Hex
+    {
+        const void* data;       /**< Início dos bytes */
+        std::size_t size;       /**< Quantidade de bytes */
+    };
 
-        std::cout.rdbuf(&coutTee);  /// Aplica o redirecionamento
-        std::cerr.rdbuf(&cerrTee);  /// Aplica o redirecionamento
+    /**
+     * @brief Cria um campo key=value
+     * @param key Nome do campo
+     * @param value Valor: texto, número, bool, enum ou Hex
+     */
+    template <typename T>
+    static Field<T> field(std::string_view key, const T& value) { return { key, value }; }
 
-        std::cerr << "[Daemon] Sistema de log inicializado com Sucesso: " << std::endl;
-    }
+    /** @brief Marca um trecho de bytes para ser registrado em hexadecimal */
+    static Hex hex(const void* data, std::size_t size) { return { data, size }; }
 
     /**
-     * @brief Registra uma mensagem de log no arquivo.
+     * @brief Inicializa o sistema de log com o arquivo especificado.
      *
-     * @param message Mensagem a ser registrada.
+     * Sobe a thread de escrita; a partir daqui as mensagens vão para o
+     * console e para o arquivo. Se o arquivo não abrir, segue só no console.
+     *
+     * @param filename Nome do arquivo onde os logs serão armazenados.
      */
-    static void Log(const std::string& message)
-    {
-        std::lock_guard<std::mutex> lock(sMutex);
+    static void Initialize(const std::string& filename);
 
-        if (logFile.is_open())
-        {
-            logFile << returnCurrentTimeStamp() << " " << message << std::endl;
-        }
-    }
+    /**
+     * @brief Registra uma mensagem de log (nível INFO, sem componente).
+     *
+     * @param message Mensagem a ser registrada.
+     */
+    static void Log(const std::string& message);
 
     /**
-     * @brief Finaliza o sistema de log, fechando o arquivo de log.
+     * @brief Finaliza o sistema de log: grava o que estiver pendente,
+     * para a thread de escrita e fecha o arquivo de log.
      */
-    static void Shutdown()
-    {
-        if (logFile.is_open())
-        {
-            logFile.close();
-        }
-    }
+    static void Shutdown();
 
     /**
      * @brief Retorna o timestamp atual no formato "YYYY-MM-DD HH:MM:SS".
@@ -70,88 +119,141 @@ public:
      */
     std::string static returnCurrentTimeStamp();
 
-private:
     /**
-     * @class TeeBuffer
-     * @brief Classe auxiliar para redirecionar saídas para múltiplos buffers.
+     * @brief Define o nível mínimo em tempo de execução (só filtra mais;
+     * abaixo de AETHER_LOG_MIN_LEVEL as mensagens nem existem no binário)
      */
-    class TeeBuffer : public std::streambuf
+    static void setMinLevel(Level level);
+
+    /** @brief true se uma mensagem desse nível seria registrada agora */
+    static bool enabled(Level level);
+
+    /**
+     * @brief Formata e enfileira uma mensagem. Preferir as macros
+     * AETHER_LOG_*, que removem em compilação os níveis desativados.
+     *
+     * @param level Nível da mensagem
+     * @param component Origem (ex: "TcpConnection"), impressa entre colchetes
+     * @param message Texto fixo da mensagem
+     * @param fields Campos key=value (ver field())
+     */
+    template <typename... Fields>
+    static void write(Level level, std::string_view component, std::string_view message, const Fields&... fields)
     {
-    public:
-        /**
-         * @brief Construtor da classe TeeBuffer.
-         * @param sb1 Primeiro buffer de saída.
-         * @param sb2 Segundo buffer de saída.
-         */
-        TeeBuffer(std::streambuf* sb1, std::streambuf* sb2) : sb1(sb1), sb2(sb2), atLineStart1(true), atLineStart2(true) {}
-
-    protected:
-        /**
-         * @brief Sobrescreve a função overflow para redirecionar a saída.
-         * @param c Caractere a ser escrito.
-         * @return Retorna o caractere escrito ou EOF em caso de erro.
-         */
-        int overflow(int c) override
+        if (!enabled(level))
+            return;
+
+        std::string& line = scratch();
+        line.clear();
+
+        if (!component.empty())
         {
-            if (c == EOF) return !EOF;
-
-            std::lock_guard<std::mutex> lock(sMutex);
-
-            // Console
-            if (sb1)
-            {
-                if (atLineStart1)
-                {
-                    std::string ts = returnCurrentTimeStamp() + " | ";
-                    sb1->sputn(ts.c_str(), ts.size());
-                    atLineStart1 = false;
-                }
-
-                sb1->sputc(c);  // Escreve o caractere no arquivo de log
-
-                if (c == '\n')
-                    atLineStart1 = true; // próxima linha começa, adiciona timestamp
-            }
-
-            // Arquivo de Log
-            if (sb2)
-            {
-                if (atLineStart2)
-                {
-                    std::string ts = returnCurrentTimeStamp() + " | ";
-                    sb2->sputn(ts.c_str(), ts.size());
-                    atLineStart2 = false;
-                }
-
-                sb2->sputc(c);  // Escreve o caractere no arquivo de log
-
-                if (c == '\n')
-                    atLineStart2 = true; // próxima linha começa, adiciona timestamp
-            }
-
-            return c;
+            line += '[';
+            line += component;
+            line += "] ";
         }
 
-        /**
-         * @brief Sobrescreve a função sync para sincronizar os buffers.
-         * @return Retorna 0 em caso de sucesso, -1 em caso de erro.
-         */
-        int sync() override
-        {
-            std::lock_guard<std::mutex> lock(sMutex);
+        line += message;
+        (appendField(line, fields), ...);
+
+        submit(level, line);
+    }
+
+private:
+    /** @brief Buffer de formatação da thread atual (capacidade reaproveitada) */
+    static std::string& scratch();
+
+    /** @brief Enfileira a mensagem pronta no buffer da thread atual */
+    static void submit(Level level, std::string_view text);
+
+    static void appendHex(std::string& out, const Hex& bytes);
+    static void appendText(std::string& out, std::string_view text);
+
+    template <typename T>
+    static void appendField(std::string& out, const Field<T>& field)
+    {
+        out += ' ';
+        out += field.key;
+        out += '=';
+        appendValue(out, field.value);
+    }
 
-            int r1 = sb1 ? sb1->pubsync() : 0;          /// Sincroniza o primeiro buffer
-            int r2 = sb2 ? sb2->pubsync() : 0;          /// Sincroniza o segundo buffer
-            return (r1 == 0 && r2 == 0) ? 0 : -1;       /// Retorna 0 se ambos sincronizaram com sucesso
+    template <typename T>
+    static void appendValue(std::string& out, const T& value)
+    {
+        if constexpr (std::is_same_v<T, Hex>)
+        {
+            appendHex(out, value);
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            out += value ? "true" : "false";
         }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+            out += value;
+        }
+        else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+        {
+            // C string nula (ex: PQgetvalue sem resultado) sai como null em vez de derrubar o processo
+            if (value)
+                appendText(out, std::string_view(value));
+            else
+                out += "null";
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            appendText(out, std::string_view(value));
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            appendValue(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            // unsigned char/uint8_t como número, não como caractere
+            char digits[24];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), +value);
+            out.append(digits, static_cast<std::size_t>(result.ptr - digits));
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            char digits[32];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            out.append(digits, static_cast<std::size_t>(result.ptr - digits));
+        }
+        else
+        {
+            static_assert(std::is_same_v<T, void>, "Tipo sem formatacao para AetherCoreLogger::field");
+        }
+    }
+};
 
-    private:
-        std::streambuf* sb1;        /// Primeiro buffer de saída
-        std::streambuf* sb2;        /// Segundo buffer de saída
-        bool atLineStart1 = false;   /// indica se está no início de uma linha
-        bool atLineStart2 = false;   /// indica se está no início de uma linha
-    };
+#define AETHER_LOG_WRITE(level, component, ...) \
+    AetherCoreLogger::write(AetherCoreLogger::Level::level, component, __VA_ARGS__)
+
+#if AETHER_LOG_MIN_LEVEL <= AETHER_LOG_LEVEL_TRACE
+#  define AETHER_LOG_TRACE(component, ...) AETHER_LOG_WRITE(Trace, component, __VA_ARGS__)
+#else
+#  define AETHER_LOG_TRACE(component, ...) ((void)0)
+#endif
+
+#if AETHER_LOG_MIN_LEVEL <= AETHER_LOG_LEVEL_DEBUG
+#  define AETHER_LOG_DEBUG(component, ...) AETHER_LOG_WRITE(Debug, component, __VA_ARGS__)
+#else
+#  define AETHER_LOG_DEBUG(component, ...) ((void)0)
+#endif
+
+#if AETHER_LOG_MIN_LEVEL <= AETHER_LOG_LEVEL_INFO
+#  define AETHER_LOG_INFO(component, ...) AETHER_LOG_WRITE(Info, component, __VA_ARGS__)
+#else
+#  define AETHER_LOG_INFO(component, ...) ((void)0)
+#endif
+
+#if AETHER_LOG_MIN_LEVEL <= AETHER_LOG_LEVEL_WARN
+#  define AETHER_LOG_WARN(component, ...) AETHER_LOG_WRITE(Warn, component, __VA_ARGS__)
+#else
+#  define AETHER_LOG_WARN(component, ...) ((void)0)
+#endif
 
-    static std::ofstream logFile;       /// Arquivo de log
-    static std::mutex sMutex;           /// Protege escritas concorrentes em logFile/TeeBuffer
-};
\ No newline at end of file
+#define AETHER_LOG_ERROR(component, ...) AETHER_LOG_WRITE(Error, component, __VA_ARGS__)
@@ -2,13 +2,14 @@
 #include "../../../core/database/include/ConnectionPool.hpp"
 #include "../config/DatabaseConfig.hpp"
 #include "../../../core/network/SessionManager.hpp"
+#include "../../../core/utils/logger.hpp"
+#include "../../../core/utils/Metrics.hpp"
 #include "../../../protocols/aether/include/CommandType.hpp"
 #include "../../../protocols/aether/common/ModuleId.hpp"
 #include "../../../protocols/aether/include/PacketBuilder.hpp"
 #include "../../../include/external/croncpp.h"
 #include <sstream>
 #include <iomanip>
-#include <iostream>
 
 /**
  * @brief Construtor padrão.
@@ -78,12 +79,19 @@ void PoseidonSchedule::stop()
  */
 void PoseidonSchedule::loop()
 {
+    using Aether::Core::Utils::Metrics;
+    static auto& cycleTime = Metrics::histogram("aether_scheduler_cycle_seconds", "Duracao de cada ciclo de verificacao dos agendamentos");
+    static auto& lag = Metrics::histogram("aether_scheduler_lag_seconds", "Atraso entre o horario previsto (cron) e a execucao do job");
+    static auto& jobsOk = Metrics::counter("aether_scheduler_jobs_total", "Jobs executados pelo agendador", "result=\"success\"");
+    static auto& jobsFailed = Metrics::counter("aether_scheduler_jobs_total", "Jobs executados pelo agendador", "result=\"failed\"");
+
     while (running_)
     {
+        const auto cycleStart = std::chrono::steady_clock::now();
         auto conn = pool_->acquire();
 
         if (!conn) {
-            std::cout << "[Poseidon] Falha ao conectar-se ao banco de dados para verificar os agendamentos!\n";
+            AETHER_LOG_ERROR("Schedule", "Falha ao conectar-se ao banco de dados para verificar os agendamentos");
         } else {
             auto now = std::chrono::system_clock::now();
 
@@ -127,17 +135,22 @@ void PoseidonSchedule::loop()
                     auto nextRun = cron::cron_next(cron, baseTime);
                     if (nextRun <= now || runNow == true)
                     {
+                        if (nextRun <= now)
+                            lag.observe(std::chrono::system_clock::now() - nextRun);
+
                         if (jobType == "RELAY_CHANGE_STATE")
                         {
                             if (!jobChangeStateRelay(jobId, jsonPayload, deviceName))
                             {
-                                std::cout << "[Poseidon] - [Schedule] Falha ao executar o agendamento cód. " << jobId << "\n";
+                                jobsFailed.inc();
+                                AETHER_LOG_WARN("Schedule", "Falha ao executar o agendamento", AetherCoreLogger::field("job", jobId));
                                 continue;
                             }
                         } else {
-                            std::cout << "[Poseidon] - [Schedule] Agendamento cód. " << jobId
-                                      << " não executado — tipo não implementado: " << jobType << "\n";
+                            AETHER_LOG_WARN("Schedule", "Agendamento não executado, tipo não implementado",
+                                            AetherCoreLogger::field("job", jobId), AetherCoreLogger::field("type", jobType));
                         }
+                        jobsOk.inc();
                         jobUpdateDb(jobId);
                     }
                     std::this_thread::sleep_for(std::chrono::seconds(5));
@@ -146,6 +159,8 @@ void PoseidonSchedule::loop()
             }
         }
 
+        cycleTime.observe(std::chrono::steady_clock::now() - cycleStart);
+
         std::unique_lock<std::mutex> lock(cvMutex_);
         cv_.wait_for(lock, std::chrono::seconds(60), [this] { return !running_.load(); });
     }
@@ -165,7 +180,7 @@ void PoseidonSchedule::jobUpdateDb(const std::string& jobId)
     auto conn = pool.acquire();
 
     if (!conn) {
-        std::cout << "[Poseidon] - [Schedule] Falha ao conectar ao banco para atualizar o job cód. " << jobId << "\n";
+        AETHER_LOG_ERROR("Schedule", "Falha ao conectar ao banco para atualizar o job", AetherCoreLogger::field("job", jobId));
         return;
     }
 
@@ -180,7 +195,7 @@ void PoseidonSchedule::jobUpdateDb(const std::string& jobId)
     )", 1, paramValues);
 
     if (PQresultStatus(res) != PGRES_COMMAND_OK)
-        std::cout << "[Poseidon] ERRO ao atualizar last_run_datetime: " << PQerrorMessage(conn->get()) << "\n";
+        AETHER_LOG_ERROR("Schedule", "Falha ao atualizar last_run_datetime", AetherCoreLogger::field("error", PQerrorMessage(conn->get())));
 
     PostgresDriver::freeResult(res);
 
@@ -191,7 +206,7 @@ void PoseidonSchedule::jobUpdateDb(const std::string& jobId)
     )", 1, paramValues);
 
     if (PQresultStatus(res) != PGRES_COMMAND_OK)
-        std::cout << "[Poseidon] ERRO ao inserir histórico do job: " << PQerrorMessage(conn->get()) << "\n";
+        AETHER_LOG_ERROR("Schedule", "Falha ao inserir histórico do job", AetherCoreLogger::field("error", PQerrorMessage(conn->get())));
 
     PostgresDriver::freeResult(res);
 }
@@ -212,7 +227,7 @@ bool PoseidonSchedule::jobChangeStateRelay(const std::string& jobId, const std::
 {
     auto channel = SessionManager::instance().getChannelByDeviceExternalId(deviceName);
     if (!channel) {
-        std::cout << "[Poseidon] - [Schedule] device '" << deviceName << "' não conectado ou não identificado\n";
+        AETHER_LOG_WARN("Schedule", "device não conectado ou não identificado", AetherCoreLogger::field("device", deviceName));
         return false;
     }
 
@@ -225,7 +240,7 @@ bool PoseidonSchedule::jobChangeStateRelay(const std::string& jobId, const std::
     );
 
     channel->sendResponse(packet);
-    std::cout << "[Poseidon] - [Schedule] pacote enviado para device=" << deviceName << " (job=" << jobId << ")\n";
+    AETHER_LOG_INFO("Schedule", "pacote enviado", AetherCoreLogger::field("device", deviceName), AetherCoreLogger::field("job", jobId));
 
     return true;
 }
@@ -276,7 +291,7 @@ void PoseidonSchedule::jobFailDb(const std::string& jobId, const std::string& er
     auto conn = pool.acquire();
 
     if (!conn) {
-        std::cout << "[Poseidon] - [Schedule] Falha ao conectar ao banco para registrar falha do job cod. " << jobId << "\n";
+        AETHER_LOG_ERROR("Schedule", "Falha ao conectar ao banco para registrar falha do job", AetherCoreLogger::field("job", jobId));
         return;
     }
 
@@ -291,7 +306,7 @@ void PoseidonSchedule::jobFailDb(const std::string& jobId, const std::string& er
     )", 2, paramValues);
 
     if (PQresultStatus(res) != PGRES_COMMAND_OK)
-        std::cout << "[Poseidon] ERRO ao inserir historico de falha do job: " << PQerrorMessage(conn->get()) << "\n";
+        AETHER_LOG_ERROR("Schedule", "Falha ao inserir historico de falha do job", AetherCoreLogger::field("error", PQerrorMessage(conn->get())));
 
     PostgresDriver::freeResult(res);
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Campos do evento de um DATA_PUSH em JSON, extraídos em uma passada
+ *
+ * Só guarda o que o Poseidon usa. Os campos de texto ficam em buffers
+ * fixos, então preencher a estrutura não aloca.
+ */
+struct PoseidonEvent
+{
+    static constexpr std::size_t MAX_EXTERNAL_ID = 64;  /// sens_sensor.external_id é VARCHAR(20)
+
+    /** @brief Situação de um campo do JSON */
+    enum class Field : uint8_t
+    {
+        Missing,        /**< Ausente */
+        WrongType,      /**< Presente com tipo errado (ou texto longo demais) */
+        Ok,             /**< Presente e válido */
+    };
+
+    /** @brief Valor de event.type */
+    enum class Type : uint8_t
+    {
+        Unknown,
+        Sensor,
+        Relay,
+    };
+
+    bool hasEvent = false;                      /**< Chave "event" presente na raiz */
+    Field type = Field::Missing;                /**< event.type (string) */
+    Type eventType = Type::Unknown;
+
+    Field sensorType = Field::Missing;          /**< event.sensor_type (string, não usado na gravação) */
+    Field sensorExternalId = Field::Missing;    /**< event.sensor_external_id (string) */
+    char sensorExternalIdValue[MAX_EXTERNAL_ID + 1] = {};
+    std::size_t sensorExternalIdLength = 0;
+    Field value = Field::Missing;               /**< event.value (número) */
+    double valueNumber = 0;
+    Field readTimestamp = Field::Missing;       /**< event.read_timestamp (número, epoch em segundos) */
+    long readTimestampValue = 0;
+
+    /** @brief event.sensor_external_id como texto */
+    std::string_view externalId() const { return { sensorExternalIdValue, sensorExternalIdLength }; }
+};
+
+/**
+ * @brief Parser SAX do JSON do DATA_PUSH
+ *
+ * Percorre o payload uma vez com o nlohmann::json::sax_parse e preenche o
+ * PoseidonEvent sem montar o DOM. Chaves desconhecidas (inclusive objetos
+ * e arrays aninhados) são ignoradas, como no parse anterior.
+ */
+class PoseidonEventParser
+{
+public:
+    /**
+     * @brief Extrai o evento do payload
+     * @param data Início do payload
+     * @param size Tamanho do payload
+     * @param out Campos encontrados
+     * @return false se o payload não é um JSON válido
+     */
+    static bool parse(const uint8_t* data, std::size_t size, PoseidonEvent& out);
+};
@@ -31,6 +31,11 @@ public:
      */
     uint8_t moduleId() const override;
 
+    /**
+     * @brief Um worker por conexão do pool: mais que isso só esperaria no acquire()
+     */
+    DispatchLimits dispatchLimits() const override;
+
     /**
      * @brief Função que inicia o modulo quando chamado
      */
@@ -3,6 +3,7 @@
 #include "../../../core/eventbus/include/Event.hpp"
 #include "../../../protocols/aether/include/Packet.hpp"
 #include "../../../protocols/aether/common/IProtocolHandler.hpp"
+#include "EventParser.hpp"
 #include <../../../include/external/json.hpp>
 
 /**
@@ -12,6 +13,8 @@
 class PoseidonService
 {
 public:
+    static constexpr std::size_t DB_POOL_SIZE = 5;  /// Conexões do pool compartilhado (e workers do módulo no router)
+
     /**
      * @brief Função que recebe um evento do Aether e processa a logica e regras de negocio
      * @param event dados do evento recebido
@@ -49,22 +52,46 @@ public:
     static std::pair<bool,std::string> processJsonPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId);
 
     /**
-     * @brief Função que recebe um JSON contendo dados do sensor, processa e persiste no banco de dados do Poseidon
-     * @param json JSON contendo os dados do sensor a ser processado
-     * @param event dados do evento recebido
+     * @brief Função que recebe um packet DATA_PUSH_BINARY (leitura de sensor no formato do SensorCodec)
+     * e persiste no banco de dados do Poseidon. O sensor é identificado pelo id (sens_sensor.id).
+     * @param packet Pacote de dados recebido via TCP
+     * @param deviceId Codigo do Device, é declarado no channel pelo Handshake inicial a sessão
+     * @return retorna um std::pair com um valor bool indicando se foi processado com sucesso e a mensagem de retorno
+     */
+    static std::pair<bool,std::string> processBinaryPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId);
+
+    /**
+     * @brief Função que recebe um packet DATA_PUSH_BATCH (lote de leituras no formato do SensorCodec),
+     * valida o lote inteiro e persiste todas as leituras em um único INSERT
+     * @param packet Pacote de dados recebido via TCP
      * @param deviceId Codigo do Device, é declarado no channel pelo Handshake inicial a sessão
+     * @param stored Resultado de cada leitura (true = gravada), usado no DATA_PUSH_BATCH_ACK
+     * @return retorna um std::pair com um valor bool indicando se o lote foi processado e a mensagem de retorno
      */
-    static std::pair<bool, std::string> processSensorData(auto& json, const std::string& deviceId);
+    static std::pair<bool,std::string> processBatchPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId,
+                                                                  std::vector<bool>& stored);
+
     /**
-     * @brief Função que recebe um JSON contendo dados da relé, processa e persiste no banco de dados do Poseidon
-    * @param json JSON contendo os dados do relay a ser processado
+     * @brief Função que recebe os campos de um evento de sensor, valida e persiste no banco de dados do Poseidon
+     * @param event Campos do evento extraídos do JSON pelo PoseidonEventParser
+     * @param deviceId Codigo do Device, é declarado no channel pelo Handshake inicial a sessão
      */
-    static std::pair<bool, std::string> processRelayData(auto& json);
+    static std::pair<bool, std::string> processSensorData(const PoseidonEvent& event, const std::string& deviceId);
+    /**
+     * @brief Função que recebe os campos de um evento de relé, processa e persiste no banco de dados do Poseidon
+     * @param event Campos do evento extraídos do JSON pelo PoseidonEventParser
+     */
+    static std::pair<bool, std::string> processRelayData(const PoseidonEvent& event);
     /**
      * @brief Função que recebe um pacote TCP do Aether e processa a logica e regras de negocio
      * @param packet dados do pacote recebido
      */
     static void handlePacket(const ProtocolAether::Packet& packet, const std::shared_ptr<IResponseChannel>& channel);
+    /**
+     * @brief Descarta um pacote cuja conexão fechou antes do processamento (sessão já removida do SessionManager)
+     * @param packet dados do pacote descartado
+     */
+    static void dropOrphanPacket(const ProtocolAether::Packet& packet);
     /**
      * @brief Função que permite enviar uma dado TCP para um cliente conectado, buscando pelo ID externo definido durante
      * o HANDSHAKE
@@ -0,0 +1,184 @@
+#include "../include/EventParser.hpp"
+
+#include "external/json.hpp"
+
+#include <cstring>
+
+namespace
+{
+    using json = nlohmann::json;
+
+    /** Chaves de event que o Poseidon lê */
+    enum class Key : uint8_t
+    {
+        Other,
+        Type,
+        SensorType,
+        SensorExternalId,
+        Value,
+        ReadTimestamp,
+    };
+
+    Key keyOf(const std::string& key)
+    {
+        if (key == "type")                  return Key::Type;
+        if (key == "sensor_type")           return Key::SensorType;
+        if (key == "sensor_external_id")    return Key::SensorExternalId;
+        if (key == "value")                 return Key::Value;
+        if (key == "read_timestamp")        return Key::ReadTimestamp;
+        return Key::Other;
+    }
+
+    /**
+     * Handler SAX: acompanha a profundidade e só olha os valores que estão
+     * na raiz (chave "event") ou diretamente dentro do objeto event.
+     */
+    class EventSax
+    {
+    public:
+        explicit EventSax(PoseidonEvent& out) : m_out(out) {}
+
+        bool null()                                         { onValue(Kind::Other); return true; }
+        bool boolean(bool)                                  { onValue(Kind::Other); return true; }
+        bool number_integer(json::number_integer_t v)       { onNumber(static_cast<double>(v), static_cast<long>(v)); return true; }
+        bool number_unsigned(json::number_unsigned_t v)     { onNumber(static_cast<double>(v), static_cast<long>(v)); return true; }
+        bool number_float(json::number_float_t v, const json::string_t&) { onNumber(v, static_cast<long>(v)); return true; }
+        bool string(json::string_t& v)                      { onValue(Kind::String, &v); return true; }
+        bool binary(json::binary_t&)                        { onValue(Kind::Other); return true; }
+
+        bool start_object(std::size_t)
+        {
+            onValue(Kind::Object);
+            ++m_depth;
+            return true;
+        }
+
+        bool end_object()
+        {
+            --m_depth;
+            if (m_inEvent && m_depth == 1)
+                m_inEvent = false;
+            return true;
+        }
+
+        bool start_array(std::size_t)
+        {
+            onValue(Kind::Other);
+            ++m_depth;
+            return true;
+        }
+
+        bool end_array()
+        {
+            --m_depth;
+            return true;
+        }
+
+        bool key(json::string_t& key)
+        {
+            if (m_depth == 1)
+                m_eventKey = key == "event";
+            else if (m_inEvent && m_depth == 2)
+                m_key = keyOf(key);
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&)
+        {
+            return false;
+        }
+
+    private:
+        enum class Kind : uint8_t { String, Number, Object, Other };
+
+        void onNumber(double number, long integer)
+        {
+            m_number = number;
+            m_integer = integer;
+            onValue(Kind::Number);
+        }
+
+        void onValue(Kind kind, const json::string_t* text = nullptr)
+        {
+            /// Valor da chave "event" na raiz; se repetida, vale a última (como no DOM)
+            if (m_depth == 1 && m_eventKey)
+            {
+                m_eventKey = false;
+                m_out = PoseidonEvent{};
+                m_out.hasEvent = true;
+                m_inEvent = kind == Kind::Object;
+                return;
+            }
+
+            if (!m_inEvent || m_depth != 2)
+                return;
+
+            const Key key = m_key;
+            m_key = Key::Other;
+
+            using Field = PoseidonEvent::Field;
+            switch (key)
+            {
+                case Key::Type:
+                    m_out.type = kind == Kind::String ? Field::Ok : Field::WrongType;
+                    m_out.eventType = kind != Kind::String ? PoseidonEvent::Type::Unknown
+                                    : *text == "sensor"   ? PoseidonEvent::Type::Sensor
+                                    : *text == "relay"    ? PoseidonEvent::Type::Relay
+                                    :                       PoseidonEvent::Type::Unknown;
+                    break;
+
+                case Key::SensorType:
+                    m_out.sensorType = kind == Kind::String ? Field::Ok : Field::WrongType;
+                    break;
+
+                case Key::SensorExternalId:
+                    if (kind == Kind::String && text->size() <= PoseidonEvent::MAX_EXTERNAL_ID)
+                    {
+                        std::memcpy(m_out.sensorExternalIdValue, text->data(), text->size());
+                        m_out.sensorExternalIdValue[text->size()] = '\0';
+                        m_out.sensorExternalIdLength = text->size();
+                        m_out.sensorExternalId = Field::Ok;
+                    } else
+                    {
+                        m_out.sensorExternalId = Field::WrongType;
+                    }
+                    break;
+
+                case Key::Value:
+                    m_out.value = kind == Kind::Number ? Field::Ok : Field::WrongType;
+                    m_out.valueNumber = m_number;
+                    break;
+
+                case Key::ReadTimestamp:
+                    m_out.readTimestamp = kind == Kind::Number ? Field::Ok : Field::WrongType;
+                    m_out.readTimestampValue = m_integer;
+                    break;
+
+                case Key::Other:
+                    break;
+            }
+        }
+
+        PoseidonEvent& m_out;
+        std::size_t m_depth = 0;    /// Containers abertos
+        bool m_eventKey = false;    /// Última chave da raiz foi "event"
+        bool m_inEvent = false;     /// Dentro do objeto event
+        Key m_key = Key::Other;     /// Última chave dentro de event
+        double m_number = 0;
+        long m_integer = 0;
+    };
+}
+
+/**
+ * Extrai o evento do payload em uma passada.
+ * @param data Início do payload
+ * @param size Tamanho do payload
+ * @param out Campos encontrados
+ * @return false se o payload não é um JSON válido
+ */
+bool PoseidonEventParser::parse(const uint8_t* data, std::size_t size, PoseidonEvent& out)
+{
+    out = PoseidonEvent{};
+    EventSax sax(out);
+    return json::sax_parse(data, data + size, &sax);
+}
@@ -6,6 +6,7 @@
 #include "../../../core/eventbus/include/EventTypes.hpp"
 #include "../../../core/eventbus/include/EventBus.hpp"
 #include "PoseidonService.hpp"
+#include "../../../core/utils/logger.hpp"
 #include "../../ModulePoseidon/Schedule/ScheduleService.hpp"
 
 #include "../../../protocols/aether/include/CommandType.hpp"
@@ -23,7 +24,7 @@ void ModulePoseidon::stop()
 {
     if (!running) return;
     running = false;
-    std::cout << "[Poseidon] Parando módulo....." << std::endl;
+    AETHER_LOG_INFO("Poseidon", "Parando módulo");
 
     // Desinscreve do EventBus antes de publicar
     EventBus::getInstance().unsubscribe(this);
@@ -38,10 +39,10 @@ void ModulePoseidon::stop()
 void ModulePoseidon::start()
 {
     running = true;
-    std::cout << "[Poseidon] Módulo inicializado." << std::endl;
+    AETHER_LOG_INFO("Poseidon", "Módulo inicializado");
     EventBus::getInstance().subscribe(this); // Inscreve-se para receber eventos do MainBus
 
-    std::cout << "[Poseidon] Inicializando Schedule..." << std::endl;
+    AETHER_LOG_INFO("Poseidon", "Inicializando Schedule");
     schedule_.start();
 }
 
@@ -54,6 +55,15 @@ uint8_t ModulePoseidon::moduleId() const
     return static_cast<uint8_t>(ModuleId::MODULE_POSEIDON);
 }
 
+/**
+ * @brief Limites do executor do Poseidon no ProtocolRouter
+ * @return Um worker por conexão do banco e fila para rajadas de DATA_PUSH
+ */
+IProtocolHandler::DispatchLimits ModulePoseidon::dispatchLimits() const
+{
+    return { PoseidonService::DB_POOL_SIZE, 4096 };
+}
+
 /**
  * @brief Callback chamado quando um modulo é adicionado no EventBus,
  * chama a classe de serviços para processar os dados
@@ -1,10 +1,15 @@
 ﻿#include "../include/PoseidonService.hpp"
 
 #include "../include/PoseidonMain.hpp"
+#include "../include/EventParser.hpp"
 #include "../../../protocols/aether/include/CommandType.hpp"
 #include "../../../protocols/aether/include/PacketBuilder.hpp"
+#include "../../../protocols/aether/include/SensorCodec.hpp"
 #include "../../../protocols/aether/common/IResponseChannel.hpp"
 #include "../../../core/network/SessionManager.hpp"
+#include "../../../core/utils/logger.hpp"
+#include "../../../core/utils/Metrics.hpp"
+#include "../../../core/utils/Tracing.hpp"
 
 #include "../config/DatabaseConfig.hpp"
 #include "../../../core/database/include/ConnectionPool.hpp"
@@ -12,17 +17,282 @@
 //#include <../../../include/external/json.hpp>
 #include "external/json.hpp"
 
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
 #include "../../../protocols/aether/common/ModuleId.hpp"
 
 /**
  * @brief Callback chamado quando um modulo é adicionado no EventBus,
  * chama a classe de serviços para processar os dados
  */
-void PoseidonService::handleEvent(const Event& event)
+void PoseidonService::handleEvent(const Event& /*event*/)
 {
 
 }
 
+namespace
+{
+    /// Mensagem do ACK de um DATA_PUSH gravado
+    constexpr std::string_view MSG_INSERTED = "Dado inserido com sucesso!";
+
+    /**
+     * @brief Payload de resposta {"data":null,"message":"...","success":...}
+     *
+     * Montado por template, sem DOM: prefixo e sufixo fixos com a mensagem
+     * escapada no meio. Mesma saída (e ordem de chaves) do dump() do nlohmann.
+     */
+    std::vector<uint8_t> responsePayload(bool success, std::string_view message)
+    {
+        static constexpr std::string_view PREFIX = R"({"data":null,"message":")";
+        static constexpr std::string_view SUCCESS = R"(","success":true})";
+        static constexpr std::string_view FAILURE = R"(","success":false})";
+
+        std::string json;
+        json.reserve(PREFIX.size() + message.size() + FAILURE.size() + 8);
+        json.append(PREFIX);
+
+        for (const char c : message)
+        {
+            switch (c)
+            {
+                case '"':  json.append("\\\""); break;
+                case '\\': json.append("\\\\"); break;
+                case '\n': json.append("\\n");  break;
+                case '\r': json.append("\\r");  break;
+                case '\t': json.append("\\t");  break;
+                case '\b': json.append("\\b");  break;
+                case '\f': json.append("\\f");  break;
+                default:
+                    if (static_cast<uint8_t>(c) < 0x20)
+                    {
+                        char escaped[7];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(static_cast<uint8_t>(c)));
+                        json.append(escaped, 6);
+                    } else
+                    {
+                        json.push_back(c);
+                    }
+            }
+        }
+
+        json.append(success ? SUCCESS : FAILURE);
+        return std::vector<uint8_t>(json.begin(), json.end());
+    }
+
+    /// ACK de DATA_PUSH gravado, montado uma única vez
+    const std::vector<uint8_t>& insertedPayload()
+    {
+        static const auto payload = responsePayload(true, MSG_INSERTED);
+        return payload;
+    }
+
+    /// Resposta a comando desconhecido, montada uma única vez
+    const std::vector<uint8_t>& invalidCommandPayload()
+    {
+        static const auto payload = responsePayload(false, "Comando enviado é invalido e não foi processado pelo modulo Poseidon");
+        return payload;
+    }
+
+    /**
+     * @brief Valor da leitura em texto para o PostgreSQL, sem perder precisão
+     *
+     * std::to_string arredonda em 6 casas decimais; o to_chars gera a menor
+     * representação que volta exatamente ao mesmo double.
+     */
+    std::string formatSensorValue(double value)
+    {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return std::string(digits, result.ptr);
+    }
+
+    /// INSERT da leitura com o sensor identificado pelo external_id (DATA_PUSH em JSON)
+    constexpr const char* SQL_INSERT_BY_EXTERNAL_ID = R"(
+        INSERT INTO poseidon.dsrd_data_sensor_received
+	        (device_id, sensor_id, data_value, read_date)
+        VALUES (
+            (SELECT id FROM poseidon.devc_device WHERE device_name = $1::text),
+	        (SELECT id FROM poseidon.sens_sensor WHERE external_id = $2::text),
+	        $3,
+	        to_timestamp($4)
+        )
+    )";
+
+    /// INSERT da leitura com o sensor identificado pelo id (DATA_PUSH_BINARY)
+    constexpr const char* SQL_INSERT_BY_SENSOR_ID = R"(
+        INSERT INTO poseidon.dsrd_data_sensor_received
+	        (device_id, sensor_id, data_value, read_date)
+        VALUES (
+            (SELECT id FROM poseidon.devc_device WHERE device_name = $1::text),
+	        (SELECT id FROM poseidon.sens_sensor WHERE id = $2::integer),
+	        $3,
+	        to_timestamp($4)
+        )
+    )";
+
+    /**
+     * INSERT de um lote (DATA_PUSH_BATCH) em um único comando. Os arrays vêm
+     * alinhados: $2 índice do item no lote, $3 sensor, $4 valor, $5 epoch.
+     * Só entram as leituras cujo sensor e device existem; o SELECT final
+     * devolve o índice de cada uma, que vira o bit de status no ACK.
+     */
+    constexpr const char* SQL_INSERT_BATCH = R"(
+        WITH reading AS (
+            SELECT r.idx, d.id AS device_id, s.id AS sensor_id, r.value, r.ts
+            FROM unnest($2::integer[], $3::integer[], $4::float8[], $5::bigint[]) AS r(idx, sensor_id, value, ts)
+            JOIN poseidon.sens_sensor s ON s.id = r.sensor_id
+            JOIN poseidon.devc_device d ON d.device_name = $1::text
+        ), inserted AS (
+            INSERT INTO poseidon.dsrd_data_sensor_received
+                (device_id, sensor_id, data_value, read_date)
+            SELECT device_id, sensor_id, value, to_timestamp(ts) FROM reading
+        )
+        SELECT idx FROM reading
+    )";
+
+    /**
+     * @brief Pool de conexões do Poseidon, criado no primeiro pacote e
+     * compartilhado por todos (antes era criado um pool por pacote)
+     */
+    ConnectionPool& sharedPool()
+    {
+        static ConnectionPool pool(Poseidon::DatabaseConfig::connectionString(), PoseidonService::DB_POOL_SIZE);
+        return pool;
+    }
+
+    /**
+     * @brief Reconecta a conexão emprestada se ela caiu (o pool agora vive o
+     * processo inteiro, então o banco pode reiniciar com as conexões abertas)
+     */
+    void ensureConnected(ConnectionHandle& conn)
+    {
+        if (conn && !conn->isConnected())
+        {
+            AETHER_LOG_WARN("Poseidon", "Conexão com o banco perdida, reconectando");
+            conn->disconnect();
+            conn->connect();
+        }
+    }
+
+    /**
+     * @brief Persiste uma leitura de sensor no banco de dados do Poseidon
+     * @param sql Um dos INSERT acima ($1 device, $2 sensor, $3 valor, $4 epoch)
+     * @param deviceName Codigo do Device declarado no Handshake
+     * @param sensorKey external_id ou id do sensor, conforme o sql
+     * @param value Valor lido
+     * @param readTimestamp Momento da leitura (epoch em segundos)
+     */
+    std::pair<bool, std::string> insertSensorData(const char* sql, const std::string& deviceName,
+                                                  const std::string& sensorKey, double value, long readTimestamp)
+    {
+        // Gerencia a conexão com o banco de dados
+        auto conn = sharedPool().acquire();
+        ensureConnected(conn);
+
+        if (!conn || !conn->isConnected()) {
+            AETHER_LOG_ERROR("Poseidon", "acquire() retornou NULL");
+            return std::make_pair(false, "Erro interno no Modulo Poseidon do Aether durante a conexão com o banco de dados!");
+        }
+
+        // Persiste os dados no banco de dados
+        const std::string sensorValue = formatSensorValue(value);
+        const std::string timestampStr = std::to_string(readTimestamp);
+
+        const char* paramValues[4];
+        paramValues[0] = deviceName.c_str();
+        paramValues[1] = sensorKey.c_str();
+        paramValues[2] = sensorValue.c_str();
+        paramValues[3] = timestampStr.c_str();
+
+        auto res = conn->queryParams(sql, 4, paramValues);
+
+        if (PQresultStatus(res) != PGRES_COMMAND_OK)
+        {
+            std::string errorMessage = PQerrorMessage(conn->get());
+            PQclear(res);
+            AETHER_LOG_ERROR("Poseidon", "Falha ao inserir dados no banco de dados", AetherCoreLogger::field("error", errorMessage));
+            return std::make_pair(false, "Erro ao inserir dados no banco de dados: " + errorMessage);
+        }
+
+        PostgresDriver::freeResult(res);
+
+        return std::make_pair(true, std::string(MSG_INSERTED));
+    }
+
+    /**
+     * @brief Persiste um lote de leituras em um único INSERT
+     * @param deviceName Codigo do Device declarado no Handshake
+     * @param readings Leituras decodificadas do DATA_PUSH_BATCH
+     * @param count Quantidade de leituras
+     * @param stored Resultado de cada item (true = gravado)
+     */
+    std::pair<bool, std::string> insertSensorBatch(const std::string& deviceName, const ProtocolAether::SensorReading* readings,
+                                                   std::size_t count, std::vector<bool>& stored)
+    {
+        stored.assign(count, false);
+
+        // Monta os arrays do unnest; leituras que o banco recusaria (id fora de
+        // integer, valor não finito) ficam de fora e voltam com o bit zerado
+        std::string indexes = "{", sensors = "{", values = "{", timestamps = "{";
+        std::size_t accepted = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (readings[i].sensorId > static_cast<uint32_t>(INT32_MAX) || !std::isfinite(readings[i].value))
+                continue;
+
+            const char* separator = accepted++ == 0 ? "" : ",";
+            indexes.append(separator).append(std::to_string(i));
+            sensors.append(separator).append(std::to_string(readings[i].sensorId));
+            values.append(separator).append(formatSensorValue(readings[i].value));
+            timestamps.append(separator).append(std::to_string(readings[i].readTimestamp));
+        }
+        indexes += "}"; sensors += "}"; values += "}"; timestamps += "}";
+
+        if (accepted == 0)
+        {
+            return std::make_pair(true, "Nenhuma leitura válida no lote");
+        }
+
+        auto conn = sharedPool().acquire();
+        ensureConnected(conn);
+
+        if (!conn || !conn->isConnected()) {
+            AETHER_LOG_ERROR("Poseidon", "acquire() retornou NULL");
+            return std::make_pair(false, "Erro interno no Modulo Poseidon do Aether durante a conexão com o banco de dados!");
+        }
+
+        const char* paramValues[5] = {
+            deviceName.c_str(), indexes.c_str(), sensors.c_str(), values.c_str(), timestamps.c_str()
+        };
+
+        auto res = conn->queryParams(SQL_INSERT_BATCH, 5, paramValues);
+
+        if (PQresultStatus(res) != PGRES_TUPLES_OK)
+        {
+            std::string errorMessage = PQerrorMessage(conn->get());
+            PQclear(res);
+            AETHER_LOG_ERROR("Poseidon", "Falha ao inserir lote no banco de dados", AetherCoreLogger::field("error", errorMessage));
+            return std::make_pair(false, "Erro ao inserir dados no banco de dados: " + errorMessage);
+        }
+
+        const int rows = PQntuples(res);
+        for (int row = 0; row < rows; ++row)
+        {
+            const auto index = std::strtoul(PQgetvalue(res, row, 0), nullptr, 10);
+            if (index < count)
+                stored[index] = true;
+        }
+
+        PostgresDriver::freeResult(res);
+
+        return std::make_pair(true, std::to_string(rows) + " de " + std::to_string(count) + " leituras inseridas");
+    }
+}
+
 /**
  * @brief Função que recebe um packet payload e realiza o processamento dos dados do tipó DATA_PUSH
  * @param packet
@@ -52,190 +322,219 @@ void PoseidonService::handleEvent(const Event& event)
  */
 std::pair<bool,std::string> PoseidonService::processJsonPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId)
 {
-    // Biblioteca para manipulação de JSON
-    using json = nlohmann::json;
-    json j;
-
-    // Tenta realizar o parse do payload recebido (Espera sempre um JSON)
-    try
+    // Extrai os campos do evento em uma passada (SAX), sem montar o DOM
+    PoseidonEvent event;
+    bool valid;
     {
-        j = json::parse(packet.payload);
+        Aether::Core::Utils::Span span("poseidon.json_parse");
+        valid = PoseidonEventParser::parse(packet.payload.data(), packet.payload.size(), event);
     }
-    catch (const std::exception& e)
+
+    if (!valid)
     {
         return std::make_pair(false, "JSON invalido");
     }
 
-    // Verifica se a TAG "device_name" existe no Json
-    //if (!j.contains("device_name") || !j["device_name"].is_string())
-    //{
-    //    return std::make_pair(false, "Elemento 'device_name' inválido ou ausente");
-    //}
-
     // Verifica se a TAG "event" existe no Json
-    if (!j.contains("event"))
+    if (!event.hasEvent)
     {
         return std::make_pair(false, "Objeto 'event' inválido ou ausente");
     }
 
     // Verifica se a TAG "type" existe no Json
-    if (!j["event"].contains("type") || !j["event"]["type"].is_string())
+    if (event.type != PoseidonEvent::Field::Ok)
     {
         return std::make_pair(false, "Elemento 'type' inválido ou ausente");
     }
 
     /// Roteamento
-    if (j["event"]["type"] == "sensor")
+    if (event.eventType == PoseidonEvent::Type::Sensor)
     {
-        return processSensorData(j, deviceId);
+        return processSensorData(event, deviceId);
     }
 
-    if (j["event"]["type"] == "relay")
+    if (event.eventType == PoseidonEvent::Type::Relay)
     {
-        return processRelayData(j);
+        return processRelayData(event);
     }
 
     return std::make_pair(false, "Ocorreu um erro ao processar o evento enviado ou o tipo de evento é desconhecido");
 }
 
-std::pair<bool,std::string> PoseidonService::processSensorData(auto& json, const std::string& deviceId)
+std::pair<bool,std::string> PoseidonService::processSensorData(const PoseidonEvent& event, const std::string& deviceId)
 {
-    // Biblioteca para manipulação de JSON
-    using jsonData = nlohmann::json;
-    jsonData j;
-    j = json;
+    using Field = PoseidonEvent::Field;
 
-    if (!j["event"].contains("sensor_type") || !j["event"]["sensor_type"].is_string())
+    if (event.sensorType != Field::Ok)
     {
         return std::make_pair(false, "Elemento 'sensor_type' inválido ou ausente");
     }
 
-    if (!j["event"].contains("sensor_external_id") || !j["event"]["sensor_external_id"].is_string())
+    if (event.sensorExternalId != Field::Ok)
     {
         return std::make_pair(false, "Elemento 'sensor_external_id' inválido ou ausente");
     }
 
-    if (!j["event"].contains("value") || !j["event"]["value"].is_number())
+    if (event.value != Field::Ok)
     {
         return std::make_pair(false, "Elemento 'value' inválido ou ausente");
     }
 
-    if (!j["event"].contains("read_timestamp") || !j["event"]["read_timestamp"].is_number())
+    if (event.readTimestamp != Field::Ok)
     {
         return std::make_pair(false, "Elemento 'read_timestamp' inválido ou ausente");
     }
 
-    // Gerencia a conexão com o banco de dados
-    ConnectionPool pool(Poseidon::DatabaseConfig::connectionString(), 5);
-    auto conn = pool.acquire();
+    return insertSensorData(SQL_INSERT_BY_EXTERNAL_ID, deviceId, std::string(event.externalId()),
+                            event.valueNumber, event.readTimestampValue);
+}
 
-    if (!conn) {
-        std::cout << "[Poseidon] ERRO: acquire() retornou NULL!" << std::endl;
-        return std::make_pair(false, "Erro interno no Modulo Poseidon do Aether durante a conexão com o banco de dados!");
-    }
+/**
+ * @brief Função que recebe um packet DATA_PUSH_BINARY e persiste a leitura de sensor
+ * @param packet Pacote de dados recebido via TCP (payload no formato do SensorCodec)
+ * @param deviceId Codigo do Device, é declarado no channel pelo Handshake inicial a sessão
+ * @return retorna um std::pair com um valor bool indicando se foi processado com sucesso e a mensagem de retorno
+ */
+std::pair<bool,std::string> PoseidonService::processBinaryPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId)
+{
+    using ProtocolAether::SensorCodec;
 
-    // Persiste os dados no banco de dados
-    const char* paramValues[4];
-    const std::string& deviceName = deviceId;
-    std::string sensorExternalId = j["event"]["sensor_external_id"];
-    std::string sensorValue = std::to_string(j["event"]["value"].get<double>());
-    std::string timestampStr = std::to_string(j["event"]["read_timestamp"].get<long>());
+    ProtocolAether::SensorReading reading;
+    const auto status = SensorCodec::decode(packet.payload.data(), packet.payload.size(), reading);
+    if (status != SensorCodec::Status::Ok)
+    {
+        return std::make_pair(false, SensorCodec::describe(status));
+    }
 
-    paramValues[0] = deviceName.c_str();
-    paramValues[1] = sensorExternalId.c_str();
-    paramValues[2] = sensorValue.c_str();
-    paramValues[3] = timestampStr.c_str();
+    return insertSensorData(SQL_INSERT_BY_SENSOR_ID, deviceId, std::to_string(reading.sensorId),
+                            reading.value, reading.readTimestamp);
+}
 
-    auto& sql = R"(
-        INSERT INTO poseidon.dsrd_data_sensor_received
-	        (device_id, sensor_id, data_value, read_date)
-        VALUES (
-            (SELECT id FROM poseidon.devc_device WHERE device_name = $1::text),
-	        (SELECT id FROM poseidon.sens_sensor WHERE external_id = $2::text),
-	        $3,
-	        to_timestamp($4)
-        )
-    )";
+/**
+ * @brief Função que recebe um packet DATA_PUSH_BATCH e persiste todas as leituras em um único INSERT
+ * @param packet Pacote de dados recebido via TCP (lote no formato do SensorCodec)
+ * @param deviceId Codigo do Device, é declarado no channel pelo Handshake inicial a sessão
+ * @param stored Resultado de cada leitura do lote, na ordem recebida
+ * @return retorna um std::pair com um valor bool indicando se o lote foi processado e a mensagem de retorno
+ */
+std::pair<bool,std::string> PoseidonService::processBatchPacketDataPush(const ProtocolAether::Packet& packet, const std::string& deviceId,
+                                                                        std::vector<bool>& stored)
+{
+    using ProtocolAether::SensorCodec;
 
-    auto res = conn->queryParams(sql, 4, paramValues);
+    // Destino do decode por thread: o lote é decodificado inteiro sem alocar
+    thread_local std::vector<ProtocolAether::SensorReading> readings(SensorCodec::MAX_BATCH_ITEMS);
 
-    if (PQresultStatus(res) != PGRES_COMMAND_OK)
+    std::size_t count = 0;
+    const auto status = SensorCodec::decodeBatch(packet.payload.data(), packet.payload.size(), readings.data(), count);
+    if (status != SensorCodec::Status::Ok)
     {
-        std::string errorMessage = PQerrorMessage(conn->get());
-        PQclear(res);
-        std::cout << "[Poseidon] ERRO ao inserir dados no banco de dados: " << errorMessage << std::endl;
-        return std::make_pair(false, "Erro ao inserir dados no banco de dados: " + errorMessage);
+        return std::make_pair(false, SensorCodec::describe(status));
     }
 
-    PostgresDriver::freeResult(res);
-
-    return std::make_pair(true, "Dado inserido com sucesso!");
+    return insertSensorBatch(deviceId, readings.data(), count, stored);
 }
 
-std::pair<bool,std::string> PoseidonService::processRelayData(auto& json)
+std::pair<bool,std::string> PoseidonService::processRelayData(const PoseidonEvent& /*event*/)
 {
     return std::make_pair(false, "Não implementado");
 }
 
+/**
+ * @brief Descarta um pacote cuja conexão fechou antes de ele sair da fila do executor
+ *
+ * Sem sessão não há deviceId para gravar nem para quem mandar o ACK; o device,
+ * sem ACK, reenvia a leitura quando reconectar.
+ */
+void PoseidonService::dropOrphanPacket(const ProtocolAether::Packet& packet)
+{
+    static auto& orphans = Aether::Core::Utils::Metrics::counter(
+        "aether_poseidon_orphan_packets_total", "Pacotes descartados porque a conexao fechou antes do processamento");
+    orphans.inc();
+    AETHER_LOG_WARN("Poseidon", "Pacote descartado: conexão encerrada antes do processamento",
+                    AetherCoreLogger::field("type", packet.type));
+}
+
 /**
  * @brief Callback chamado quando um pacote TCP identificado é recebido via callback
  * chama a classe de serviços para processar os dados
  */
 void PoseidonService::handlePacket(const ProtocolAether::Packet& packet, const std::shared_ptr<IResponseChannel>& channel)
 {
-    nlohmann::json json;
+    if (packet.type == static_cast<uint16_t>(CommandType::DATA_PUSH_BATCH))
+    {
+        auto connExternalId = SessionManager::instance().getDeviceExternalId(channel);
+        if (!connExternalId)
+        {
+            dropOrphanPacket(packet);
+            return;
+        }
+        AETHER_LOG_DEBUG("Poseidon", "DATA_PUSH_BATCH recebido", AetherCoreLogger::field("device", *connExternalId));
+
+        // Um único ACK para o lote inteiro, com um bit de status por leitura
+        std::vector<bool> stored;
+        auto returnValue = processBatchPacketDataPush(packet, *connExternalId, stored);
+        if (returnValue.first)
+        {
+            channel->sendResponse(ProtocolAether::PacketBuilder::build(
+                CommandType::DATA_PUSH_BATCH_ACK,
+                packet.module,
+                ProtocolAether::SensorCodec::encodeBatchAck(stored)
+            ));
+            return;
+        }
 
-    if (packet.type == static_cast<uint16_t>(CommandType::DATA_PUSH))
+        channel->sendResponse(ProtocolAether::PacketBuilder::build(
+            CommandType::ERROR_GENERIC,
+            packet.module,
+            responsePayload(false, returnValue.second)
+        ));
+        return;
+    }
+
+    const bool binary = packet.type == static_cast<uint16_t>(CommandType::DATA_PUSH_BINARY);
+    if (binary || packet.type == static_cast<uint16_t>(CommandType::DATA_PUSH))
     {
         /// Identifica o connExternalId da conexão TCP e imprime o recebimento do dado no console
         auto connExternalId = SessionManager::instance().getDeviceExternalId(channel);
-        std::cout << "[Poseidon] - Cliente conectado enviou um DATA_PUSH, Identificação: " << *connExternalId << std::endl;
+        if (!connExternalId)
+        {
+            dropOrphanPacket(packet);
+            return;
+        }
+        AETHER_LOG_DEBUG("Poseidon", binary ? "DATA_PUSH_BINARY recebido" : "DATA_PUSH recebido",
+                         AetherCoreLogger::field("device", *connExternalId));
 
         //sendReverseToDevice("IDESP32", json, static_cast<uint16_t>(ModuleId::MODULE_POSEIDON));
 
-        // Realiza o processamento dos dados recebidos
-        auto returnValue = processJsonPacketDataPush(packet, *connExternalId);
-
-        json["data"] = nullptr;
-        json["message"] = returnValue.second;
-        json["success"] = returnValue.first;
+        // Realiza o processamento dos dados recebidos (binário ou JSON)
+        auto returnValue = binary
+            ? processBinaryPacketDataPush(packet, *connExternalId)
+            : processJsonPacketDataPush(packet, *connExternalId);
 
-        // Converte o JSON em uint8_t
-        std::string jsonString = json.dump();
-        const std::vector<uint8_t> payload(jsonString.begin(), jsonString.end());
-
-        CommandType responseType;
-        if (returnValue.first)
+        // Envia o retorno ao cliente; o ACK de sucesso já está pronto
+        if (returnValue.first && returnValue.second == MSG_INSERTED)
         {
-            responseType = CommandType::ACK;
-        } else
-        {
-            responseType = CommandType::ERROR_GENERIC;
+            channel->sendResponse(ProtocolAether::PacketBuilder::build(
+                CommandType::ACK,
+                packet.module,
+                insertedPayload()
+            ));
+            return;
         }
 
-        // Envia o retorno ao cliente
-        const auto response = ProtocolAether::PacketBuilder::build(
-            responseType,
+        channel->sendResponse(ProtocolAether::PacketBuilder::build(
+            returnValue.first ? CommandType::ACK : CommandType::ERROR_GENERIC,
             packet.module,
-            payload
-        );
-        channel->sendResponse(response);
+            responsePayload(returnValue.first, returnValue.second)
+        ));
     } else
     {
-        json["success"] = false;
-        json["message"] = "Comando enviado é invalido e não foi processado pelo modulo Poseidon";
-        json["data"] = nullptr;
-
-
-        std::string jsonString = json.dump();
-        const std::vector<uint8_t> payload(jsonString.begin(), jsonString.end());
-
-        const auto response = ProtocolAether::PacketBuilder::build(
+        channel->sendResponse(ProtocolAether::PacketBuilder::build(
             CommandType::ERROR_GENERIC,
             packet.module,
-            payload
-        );
-        channel->sendResponse(response);
+            invalidCommandPayload()
+        ));
     }
 }
 
@@ -252,7 +551,7 @@ void PoseidonService::sendReverseToDevice(const std::string& deviceId, const nlo
     auto channel = SessionManager::instance().getChannelByDeviceExternalId(deviceId);
     if (!channel) {
         // cliente não encontrado / não identificado
-        std::cout << "[ReverseSender] device '" << deviceId << "' não conectado ou não identificado\n";
+        AETHER_LOG_WARN("ReverseSender", "device não conectado ou não identificado", AetherCoreLogger::field("device", deviceId));
         return;
     }
 
@@ -267,10 +566,8 @@ void PoseidonService::sendReverseToDevice(const std::string& deviceId, const nlo
         payload
     );
 
-    // 4) Envia via channel
-    // IMPORTANTE: certifique-se de que sendResponse é thread-safe. Se não for,
-    // proteja com mutex ou use um mecanismo de enfileiramento dentro do channel.
+    // 4) Envia via channel (o TcpResponseChannel serializa os envios com um mutex por conexão)
     channel->sendResponse(packet);
 
-    std::cout << "[ReverseSender] pacote enviado para device=" << deviceId << "\n";
+    AETHER_LOG_DEBUG("ReverseSender", "pacote enviado", AetherCoreLogger::field("device", deviceId));
 }
\ No newline at end of file
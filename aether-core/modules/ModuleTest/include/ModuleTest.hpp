@@ -13,9 +13,9 @@
 #include "../../../protocols/aether/include/Packet.hpp"
 #include "../../../protocols/aether/include/PacketBuilder.hpp"
 #include "../../../protocols/aether/include/CommandType.hpp"
+#include "../../../core/utils/logger.hpp"
 
 
-#include <iostream>
 #include <atomic>
 #include <thread>
 
@@ -43,9 +43,7 @@ public:
             // Executa stop em outra thread para não travar o EventBus
             //std::thread([this]() { stop(); }).detach();
         } else {
-            std::cout << "[ModuleTest] Evento recebido: " << event.type
-                      << " de " << event.source
-                      << " com tipo: " << event.type << std::endl;
+            AETHER_LOG_INFO("ModuleTest", "Evento recebido", AetherCoreLogger::field("type", event.type), AetherCoreLogger::field("source", event.source));
         }
     }
 
@@ -55,13 +53,13 @@ public:
     {
         running = true;
 
-        std::cout << "[ModuleTest] Módulo inicializado." << std::endl;
+        AETHER_LOG_INFO("ModuleTest", "Módulo inicializado");
         EventBus::getInstance().subscribe(this); // Inscreve-se para receber eventos
-        std::cout << "[ModuleTest] Módulo inscrito para receber eventos." << std::endl;
+        AETHER_LOG_INFO("ModuleTest", "Módulo inscrito para receber eventos");
 
         ConnectionPool* pool = new ConnectionPool(ModuleTestConfig::DatabaseConfig::connectionString(), 5);
 
-        std::cout << "[ModuleTest] Connection string: " << ModuleTestConfig::DatabaseConfig::connectionString() << std::endl;
+        AETHER_LOG_DEBUG("ModuleTest", "Connection string", AetherCoreLogger::field("value", ModuleTestConfig::DatabaseConfig::connectionString()));
 
         worker = std::thread([this, pool]()
         {
@@ -69,7 +67,7 @@ public:
 
             while (running)
             {
-                //std::cout << "[ModuleTest] Running..." << std::endl;
+                //AETHER_LOG_TRACE("ModuleTest", "Running...");
                 std::this_thread::sleep_for(std::chrono::seconds(1));
 
                 if (test == 0)
@@ -78,11 +76,11 @@ public:
                     auto conn = pool->acquire();
 
                     if (!conn) {
-                        std::cout << "[ModuleTest] ERRO: acquire() retornou NULL!" << std::endl;
+                        AETHER_LOG_ERROR("ModuleTest", "acquire() retornou NULL");
                         continue;
                     }
 
-                    std::cout << "[ModuleTest] " << PQgetvalue(conn->query("select count(*) from pg_roles"), 0, 0) << std::endl;
+                    AETHER_LOG_DEBUG("ModuleTest", "pg_roles", AetherCoreLogger::field("count", PQgetvalue(conn->query("select count(*) from pg_roles"), 0, 0)));
                 }
             }
         });
@@ -98,14 +96,14 @@ public:
         if (!running) return;
         running = false;
 
-        std::cout << "[ModuleTest] Parando módulo....." << std::endl;
+        AETHER_LOG_INFO("ModuleTest", "Parando módulo");
 
         // Simula limpeza de recursos
         std::this_thread::sleep_for(std::chrono::milliseconds(10000));
 
         if (worker.joinable()) {
             worker.join();
-            std::cout << "[ModuleTest] Módulo parado." << std::endl;
+            AETHER_LOG_INFO("ModuleTest", "Módulo parado");
         }
 
         // Desinscreve do EventBus antes de publicar
@@ -120,17 +118,10 @@ public:
         std::shared_ptr<IResponseChannel> channel
     ) override
     {
-        std::cout << "[ModuleTest] onPacket DISPARADO" << std::endl;
-        std::cout << "[ModuleTest][TCP] Packet recebido\n";
-        std::cout << "  Cmd: " << static_cast<int>(packet.type) << "\n";
-        std::cout << "  Len: " << packet.payload.size() << "\n";
-
-        if (!packet.payload.empty()) {
-            std::cout << "  Payload: ";
-            for (auto b : packet.payload)
-                std::cout << std::hex << (int)b << " ";
-            std::cout << std::dec << "\n";
-        }
+        AETHER_LOG_DEBUG("ModuleTest", "Packet recebido",
+                         AetherCoreLogger::field("cmd", packet.type),
+                         AetherCoreLogger::field("len", packet.payload.size()),
+                         AetherCoreLogger::field("payload", AetherCoreLogger::hex(packet.payload.data(), packet.payload.size())));
 
         // 🔁 resposta simples (ACK)
         //ProtocolAether::Packet response;
@@ -145,7 +136,7 @@ public:
 
         channel->sendResponse(response);
 
-        std::cout << "[ModuleTest][TCP] ACK enviado\n";
+        AETHER_LOG_DEBUG("ModuleTest", "ACK enviado");
     }
 
 private:
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 
@@ -16,6 +18,20 @@ class IResponseChannel;
  */
 class IProtocolHandler {
 public:
+    /**
+     * @brief Limites do executor do módulo no ProtocolRouter.
+     *
+     * O router entrega os pacotes de cada módulo a um executor próprio, com
+     * `workers` threads; os pacotes de uma mesma conexão caem sempre na
+     * mesma thread, então chegam ao módulo na ordem. Com `queueCapacity`
+     * pacotes pendentes o router responde MODULE_UNAVAILABLE.
+     */
+    struct DispatchLimits
+    {
+        std::size_t workers = 1;            /**< Pacotes do módulo processados em paralelo */
+        std::size_t queueCapacity = 1024;   /**< Pacotes pendentes (na fila ou em execução) */
+    };
+
     /**
      * @brief Destrutor virtual padrão.
      */
@@ -26,9 +42,18 @@ public:
      */
     virtual uint8_t moduleId() const = 0;
 
+    /**
+     * @brief Concorrência e fila do módulo, lidas uma vez no registro
+     */
+    virtual DispatchLimits dispatchLimits() const { return {}; }
+
     /**
      * @brief Manipula um pacote recebido.
      *
+     * Chamado pelo ProtocolRouter numa thread do executor do módulo, nunca
+     * na thread de leitura da conexão. O canal pode ser guardado e usado
+     * depois, de qualquer thread.
+     *
      * @param packet O pacote recebido para processamento.
      * @param channel O canal de resposta para enviar respostas, se necessário.
      */
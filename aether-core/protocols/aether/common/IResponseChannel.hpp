@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include "../include/Packet.hpp"
 
 /**
@@ -13,5 +14,32 @@ class IResponseChannel
 public:
     virtual ~IResponseChannel() = default;                                      /// Destrutor virtual padrão
     virtual void sendResponse(const ProtocolAether::Packet& pkt) = 0;           /// Envia um pacote de resposta através do canal
-    virtual uint16_t id() const = 0;                                            /// Identificador único do canal de resposta
+
+    /**
+     * @brief Envia uma resposta a uma requisição com request id (Packet.hpp, v2).
+     *
+     * Canais que não transportam o id (v1, testes) enviam a resposta sem ele.
+     */
+    virtual void sendResponse(const ProtocolAether::Packet& pkt, uint32_t requestId)
+    {
+        (void)requestId;
+        sendResponse(pkt);
+    }
+
+    /**
+     * @brief Identificador único do canal durante a vida do processo.
+     *
+     * É a chave do SessionManager e da lane do ProtocolRouter, então não pode
+     * se repetir entre conexões vivas (nem ser reaproveitado logo depois).
+     */
+    virtual uint64_t id() const = 0;
+
+    /**
+     * @brief Indica se o canal ainda entrega respostas.
+     *
+     * Um pacote que esperou na fila do executor pode chegar ao módulo depois
+     * que a conexão fechou; o router o descarta. Canais sem conexão (testes)
+     * estão sempre abertos.
+     */
+    virtual bool isOpen() const { return true; }
 };
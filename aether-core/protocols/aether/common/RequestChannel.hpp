@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "IResponseChannel.hpp"
+
+/**
+ * @brief Canal de resposta de uma requisição com request id.
+ *
+ * Envolve o canal da conexão e carimba o request id da requisição em toda
+ * resposta enviada por ele. O ProtocolRouter entrega este canal ao módulo
+ * quando o pacote tem request id; o módulo pode guardá-lo e responder mais
+ * tarde, de outra thread, sem saber do id. Como cada resposta leva o id,
+ * ela pode sair fora da ordem de chegada.
+ */
+class RequestChannel : public IResponseChannel
+{
+public:
+    /**
+     * @param channel Canal da conexão
+     * @param requestId Id da requisição, copiado em todas as respostas
+     */
+    RequestChannel(std::shared_ptr<IResponseChannel> channel, uint32_t requestId)
+        : channel(std::move(channel)), requestId(requestId) {}
+
+    void sendResponse(const ProtocolAether::Packet& pkt) override { channel->sendResponse(pkt, requestId); }
+    void sendResponse(const ProtocolAether::Packet& pkt, uint32_t id) override { channel->sendResponse(pkt, id); }
+    uint64_t id() const override { return channel->id(); }
+    bool isOpen() const override { return channel->isOpen(); }
+
+    /** @brief Id da requisição respondida por este canal */
+    uint32_t getRequestId() const { return requestId; }
+
+private:
+    std::shared_ptr<IResponseChannel> channel;  /// Canal da conexão
+    uint32_t requestId;                         /// Id carimbado nas respostas
+};
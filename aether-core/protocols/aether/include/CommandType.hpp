@@ -36,6 +36,9 @@ enum class CommandType : uint16_t {
     DATA_REQUEST        = 0x0100,       /// Solicita dados específicos do servidor ou de um módulo.
     DATA_RESPONSE       = 0x0101,       /// Responde a uma solicitação de dados com as informações requisitadas.
     DATA_PUSH           = 0x0102,       /// Envia dados do cliente para o servidor sem solicitação prévia.
+    DATA_PUSH_BINARY    = 0x0103,       /// Igual ao DATA_PUSH, com a leitura de sensor no formato binário do SensorCodec.
+    DATA_PUSH_BATCH     = 0x0104,       /// Lote de leituras de sensor (SensorCodec) em um único frame.
+    DATA_PUSH_BATCH_ACK = 0x0105,       /// Resposta ao DATA_PUSH_BATCH, com um bit de status por leitura.
 
     // ----------------------------------------------------------------------
     // 0x1000 – 0xFFFF → Reservado para módulos específicos
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct z_stream_s;
+
+namespace ProtocolAether
+{
+    /**
+     * @brief Algoritmo de compressão do payload (bits 0..1 do flags no cabeçalho v2)
+     *
+     * Só o Deflate está implementado: o build não tem os headers de LZ4/zstd.
+     * Os códigos ficam reservados para que a negociação do HELLO já saiba
+     * recusá-los (o servidor responde com o codec que aceitou, ou None).
+     */
+    enum class Codec : uint8_t
+    {
+        None    = 0,    /// Payload cru
+        Deflate = 1,    /// zlib (deflate raw)
+        Lz4     = 2,    /// Reservado
+        Zstd    = 3,    /// Reservado
+    };
+
+    /**
+     * @brief Contexto de compressão de uma conexão
+     *
+     * Mantém os z_stream de compressão e descompressão vivos entre os frames
+     * (deflateInit aloca ~256 KB; aqui é só um reset por frame). Cada frame é
+     * comprimido de forma independente, sem dicionário compartilhado, então
+     * frames crus e comprimidos podem se misturar na mesma conexão.
+     *
+     * Payload comprimido: [tamanho original:4 big-endian][dados deflate]
+     *
+     * Não é thread-safe: cada conexão usa um para receber (Parser) e outro
+     * para enviar (TcpResponseChannel).
+     */
+    class CompressionContext
+    {
+    public:
+        static constexpr std::size_t DEFAULT_THRESHOLD = 512;          /// Payloads menores vão crus
+        static constexpr std::size_t MAX_DECOMPRESSED = 1024 * 1024;   /// Mesmo teto do PacketBuilder::DEFAULT_MAX_PAYLOAD
+
+        CompressionContext() = default;
+        ~CompressionContext();
+
+        CompressionContext(const CompressionContext&) = delete;
+        CompressionContext& operator=(const CompressionContext&) = delete;
+
+        /** @brief true se o codec está disponível neste build */
+        static bool supported(Codec codec);
+
+        /**
+         * @brief Comprime um payload
+         * @param out Recebe [tamanho original][dados]; só vale se retornar true
+         * @return false se o codec não é suportado ou o resultado não ficou menor
+         */
+        bool compress(Codec codec, const uint8_t* data, std::size_t size, std::vector<uint8_t>& out);
+
+        /**
+         * @brief Descomprime um payload recebido
+         *
+         * O tamanho original anunciado é checado antes de alocar: um frame
+         * pequeno não pode virar um payload maior que `maxSize`.
+         * @param out Payload original
+         * @param maxSize Maior payload original aceito (o Parser passa o seu maxPayload)
+         * @return false se o codec não é suportado, passa de `maxSize` ou os dados estão corrompidos
+         */
+        bool decompress(Codec codec, const uint8_t* data, std::size_t size, std::vector<uint8_t>& out,
+                        std::size_t maxSize = MAX_DECOMPRESSED);
+
+    private:
+        z_stream_s* deflater = nullptr;    /// Criado no primeiro compress()
+        z_stream_s* inflater = nullptr;    /// Criado no primeiro decompress()
+    };
+}
@@ -10,6 +10,7 @@
     * Ela é utilizada pelo `Parser::encode()` e `Parser::decode()` para realizar
     * a serialização/deserialização dos dados.
     *
+    * Versão 1:
     * +---------+---------+---------+---------+--------------------------+
     * | Byte(s) | Campo   | Descrição                                    |
     * +---------+---------+----------------------------------------------+
@@ -19,8 +20,32 @@
     * | 5..6    | module  | Módulo de destino do pacote.                 |
     * | 7..10   | length  | Tamanho do payload (uint32_t, big-endian)    |
     * | 11..N   | payload | Dados brutos                                 |
-    * | Futuro  | crc     | Campo de CRC (ainda não implementado)        |
     * +---------+---------+----------------------------------------------+
+    *
+    * Versão 2 (negociada no HELLO, ver ConnSession): um byte de flags depois
+    * da versão, e o restante deslocado em 1 byte.
+    * +---------+---------+----------------------------------------------+
+    * |   3     | flags   | bits 0..1: Codec do payload (Compression.hpp)|
+    * |         |         | bit 2: frame termina com CRC32C              |
+    * |         |         | bit 3: request id depois do length           |
+    * |         |         | bits 4..7: reservados, sempre 0              |
+    * | 4..5    | type    | Código do comando                            |
+    * | 6..7    | module  | Módulo de destino do pacote.                 |
+    * | 8..11   | length  | Tamanho do payload no fio (comprimido)       |
+    * | 12..15  | reqId   | Só com o bit 3: request id (big-endian)      |
+    * | ..N     | payload | Dados (comprimidos se o codec != None)       |
+    * | N+1..+4 | crc     | Só com o bit 2: CRC32C de 0..N (big-endian)  |
+    * +---------+---------+----------------------------------------------+
+    *
+    * O request id é escolhido pelo device; toda resposta a um frame com
+    * request id leva o mesmo id (ver RequestChannel), então o device pode
+    * mandar vários pedidos sem esperar e casar as respostas pelo id, que
+    * podem chegar fora de ordem.
+    *
+    * O length não inclui o request id nem o CRC. O Parser recusa length acima do limite
+    * (PacketBuilder::DEFAULT_MAX_PAYLOAD), versão desconhecida e flags
+    * reservadas: nesses casos procura o próximo magic e descarta o que
+    * ficou antes.
     */
 namespace ProtocolAether
 {
@@ -31,6 +56,8 @@ namespace ProtocolAether
 
         uint16_t magic;                         /// Magic | Numero de identificação do protocolo
         std::uint8_t version;                   /// Version | Versão do protocolo
+        std::uint8_t flags = 0;                 /// Flags | Só na versão 2 (codec do payload recebido, CRC, request id)
+        std::uint32_t requestId = 0;            /// Request id | Válido com flags & FLAG_REQUEST_ID
         uint16_t type;                          /// Type | Tipo do pacote (comando).
         uint16_t module;                        /// Module | Módulo de destino do pacote.
         uint32_t length;                        /// Length | Tamanho do payload em bytes.
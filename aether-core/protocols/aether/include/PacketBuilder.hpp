@@ -2,9 +2,11 @@
 
 #include "Packet.hpp"
 #include "CommandType.hpp"
+#include "Compression.hpp"
 
 #include <vector>
 #include <cstdint>
+#include <optional>
 
 
 /**
@@ -20,6 +22,27 @@ namespace ProtocolAether
     public:
         static constexpr uint16_t MAGIC = 0xAA55;       /// Valor mágico do protocolo
         static constexpr uint8_t  VERSION = 1;          /// Versão do protocolo
+        static constexpr uint8_t  VERSION_2 = 2;        /// Versão com byte de flags (negociada no HELLO)
+        static constexpr std::size_t HEADER_SIZE = 2 + 1 + 2 + 2 + 4;         /// Cabeçalho v1
+        static constexpr std::size_t HEADER_SIZE_V2 = 2 + 1 + 1 + 2 + 2 + 4;  /// Cabeçalho v2
+        static constexpr uint8_t  FLAG_CODEC_MASK = 0x03;   /// Bits do flags com o Codec do payload
+        static constexpr uint8_t  FLAG_CRC = 0x04;          /// Frame termina com CRC32C (4 bytes, big-endian)
+        static constexpr uint8_t  FLAG_REQUEST_ID = 0x08;   /// Cabeçalho seguido do request id (4 bytes, big-endian)
+        static constexpr uint8_t  FLAGS_KNOWN = FLAG_CODEC_MASK | FLAG_CRC | FLAG_REQUEST_ID;
+        static constexpr std::size_t CRC_SIZE = 4;          /// Trailer CRC32C
+        static constexpr std::size_t REQUEST_ID_SIZE = 4;   /// Request id depois do cabeçalho v2
+        static constexpr uint32_t DEFAULT_MAX_PAYLOAD = 1024 * 1024;    /// Length acima disso = cabeçalho corrompido
+
+        /**
+         * @brief Formato dos frames de uma conexão (negociado no HELLO)
+         */
+        struct WireFormat
+        {
+            uint8_t version = VERSION;          /// Versão do cabeçalho
+            Codec codec = Codec::None;          /// Codec de compressão (só v2)
+            bool crc = false;                   /// Trailer CRC32C (só v2)
+            std::size_t threshold = CompressionContext::DEFAULT_THRESHOLD;  /// Payload mínimo para tentar comprimir
+        };
 
         /// Cria um pacote vazio (sem payload)
         static Packet build(CommandType cmd, uint16_t module);
@@ -33,5 +56,27 @@ namespace ProtocolAether
 
         /// Serializa o Packet em bytes (para enviar via TCP)
         static std::vector<uint8_t> encode(const Packet& pkt);
+
+        /**
+         * @brief Serializa o Packet no formato da conexão
+         *
+         * Só comprime na v2, com codec != None e payload a partir de
+         * threshold bytes; se o resultado não ficar menor, vai cru.
+         * @param format Formato da conexão (a versão do pkt é ignorada)
+         * @param compression Contexto da conexão (nullptr = nunca comprime)
+         * @param requestId Na v2, id da requisição que este frame responde (ou identifica)
+         */
+        static std::vector<uint8_t> encode(
+            const Packet& pkt,
+            const WireFormat& format,
+            CompressionContext* compression = nullptr,
+            std::optional<uint32_t> requestId = std::nullopt
+        );
+
+        /// Tamanho do cabeçalho de uma versão do protocolo
+        static constexpr std::size_t headerSize(uint8_t version)
+        {
+            return version == VERSION_2 ? HEADER_SIZE_V2 : HEADER_SIZE;
+        }
     };
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <optional>
 #include "Packet.hpp"
+#include "PacketBuilder.hpp"
 
 class IResponseChannel;
 class IProtocolHandler;
@@ -16,6 +17,11 @@ namespace ProtocolAether
      * A classe Parser é responsável por receber dados brutos, analisar e interpretar
      * pacotes do protocolo Aether, e acionar callbacks apropriados quando pacotes válidos
      * são detectados.
+     *
+     * Aceita frames v1 e v2 (PacketBuilder::VERSION_2) misturados; na v2 o
+     * payload comprimido é descomprimido antes de chegar ao handler. Guarda
+     * estado por conexão (buffer de descompressão), então cada conexão usa
+     * o seu Parser.
      */
     class Parser
     {
@@ -49,15 +55,36 @@ namespace ProtocolAether
          * @param handler Ponteiro para o manipulador de protocolo.
          */
         void setHandler(IProtocolHandler* handler);
+
+        /**
+         * @brief Define o maior length aceito no cabeçalho (padrão PacketBuilder::DEFAULT_MAX_PAYLOAD).
+         *
+         * Um length acima disso é tratado como cabeçalho corrompido: o parser
+         * ressincroniza no próximo magic em vez de esperar o frame chegar.
+         * Também limita o tamanho descomprimido de um payload comprimido.
+         */
+        void setMaxPayload(uint32_t bytes);
     private:
         /**
          * @brief Tenta analisar um pacote a partir do buffer fornecido.
          * @param buffer Vetor de bytes contendo os dados a serem analisados.
+         * @param start Posição do primeiro byte não consumido; avança pelo que foi lido ou descartado.
          * @param outPacket Referência para o pacote onde o resultado da análise será armazenado.
-         * @return true se um pacote válido foi analisado, false caso contrário.
+         * @param channelId Id do canal de origem, usado pela PacketCapture.
+         * @return true se um pacote válido foi analisado, false se faltam dados.
          */
-        bool tryParsePacket(std::vector<uint8_t>& buffer, Packet& outPacket);
+        bool tryParsePacket(const std::vector<uint8_t>& buffer, size_t& start, Packet& outPacket, uint64_t channelId);
+
+        /**
+         * @brief Avança start até o próximo magic, em uma passada (sem mexer no buffer).
+         * @param start Posição do primeiro byte não consumido.
+         * @param from Posição a partir da qual o magic é procurado.
+         */
+        static void discardUntilMagic(const std::vector<uint8_t>& buffer, size_t& start, size_t from);
+
         OnPacket onPacket;                      /// Callback para pacotes analisados
         IProtocolHandler* handler = nullptr;    /// Manipulador de protocolo associado
+        CompressionContext compression;         /// Descompressão dos payloads v2
+        uint32_t maxPayload = PacketBuilder::DEFAULT_MAX_PAYLOAD;  /// Maior length aceito no cabeçalho
     };
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Payload binário de leitura de sensor (CommandType::DATA_PUSH_BINARY
+ * e CommandType::DATA_PUSH_BATCH)
+ *
+ * Alternativa compacta ao JSON do DATA_PUSH para os devices que só mandam
+ * leituras: o ESP32 monta o payload com alguns shifts, sem serializar texto,
+ * e o servidor decodifica em tempo constante e sem alocação.
+ *
+ * Item (uma leitura):
+ * +------------+----------+-----------------------------------------------+
+ * | Byte(s)    | Campo    | Descrição                                     |
+ * +------------+----------+-----------------------------------------------+
+ * |   0        | flags    | bit 0: value é double (senão float)           |
+ * |            |          | bits 1..7: reservados, sempre 0               |
+ * | 1..(1+n)   | sensorId | poseidon.sens_sensor.id, varint LEB128 (1..5) |
+ * | +4 ou +8   | value    | IEEE-754 big-endian (float ou double)         |
+ * | +4         | readTime | Epoch em segundos (uint32_t, big-endian)      |
+ * +------------+----------+-----------------------------------------------+
+ *
+ * DATA_PUSH_BINARY:    [version:1][item]
+ * DATA_PUSH_BATCH:     [version:1][count:2][item x count]
+ * DATA_PUSH_BATCH_ACK: [version:1][count:2][bitmap:(count+7)/8]
+ *
+ * No bitmap do ACK, o bit (i % 8) do byte (i / 8) ligado indica que o item
+ * i do lote foi gravado. O payload precisa ter exatamente o tamanho do
+ * layout: bytes sobrando são erro, assim uma versão futura maior nunca é
+ * lida pela metade.
+ */
+namespace ProtocolAether
+{
+    /**
+     * @brief Leitura de sensor decodificada
+     */
+    struct SensorReading
+    {
+        uint32_t sensorId = 0;          /// Id do sensor (poseidon.sens_sensor.id)
+        double value = 0;               /// Valor lido (float promovido a double)
+        uint32_t readTimestamp = 0;     /// Momento da leitura, epoch em segundos
+    };
+
+    /**
+     * @brief Codifica/decodifica o payload binário de leitura de sensor
+     */
+    class SensorCodec
+    {
+    public:
+        static constexpr uint8_t VERSION = 1;               /// Versão do formato
+        static constexpr uint8_t FLAG_DOUBLE = 0x01;        /// value com 8 bytes (double)
+        static constexpr std::size_t MAX_VARINT_SIZE = 5;   /// uint32_t em LEB128
+        static constexpr std::size_t MAX_ITEM_SIZE = 1 + MAX_VARINT_SIZE + 8 + 4;
+        static constexpr std::size_t MIN_SIZE = 1 + 1 + 1 + 4 + 4;
+        static constexpr std::size_t MAX_SIZE = 1 + MAX_ITEM_SIZE;
+        static constexpr std::size_t BATCH_HEADER_SIZE = 3; /// version + count
+        static constexpr std::size_t MAX_BATCH_ITEMS = 1024;/// Limite de leituras por DATA_PUSH_BATCH
+
+        /**
+         * @brief Resultado da decodificação
+         */
+        enum class Status : uint8_t
+        {
+            Ok,
+            Truncated,          /// Payload menor que o layout
+            BadVersion,         /// Versão desconhecida
+            BadFlags,           /// Bits reservados ligados
+            BadVarint,          /// sensorId com mais de 5 bytes ou acima de uint32_t
+            TrailingBytes,      /// Payload maior que o layout
+            BadCount,           /// Lote vazio ou acima de MAX_BATCH_ITEMS
+        };
+
+        /**
+         * @brief Decodifica um payload DATA_PUSH_BINARY; não aloca e lê no máximo MAX_SIZE bytes
+         * @param data Início do payload
+         * @param size Tamanho do payload
+         * @param out Leitura decodificada (só válida com Status::Ok)
+         */
+        static Status decode(const uint8_t* data, std::size_t size, SensorReading& out) noexcept;
+
+        /**
+         * @brief Decodifica um payload DATA_PUSH_BATCH inteiro em uma passada, sem alocar
+         * @param data Início do payload
+         * @param size Tamanho do payload
+         * @param out Destino das leituras, com espaço para MAX_BATCH_ITEMS
+         * @param count Quantidade de leituras decodificadas (só válida com Status::Ok)
+         */
+        static Status decodeBatch(const uint8_t* data, std::size_t size, SensorReading* out, std::size_t& count) noexcept;
+
+        /**
+         * @brief Codifica uma leitura em out (que precisa ter MAX_SIZE bytes)
+         * @param asDouble true para mandar value com 8 bytes, false para float
+         * @return Quantidade de bytes escritos
+         */
+        static std::size_t encode(const SensorReading& reading, bool asDouble, uint8_t* out) noexcept;
+
+        /// Codifica uma leitura em um vetor (para o PacketBuilder)
+        static std::vector<uint8_t> encode(const SensorReading& reading, bool asDouble = false);
+
+        /// Codifica um lote (até MAX_BATCH_ITEMS leituras) em um vetor
+        static std::vector<uint8_t> encodeBatch(const SensorReading* readings, std::size_t count, bool asDouble = false);
+
+        /// Monta o payload do DATA_PUSH_BATCH_ACK a partir do resultado de cada item
+        static std::vector<uint8_t> encodeBatchAck(const std::vector<bool>& stored);
+
+        /**
+         * @brief Lê um DATA_PUSH_BATCH_ACK (lado do device)
+         * @param stored Resultado de cada item, na ordem do lote
+         */
+        static Status decodeBatchAck(const uint8_t* data, std::size_t size, std::vector<bool>& stored);
+
+        /// Mensagem de erro de um Status, para a resposta ao device
+        static const char* describe(Status status) noexcept;
+    };
+}
@@ -0,0 +1,126 @@
+#include "../include/Compression.hpp"
+
+#include <zlib.h>
+
+namespace ProtocolAether
+{
+    static constexpr std::size_t SIZE_PREFIX = 4;   /// Tamanho original, antes dos dados comprimidos
+
+    CompressionContext::~CompressionContext()
+    {
+        if (deflater)
+        {
+            deflateEnd(deflater);
+            delete deflater;
+        }
+        if (inflater)
+        {
+            inflateEnd(inflater);
+            delete inflater;
+        }
+    }
+
+    /**
+     * Informa se o codec está disponível neste build
+     * @param codec Codec negociado ou indicado no frame
+     * @return true para None e Deflate
+     */
+    bool CompressionContext::supported(Codec codec)
+    {
+        return codec == Codec::None || codec == Codec::Deflate;
+    }
+
+    /**
+     * Comprime um payload com o contexto da conexão
+     * @param codec Codec a usar
+     * @param data Payload original
+     * @param size Tamanho do payload
+     * @param out Payload comprimido ([tamanho original:4][dados])
+     * @return true se comprimiu e ficou menor que o original
+     */
+    bool CompressionContext::compress(Codec codec, const uint8_t* data, std::size_t size, std::vector<uint8_t>& out)
+    {
+        /// Só vale a pena se ficar menor que o original
+        if (codec != Codec::Deflate || size <= SIZE_PREFIX || size > MAX_DECOMPRESSED)
+            return false;
+
+        if (!deflater)
+        {
+            deflater = new z_stream{};
+            /// -15: deflate raw, sem cabeçalho/adler do zlib (o frame já tem o tamanho)
+            if (deflateInit2(deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                delete deflater;
+                deflater = nullptr;
+                return false;
+            }
+        } else
+        {
+            deflateReset(deflater);
+        }
+
+        out.resize(size - 1);
+        out[0] = static_cast<uint8_t>(size >> 24);
+        out[1] = static_cast<uint8_t>(size >> 16);
+        out[2] = static_cast<uint8_t>(size >> 8);
+        out[3] = static_cast<uint8_t>(size);
+
+        deflater->next_in = const_cast<Bytef*>(data);
+        deflater->avail_in = static_cast<uInt>(size);
+        deflater->next_out = out.data() + SIZE_PREFIX;
+        deflater->avail_out = static_cast<uInt>(out.size() - SIZE_PREFIX);
+
+        if (deflate(deflater, Z_FINISH) != Z_STREAM_END)
+            return false;   /// Não coube: o comprimido não seria menor
+
+        out.resize(SIZE_PREFIX + deflater->total_out);
+        return true;
+    }
+
+    /**
+     * Descomprime um payload recebido com o contexto da conexão
+     * @param codec Codec indicado no frame
+     * @param data Payload comprimido ([tamanho original:4][dados])
+     * @param size Tamanho do payload comprimido
+     * @param out Payload original
+     * @param maxSize Maior payload original aceito
+     * @return false se o codec não é suportado, o tamanho passa do limite ou os dados estão corrompidos
+     */
+    bool CompressionContext::decompress(Codec codec, const uint8_t* data, std::size_t size, std::vector<uint8_t>& out,
+                                        std::size_t maxSize)
+    {
+        if (codec != Codec::Deflate || size < SIZE_PREFIX)
+            return false;
+
+        const std::size_t original = (static_cast<std::size_t>(data[0]) << 24) |
+                                     (static_cast<std::size_t>(data[1]) << 16) |
+                                     (static_cast<std::size_t>(data[2]) << 8) |
+                                     static_cast<std::size_t>(data[3]);
+        if (original > maxSize)
+            return false;
+
+        if (!inflater)
+        {
+            inflater = new z_stream{};
+            if (inflateInit2(inflater, -15) != Z_OK)
+            {
+                delete inflater;
+                inflater = nullptr;
+                return false;
+            }
+        } else
+        {
+            inflateReset(inflater);
+        }
+
+        out.resize(original);
+        inflater->next_in = const_cast<Bytef*>(data + SIZE_PREFIX);
+        inflater->avail_in = static_cast<uInt>(size - SIZE_PREFIX);
+        inflater->next_out = out.data();
+        inflater->avail_out = static_cast<uInt>(original);
+
+        /// Precisa terminar o stream exatamente no tamanho anunciado
+        const int result = inflate(inflater, Z_FINISH);
+        return result == Z_STREAM_END && inflater->total_out == original && inflater->avail_in == 0;
+    }
+}
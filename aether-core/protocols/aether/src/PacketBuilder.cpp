@@ -1,4 +1,5 @@
 #include "../include/PacketBuilder.hpp"
+#include "../../../core/utils/Crc32c.hpp"
 
 namespace ProtocolAether
 {
@@ -50,9 +51,41 @@ namespace ProtocolAether
      */
     std::vector<uint8_t> PacketBuilder::encode(const Packet& pkt)
     {
+        WireFormat format;
+        format.version = pkt.version;
+        return encode(pkt, format);
+    }
+
+    /**
+     * Encode um pacote no formato negociado com o peer (v2: compressão, CRC e request id).
+     * @param pkt O pacote a ser codificado.
+     * @param format Versão, codec, CRC e limiar de compressão da conexão.
+     * @param compression Contexto de compressão da conexão.
+     * @param requestId Request id levado no frame (só na v2).
+     * @return Um vetor de bytes contendo o pacote codificado.
+     */
+    std::vector<uint8_t> PacketBuilder::encode(
+        const Packet& pkt,
+        const WireFormat& format,
+        CompressionContext* compression,
+        std::optional<uint32_t> requestId
+    )
+    {
+        const uint8_t version = format.version;
+        const bool v2 = version == VERSION_2;
+        const bool crc = v2 && format.crc;
+        const bool withId = v2 && requestId.has_value();
+
+        /// Payload comprimido, se couber e ficar menor
+        std::vector<uint8_t> compressed;
+        const bool useCompressed = v2 && compression && format.codec != Codec::None
+            && pkt.payload.size() >= format.threshold
+            && compression->compress(format.codec, pkt.payload.data(), pkt.payload.size(), compressed);
+        const std::vector<uint8_t>& payload = useCompressed ? compressed : pkt.payload;
+
         /// Reserva espaço no buffer
         std::vector<uint8_t> buffer;
-        buffer.reserve(11 + pkt.payload.size());
+        buffer.reserve(headerSize(version) + REQUEST_ID_SIZE + payload.size() + CRC_SIZE);
 
         /// Funções auxiliares para empurrar valores no buffer
         auto push16 = [&](uint16_t v) {
@@ -69,13 +102,23 @@ namespace ProtocolAether
         };
 
         push16(pkt.magic);              /// Magic
-        buffer.push_back(pkt.version);  /// Version
+        buffer.push_back(version);      /// Version
+        if (v2)                         /// Flags: codec do payload deste frame, CRC e request id
+            buffer.push_back(static_cast<uint8_t>((useCompressed ? static_cast<uint8_t>(format.codec) : 0)
+                                                  | (crc ? FLAG_CRC : 0)
+                                                  | (withId ? FLAG_REQUEST_ID : 0)));
         push16(pkt.type);               /// Type
         push16(pkt.module);             /// Module
-        push32(pkt.length);             /// Length
+        push32(static_cast<uint32_t>(payload.size()));  /// Length (no fio, sem request id e CRC)
+        if (withId)
+            push32(*requestId);         /// Request id
 
         // Payload
-        buffer.insert(buffer.end(), pkt.payload.begin(), pkt.payload.end());
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
+
+        /// Trailer: CRC32C de tudo que veio antes (cabeçalho + request id + payload no fio)
+        if (crc)
+            push32(Aether::Core::Utils::Crc32c::compute(buffer.data(), buffer.size()));
 
         return buffer;
     }
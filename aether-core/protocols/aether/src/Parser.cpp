@@ -1,15 +1,35 @@
 #include "../include/Parser.hpp"
+#include "../include/PacketBuilder.hpp"
 #include "common/IProtocolHandler.hpp"
+#include "common/IResponseChannel.hpp"
+#include "../../../core/network/PacketCapture.hpp"
+#include "../../../core/utils/logger.hpp"
+#include "../../../core/utils/Metrics.hpp"
+#include "../../../core/utils/Tracing.hpp"
+#include "../../../core/utils/Crc32c.hpp"
 
 #include <cstring>
-#include <iostream>
 #include <memory>
-#include <ostream>
 
 namespace ProtocolAether
 {
-    static constexpr uint16_t MAGIC = 0xAA55;                   /// Valor mágico para identificar o início do pacote
-    static constexpr size_t HEADER_SIZE = 2 + 1 + 2 + 2 + 4;    /// Tamanho do cabeçalho do pacote
+    static constexpr uint16_t MAGIC = PacketBuilder::MAGIC;             /// Valor mágico para identificar o início do pacote
+    static constexpr size_t HEADER_SIZE = PacketBuilder::HEADER_SIZE;   /// Menor cabeçalho (v1)
+
+    namespace
+    {
+        using Aether::Core::Utils::Metrics;
+
+        auto& packetsParsed = Metrics::counter("aether_parser_packets_total", "Pacotes Aether completos entregues ao handler");
+        auto& bytesParsed = Metrics::counter("aether_parser_bytes_total", "Bytes de pacotes Aether completos (cabecalho + payload)");
+        auto& resyncBytes = Metrics::counter("aether_parser_resync_bytes_total", "Bytes descartados procurando o magic (ressincronizacao)");
+        auto& resyncEvents = Metrics::counter("aether_parser_resync_total", "Ressincronizacoes (cada uma descarta um trecho de uma vez)");
+        auto& invalidHeaders = Metrics::counter("aether_parser_invalid_headers_total", "Cabecalhos com versao desconhecida ou flags reservadas");
+        auto& oversizeFrames = Metrics::counter("aether_parser_oversize_total", "Cabecalhos com length acima do limite");
+        auto& crcErrors = Metrics::counter("aether_parser_crc_errors_total", "Frames v2 com CRC32C invalido");
+        auto& compressedPackets = Metrics::counter("aether_parser_compressed_packets_total", "Pacotes v2 recebidos com payload comprimido");
+        auto& decompressErrors = Metrics::counter("aether_parser_decompress_errors_total", "Pacotes descartados por payload comprimido invalido ou codec desconhecido");
+    }
 
     Parser::Parser() = default; /// Construtor padrão
 
@@ -38,89 +58,259 @@ namespace ProtocolAether
      */
     void Parser::feed(std::vector<uint8_t>& buffer, std::shared_ptr<IResponseChannel> channel)
     {
-        //std::cout << "[Parser] feed() buffer size=" << buffer.size() << std::endl;
+        AETHER_LOG_TRACE("Parser", "feed()", AetherCoreLogger::field("size", buffer.size()));
+        const uint64_t channelId = channel ? channel->id() : 0;
+        using Aether::Core::Utils::Tracing;
+
+        /// Os frames são lidos a partir de `consumed` e o prefixo consumido sai
+        /// do buffer uma vez só no fim: um erase por frame deixaria uma rajada
+        /// de N frames O(N²) (cada erase move o resto do buffer)
+        size_t consumed = 0;
+
         while (true)
         {
             Packet packet;  // Cria um novo pacote para armazenar os dados parseados
 
+            /// Só mede o parse com o tracing ligado (o trace só nasce se houver pacote)
+            const std::int64_t parseStart = Tracing::enabled() ? Tracing::now() : 0;
+
             /// Tenta parsear um pacote do buffer
-            if (!tryParsePacket(buffer, packet))
+            if (!tryParsePacket(buffer, consumed, packet, channelId))
             {
                 break; /// Sai do loop se não houver pacotes completos
             }
 
+            /// Trace do pacote (se amostrado): cobre do parse até o retorno do handler
+            Aether::Core::Utils::TraceScope trace("aether.packet", parseStart);
+            if (trace.sampled())
+                Tracing::record("parser.parse", parseStart, Tracing::now());
+
             if (handler)
             {
                 handler->onPacket(packet, channel); /// Chama o handler se estiver definido
             } else
             {
-                std::cout << "[Parser] onPacket NULL" << std::endl;
+                AETHER_LOG_WARN("Parser", "onPacket NULL");
             }
         }
+
+        /// Remove os dados processados do buffer (o frame incompleto fica)
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
     }
 
     /**
-     * Tenta parsear um pacote do buffer
+     * Tenta parsear um pacote do buffer. Cabeçalhos inválidos, frames com
+     * CRC errado e payloads que não descomprimem são descartados aqui
+     * mesmo; só retorna true com um pacote válido em outPacket.
      * @param buffer Buffer de dados
+     * @param start Início dos dados ainda não consumidos; avança pelo frame
+     *        parseado e pelos bytes descartados
      * @param outPacket Referência para armazenar o pacote parseado
-     * @return true se um pacote foi parseado, false caso contrário
+     * @return true se um pacote foi parseado, false se faltam dados
      */
-    bool Parser::tryParsePacket(std::vector<uint8_t>& buffer, Packet& outPacket)
+    bool Parser::tryParsePacket(const std::vector<uint8_t>& buffer, size_t& start, Packet& outPacket, uint64_t channelId)
     {
-        if (buffer.size() < HEADER_SIZE)
+        while (true)
         {
-            return false;
-        }
+            /// Pula de uma vez o que vier antes do magic (no-op com o buffer alinhado)
+            discardUntilMagic(buffer, start, start);
+
+            const uint8_t* frame = buffer.data() + start;
+            const size_t available = buffer.size() - start;
 
-        size_t offset = 0;  // Offset para leitura no buffer
+            if (available < HEADER_SIZE)
+            {
+                return false;
+            }
 
-        /// Funções auxiliares para ler dados do buffer
-        auto read16 = [&](uint16_t& v) {
-            v = (buffer[offset] << 8) | buffer[offset + 1];
-            offset += 2;
-        };
+            size_t offset = 2;  // Offset para leitura no frame (depois do magic)
 
-        /// Lê um valor de 32 bits do buffer
-        auto read32 = [&](uint32_t& v) {
-            v = (buffer[offset] << 24) |
-                (buffer[offset + 1] << 16) |
-                (buffer[offset + 2] << 8) |
-                buffer[offset + 3];
-            offset += 4;
-        };
+            /// Funções auxiliares para ler dados do frame
+            auto read16 = [&](uint16_t& v) {
+                v = (frame[offset] << 8) | frame[offset + 1];
+                offset += 2;
+            };
 
-        /// Lê o valor mágico do pacote
-        read16(outPacket.magic);
+            /// Lê um valor de 32 bits do frame
+            auto read32 = [&](uint32_t& v) {
+                v = (frame[offset] << 24) |
+                    (frame[offset + 1] << 16) |
+                    (frame[offset + 2] << 8) |
+                    frame[offset + 3];
+                offset += 4;
+            };
 
-        /// Verifica se o valor mágico é válido
-        if (outPacket.magic != MAGIC)
-        {
-            std::cerr << "[Parser] Magic inválido, descartando 1 byte\n";
-            buffer.erase(buffer.begin());
-            return true; // tenta de novo
+            outPacket.magic = MAGIC;
+            outPacket.version = frame[offset++];
+
+            /// Versão desconhecida: o magic era um falso positivo ou o cabeçalho está corrompido
+            if (outPacket.version != PacketBuilder::VERSION && outPacket.version != PacketBuilder::VERSION_2)
+            {
+                invalidHeaders.inc();
+                discardUntilMagic(buffer, start, start + 1);
+                continue;
+            }
+
+            /// A v2 tem um byte de flags depois da versão
+            const size_t headerSize = PacketBuilder::headerSize(outPacket.version);
+            if (available < headerSize)
+            {
+                return false; /// Aguarda o resto do cabeçalho
+            }
+            outPacket.flags = outPacket.version == PacketBuilder::VERSION_2 ? frame[offset++] : 0;
+
+            if (outPacket.flags & ~PacketBuilder::FLAGS_KNOWN)
+            {
+                invalidHeaders.inc();
+                discardUntilMagic(buffer, start, start + 1);
+                continue;
+            }
+
+            /// Lê o tipo, módulo e comprimento do payload
+            read16(outPacket.type);
+            read16(outPacket.module);
+            read32(outPacket.length);
+
+            /// Length absurdo: sem o limite, o parser esperaria até 4 GB por um frame que não existe
+            if (outPacket.length > maxPayload)
+            {
+                AETHER_LOG_WARN("Parser", "Length acima do limite, ressincronizando",
+                                AetherCoreLogger::field("length", outPacket.length),
+                                AetherCoreLogger::field("max", maxPayload));
+                oversizeFrames.inc();
+                discardUntilMagic(buffer, start, start + 1);
+                continue;
+            }
+
+            /// Request id (se houver) fica entre o cabeçalho e o payload
+            const bool hasRequestId = outPacket.flags & PacketBuilder::FLAG_REQUEST_ID;
+            const size_t payloadStart = headerSize + (hasRequestId ? PacketBuilder::REQUEST_ID_SIZE : 0);
+
+            /// Verifica se o buffer contém o payload completo (e o CRC, se houver)
+            const bool hasCrc = outPacket.flags & PacketBuilder::FLAG_CRC;
+            const size_t bodySize = payloadStart + outPacket.length;
+            const size_t frameSize = bodySize + (hasCrc ? PacketBuilder::CRC_SIZE : 0);
+            if (available < frameSize)
+            {
+                return false; /// Aguarda mais dados
+            }
+
+            if (hasCrc)
+            {
+                const uint8_t* trailer = frame + bodySize;
+                const uint32_t expected = (static_cast<uint32_t>(trailer[0]) << 24) |
+                                          (static_cast<uint32_t>(trailer[1]) << 16) |
+                                          (static_cast<uint32_t>(trailer[2]) << 8) |
+                                          static_cast<uint32_t>(trailer[3]);
+
+                /// CRC errado: o length pode ser o corrompido, então não confia no tamanho do frame
+                if (Aether::Core::Utils::Crc32c::compute(frame, bodySize) != expected)
+                {
+                    AETHER_LOG_WARN("Parser", "CRC32C inválido, ressincronizando",
+                                    AetherCoreLogger::field("type", outPacket.type),
+                                    AetherCoreLogger::field("length", outPacket.length));
+                    crcErrors.inc();
+                    discardUntilMagic(buffer, start, start + 1);
+                    continue;
+                }
+            }
+
+            outPacket.requestId = 0;
+            if (hasRequestId)
+                read32(outPacket.requestId);
+
+            /// Registra o frame como veio do socket, se a captura estiver ligada
+            if (PacketCapture::enabled())
+                PacketCapture::instance().record(PacketCapture::Direction::Inbound, channelId,
+                                                 frame, frameSize);
+
+            bytesParsed.inc(frameSize);
+
+            const auto codec = static_cast<Codec>(outPacket.flags & PacketBuilder::FLAG_CODEC_MASK);
+            bool valid = true;
+            if (codec == Codec::None)
+            {
+                /// Copia os dados do payload para o pacote
+                outPacket.payload.resize(outPacket.length);
+                std::memcpy(outPacket.payload.data(), frame + payloadStart, outPacket.length);
+            } else
+            {
+                /// O handler sempre recebe o payload original, com o mesmo teto de um payload cru
+                valid = compression.decompress(codec, frame + payloadStart, outPacket.length, outPacket.payload, maxPayload);
+                if (valid)
+                {
+                    compressedPackets.inc();
+                    outPacket.length = static_cast<uint32_t>(outPacket.payload.size());
+                }
+            }
+
+            /// O frame foi consumido; o feed() tira do buffer no fim
+            start += frameSize;
+
+            if (!valid)
+            {
+                /// O frame é descartado inteiro; a conexão continua alinhada no próximo
+                AETHER_LOG_WARN("Parser", "Payload comprimido inválido, descartando pacote",
+                                AetherCoreLogger::field("codec", static_cast<int>(codec)),
+                                AetherCoreLogger::field("length", outPacket.length));
+                decompressErrors.inc();
+                continue;
+            }
+
+            packetsParsed.inc();
+            return true;
         }
+    }
 
-        /// Lê o restante do cabeçalho do pacote
-        outPacket.version = buffer[offset++];
+    /**
+     * Descarta tudo antes do próximo magic, procurando a partir de `from`:
+     * `start` avança até ele (o feed() tira os bytes do buffer no fim). O
+     * memchr (vetorizado na glibc) acha os candidatos 0xAA; um 0xAA no
+     * último byte fica, pode ser o início de um magic.
+     * @param buffer Buffer de dados
+     * @param start Início dos dados ainda não consumidos
+     * @param from Primeira posição candidata (start + 1 para pular o magic atual)
+     */
+    void Parser::discardUntilMagic(const std::vector<uint8_t>& buffer, size_t& start, size_t from)
+    {
+        constexpr uint8_t MAGIC_HI = MAGIC >> 8;
+        constexpr uint8_t MAGIC_LO = MAGIC & 0xFF;
 
-        /// Lê o tipo, módulo e comprimento do payload
-        read16(outPacket.type);
-        read16(outPacket.module);
-        read32(outPacket.length);
+        const uint8_t* data = buffer.data();
+        const size_t size = buffer.size();
 
-        /// Verifica se o buffer contém o payload completo
-        if (buffer.size() < HEADER_SIZE + outPacket.length)
+        size_t pos = size;
+        while (from < size)
         {
-            return false; /// Aguarda mais dados
+            const auto* hit = static_cast<const uint8_t*>(std::memchr(data + from, MAGIC_HI, size - from));
+            if (!hit)
+                break;
+
+            const size_t at = static_cast<size_t>(hit - data);
+            if (at + 1 == size || data[at + 1] == MAGIC_LO)
+            {
+                pos = at;
+                break;
+            }
+            from = at + 1;
         }
 
-        /// Lê o payload do pacote
-        outPacket.payload.resize(outPacket.length);
-        /// Copia os dados do payload para o pacote
-        std::memcpy(outPacket.payload.data(), buffer.data() + HEADER_SIZE, outPacket.length);
-        /// Remove os dados processados do buffer
-        buffer.erase(buffer.begin(), buffer.begin() + HEADER_SIZE + outPacket.length);
+        if (pos == start)
+            return;
+
+        const size_t discarded = pos - start;
+        AETHER_LOG_DEBUG("Parser", "Magic inválido, descartando bytes", AetherCoreLogger::field("bytes", discarded));
+        resyncEvents.inc();
+        resyncBytes.inc(discarded);
+        start = pos;
+    }
 
-        return true;
+    /**
+     * Define o maior length aceito no cabeçalho
+     * @param bytes Limite do payload no fio, em bytes
+     */
+    void Parser::setMaxPayload(uint32_t bytes)
+    {
+        maxPayload = bytes;
     }
 }
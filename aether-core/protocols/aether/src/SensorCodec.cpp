@@ -0,0 +1,291 @@
+#include "../include/SensorCodec.hpp"
+
+#include <bit>
+
+namespace ProtocolAether
+{
+    namespace
+    {
+        /// Lê um inteiro big-endian de N bytes
+        template <typename T, std::size_t N = sizeof(T)>
+        T readBig(const uint8_t* p) noexcept
+        {
+            T v = 0;
+            for (std::size_t i = 0; i < N; ++i)
+                v = static_cast<T>((v << 8) | p[i]);
+            return v;
+        }
+
+        /// Escreve um inteiro big-endian de N bytes
+        template <typename T, std::size_t N = sizeof(T)>
+        void writeBig(uint8_t* p, T v) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+                p[i] = static_cast<uint8_t>(v >> (8 * (N - 1 - i)));
+        }
+
+        /**
+         * Decodifica um item a partir de offset, avançando offset até o fim dele.
+         * O varint tem no máximo 5 bytes, então o custo não depende do conteúdo.
+         */
+        SensorCodec::Status decodeItem(const uint8_t* data, std::size_t size, std::size_t& offset, SensorReading& out) noexcept
+        {
+            using Status = SensorCodec::Status;
+
+            if (offset >= size)
+                return Status::Truncated;
+
+            const uint8_t flags = data[offset++];
+            if (flags & ~SensorCodec::FLAG_DOUBLE)
+                return Status::BadFlags;
+
+            /// sensorId: LEB128, 7 bits por byte, bit 7 = continua
+            uint64_t sensorId = 0;
+            for (std::size_t i = 0; ; ++i)
+            {
+                if (i == SensorCodec::MAX_VARINT_SIZE)
+                    return Status::BadVarint;
+                if (offset >= size)
+                    return Status::Truncated;
+
+                const uint8_t byte = data[offset++];
+                sensorId |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+
+            if (sensorId > UINT32_MAX)
+                return Status::BadVarint;
+
+            const std::size_t valueSize = (flags & SensorCodec::FLAG_DOUBLE) ? 8 : 4;
+            if (size - offset < valueSize + 4)
+                return Status::Truncated;
+
+            out.sensorId = static_cast<uint32_t>(sensorId);
+            out.value = valueSize == 8
+                ? std::bit_cast<double>(readBig<uint64_t>(data + offset))
+                : static_cast<double>(std::bit_cast<float>(readBig<uint32_t>(data + offset)));
+            out.readTimestamp = readBig<uint32_t>(data + offset + valueSize);
+            offset += valueSize + 4;
+
+            return Status::Ok;
+        }
+
+        /// Codifica um item em out (MAX_ITEM_SIZE bytes), devolvendo o tamanho escrito
+        std::size_t encodeItem(const SensorReading& reading, bool asDouble, uint8_t* out) noexcept
+        {
+            std::size_t offset = 0;
+            out[offset++] = asDouble ? SensorCodec::FLAG_DOUBLE : 0;
+
+            uint32_t sensorId = reading.sensorId;
+            do
+            {
+                uint8_t byte = sensorId & 0x7F;
+                sensorId >>= 7;
+                if (sensorId != 0)
+                    byte |= 0x80;
+                out[offset++] = byte;
+            } while (sensorId != 0);
+
+            if (asDouble)
+            {
+                writeBig(out + offset, std::bit_cast<uint64_t>(reading.value));
+                offset += 8;
+            } else
+            {
+                writeBig(out + offset, std::bit_cast<uint32_t>(static_cast<float>(reading.value)));
+                offset += 4;
+            }
+
+            writeBig(out + offset, reading.readTimestamp);
+            offset += 4;
+
+            return offset;
+        }
+
+        /// Lê o cabeçalho [version][count] de um lote ou ACK de lote
+        SensorCodec::Status readBatchHeader(const uint8_t* data, std::size_t size, std::size_t& count) noexcept
+        {
+            using Status = SensorCodec::Status;
+
+            if (size < SensorCodec::BATCH_HEADER_SIZE)
+                return Status::Truncated;
+            if (data[0] != SensorCodec::VERSION)
+                return Status::BadVersion;
+
+            count = readBig<uint16_t>(data + 1);
+            if (count == 0 || count > SensorCodec::MAX_BATCH_ITEMS)
+                return Status::BadCount;
+
+            return Status::Ok;
+        }
+    }
+
+    /**
+     * Decodifica o payload DATA_PUSH_BINARY.
+     * @param data Início do payload
+     * @param size Tamanho do payload
+     * @param out Leitura decodificada
+     * @return Status::Ok ou o motivo da recusa
+     */
+    SensorCodec::Status SensorCodec::decode(const uint8_t* data, std::size_t size, SensorReading& out) noexcept
+    {
+        if (size < MIN_SIZE)
+            return Status::Truncated;
+
+        if (data[0] != VERSION)
+            return Status::BadVersion;
+
+        std::size_t offset = 1;
+        const auto status = decodeItem(data, size, offset, out);
+        if (status != Status::Ok)
+            return status;
+
+        return offset == size ? Status::Ok : Status::TrailingBytes;
+    }
+
+    /**
+     * Decodifica o payload DATA_PUSH_BATCH. Um item malformado recusa o lote
+     * inteiro (não há como achar o início do próximo item).
+     * @param data Início do payload
+     * @param size Tamanho do payload
+     * @param out Destino com espaço para MAX_BATCH_ITEMS leituras
+     * @param count Quantidade de leituras decodificadas
+     * @return Status::Ok ou o motivo da recusa
+     */
+    SensorCodec::Status SensorCodec::decodeBatch(const uint8_t* data, std::size_t size, SensorReading* out, std::size_t& count) noexcept
+    {
+        std::size_t items = 0;
+        auto status = readBatchHeader(data, size, items);
+        if (status != Status::Ok)
+            return status;
+
+        std::size_t offset = BATCH_HEADER_SIZE;
+        for (std::size_t i = 0; i < items; ++i)
+        {
+            status = decodeItem(data, size, offset, out[i]);
+            if (status != Status::Ok)
+                return status;
+        }
+
+        if (offset != size)
+            return Status::TrailingBytes;
+
+        count = items;
+        return Status::Ok;
+    }
+
+    /**
+     * Codifica uma leitura no buffer informado.
+     * @param reading Leitura a ser codificada
+     * @param asDouble true para value com 8 bytes
+     * @param out Buffer com pelo menos MAX_SIZE bytes
+     * @return Quantidade de bytes escritos
+     */
+    std::size_t SensorCodec::encode(const SensorReading& reading, bool asDouble, uint8_t* out) noexcept
+    {
+        out[0] = VERSION;
+        return 1 + encodeItem(reading, asDouble, out + 1);
+    }
+
+    /**
+     * Codifica uma leitura em um vetor pronto para o PacketBuilder.
+     * @param reading Leitura a ser codificada
+     * @param asDouble true para value com 8 bytes
+     * @return Payload codificado
+     */
+    std::vector<uint8_t> SensorCodec::encode(const SensorReading& reading, bool asDouble)
+    {
+        std::vector<uint8_t> payload(MAX_SIZE);
+        payload.resize(encode(reading, asDouble, payload.data()));
+        return payload;
+    }
+
+    /**
+     * Codifica um lote de leituras (DATA_PUSH_BATCH).
+     * @param readings Leituras, na ordem em que o ACK vai responder
+     * @param count Quantidade de leituras (1..MAX_BATCH_ITEMS)
+     * @param asDouble true para value com 8 bytes
+     * @return Payload codificado
+     */
+    std::vector<uint8_t> SensorCodec::encodeBatch(const SensorReading* readings, std::size_t count, bool asDouble)
+    {
+        std::vector<uint8_t> payload(BATCH_HEADER_SIZE + count * MAX_ITEM_SIZE);
+        payload[0] = VERSION;
+        writeBig(payload.data() + 1, static_cast<uint16_t>(count));
+
+        std::size_t offset = BATCH_HEADER_SIZE;
+        for (std::size_t i = 0; i < count; ++i)
+            offset += encodeItem(readings[i], asDouble, payload.data() + offset);
+
+        payload.resize(offset);
+        return payload;
+    }
+
+    /**
+     * Monta o payload do DATA_PUSH_BATCH_ACK.
+     * @param stored stored[i] indica se o item i do lote foi gravado
+     * @return Payload codificado
+     */
+    std::vector<uint8_t> SensorCodec::encodeBatchAck(const std::vector<bool>& stored)
+    {
+        std::vector<uint8_t> payload(BATCH_HEADER_SIZE + (stored.size() + 7) / 8, 0);
+        payload[0] = VERSION;
+        writeBig(payload.data() + 1, static_cast<uint16_t>(stored.size()));
+
+        for (std::size_t i = 0; i < stored.size(); ++i)
+        {
+            if (stored[i])
+                payload[BATCH_HEADER_SIZE + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+
+        return payload;
+    }
+
+    /**
+     * Lê um DATA_PUSH_BATCH_ACK.
+     * @param data Início do payload
+     * @param size Tamanho do payload
+     * @param stored Resultado de cada item do lote
+     * @return Status::Ok ou o motivo da recusa
+     */
+    SensorCodec::Status SensorCodec::decodeBatchAck(const uint8_t* data, std::size_t size, std::vector<bool>& stored)
+    {
+        std::size_t count = 0;
+        const auto status = readBatchHeader(data, size, count);
+        if (status != Status::Ok)
+            return status;
+
+        const std::size_t expected = BATCH_HEADER_SIZE + (count + 7) / 8;
+        if (size < expected)
+            return Status::Truncated;
+        if (size > expected)
+            return Status::TrailingBytes;
+
+        stored.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            stored[i] = (data[BATCH_HEADER_SIZE + i / 8] >> (i % 8)) & 1;
+
+        return Status::Ok;
+    }
+
+    /**
+     * Mensagem de erro de um Status.
+     * @param status Resultado do decode
+     * @return Texto para a resposta ao device
+     */
+    const char* SensorCodec::describe(Status status) noexcept
+    {
+        switch (status)
+        {
+            case Status::Ok:            return "OK";
+            case Status::Truncated:     return "Payload binário truncado";
+            case Status::BadVersion:    return "Versão do payload binário desconhecida";
+            case Status::BadFlags:      return "Flags reservadas ligadas no payload binário";
+            case Status::BadVarint:     return "sensor_id inválido no payload binário";
+            case Status::TrailingBytes: return "Payload binário com bytes sobrando";
+            case Status::BadCount:      return "Quantidade de leituras do lote inválida";
+        }
+        return "Payload binário inválido";
+    }
+}
@@ -0,0 +1,149 @@
+-- Dissector Wireshark para as capturas do Aether (CLI: trace on).
+--
+-- O arquivo é um pcap com LINKTYPE_USER0 (147). Cada registro traz o
+-- pseudo-cabeçalho gravado pelo PacketCapture seguido do frame Aether:
+--
+--   [direction(1)][deviceLen(1)][channel BE(4)][device(deviceLen)][frame]
+--
+-- Uso:
+--   wireshark -X lua_script:aether-core/tools/wireshark/aether.lua trace.pcap
+--   tshark    -X lua_script:aether-core/tools/wireshark/aether.lua -r trace.pcap -V
+-- ou copie o arquivo para ~/.local/lib/wireshark/plugins/.
+
+local aether_trace = Proto("aether_trace", "Aether Trace")
+local aether = Proto("aether", "Aether Protocol")
+
+local directions = { [0] = "device -> servidor", [1] = "servidor -> device" }
+
+local f_direction = ProtoField.uint8("aether_trace.direction", "Direction", base.DEC, directions)
+local f_device_len = ProtoField.uint8("aether_trace.device_len", "Device length", base.DEC)
+local f_channel = ProtoField.uint32("aether_trace.channel", "Channel", base.DEC)
+local f_device = ProtoField.string("aether_trace.device", "Device")
+aether_trace.fields = { f_direction, f_device_len, f_channel, f_device }
+
+local f_magic = ProtoField.uint16("aether.magic", "Magic", base.HEX)
+local f_version = ProtoField.uint8("aether.version", "Version", base.DEC)
+local codecs = { [0] = "None", [1] = "Deflate", [2] = "LZ4", [3] = "Zstd" }
+local f_flags = ProtoField.uint8("aether.flags", "Flags", base.HEX)
+local f_codec = ProtoField.uint8("aether.flags.codec", "Codec", base.DEC, codecs, 0x03)
+local f_flag_crc = ProtoField.bool("aether.flags.crc", "CRC32C", 8, nil, 0x04)
+local f_crc = ProtoField.uint32("aether.crc", "CRC32C", base.HEX)
+local f_flag_request_id = ProtoField.bool("aether.flags.request_id", "Request id", 8, nil, 0x08)
+local f_request_id = ProtoField.uint32("aether.request_id", "Request id", base.DEC)
+local f_type = ProtoField.uint16("aether.type", "Type", base.HEX)
+local f_module = ProtoField.uint16("aether.module", "Module", base.HEX)
+local f_length = ProtoField.uint32("aether.length", "Length", base.DEC)
+local f_payload = ProtoField.bytes("aether.payload", "Payload")
+aether.fields = { f_magic, f_version, f_flags, f_codec, f_flag_crc, f_flag_request_id, f_type, f_module, f_length, f_request_id, f_payload, f_crc }
+
+local HEADER_SIZE = 11
+local HEADER_SIZE_V2 = 12
+local MAGIC = 0xAA55
+
+-- Frame Aether (ver protocols/aether/include/Packet.hpp)
+function aether.dissector(tvb, pinfo, tree)
+    if tvb:len() < HEADER_SIZE then
+        return 0
+    end
+
+    local subtree = tree:add(aether, tvb())
+    local magic = tvb(0, 2):uint()
+    local magic_item = subtree:add(f_magic, tvb(0, 2))
+    if magic ~= MAGIC then
+        magic_item:add_expert_info(PI_MALFORMED, PI_ERROR, "Magic invalido")
+    end
+
+    subtree:add(f_version, tvb(2, 1))
+
+    -- v2: byte de flags depois da versão; o resto do cabeçalho desloca 1 byte
+    local header_size = HEADER_SIZE
+    local at = 3
+    local codec = 0
+    local has_crc = false
+    local has_request_id = false
+    if tvb(2, 1):uint() == 2 then
+        if tvb:len() < HEADER_SIZE_V2 then
+            return 0
+        end
+        local flags = subtree:add(f_flags, tvb(3, 1))
+        flags:add(f_codec, tvb(3, 1))
+        flags:add(f_flag_crc, tvb(3, 1))
+        flags:add(f_flag_request_id, tvb(3, 1))
+        codec = bit.band(tvb(3, 1):uint(), 0x03)
+        has_crc = bit.band(tvb(3, 1):uint(), 0x04) ~= 0
+        has_request_id = bit.band(tvb(3, 1):uint(), 0x08) ~= 0
+        header_size = HEADER_SIZE_V2
+        at = 4
+    end
+
+    subtree:add(f_type, tvb(at, 2))
+    subtree:add(f_module, tvb(at + 2, 2))
+    subtree:add(f_length, tvb(at + 4, 4))
+
+    local length = tvb(at + 4, 4):uint()
+    local request_id = nil
+    if has_request_id and tvb:len() >= header_size + 4 then
+        subtree:add(f_request_id, tvb(header_size, 4))
+        request_id = tvb(header_size, 4):uint()
+        header_size = header_size + 4
+    end
+
+    local available = tvb:len() - header_size
+    if length > 0 and available > 0 then
+        local payload = subtree:add(f_payload, tvb(header_size, math.min(length, available)))
+        if codec ~= 0 then
+            payload:append_text(string.format(" [comprimido: %s]", codecs[codec]))
+        end
+        if available < length then
+            payload:append_text(" [truncado]")
+        end
+    end
+
+    -- Trailer CRC32C (fora do length); o arquivo guarda o frame como veio do socket
+    if has_crc and available >= length + 4 then
+        subtree:add(f_crc, tvb(header_size + length, 4))
+    end
+
+    pinfo.cols.protocol = "AETHER"
+    pinfo.cols.info:append(string.format(" type=0x%04x module=0x%04x len=%d%s",
+        tvb(at, 2):uint(), tvb(at + 2, 2):uint(), length, codec ~= 0 and (" " .. codecs[codec]) or ""))
+    if request_id then
+        pinfo.cols.info:append(string.format(" req=%d", request_id))
+    end
+
+    return tvb:len()
+end
+
+-- Pseudo-cabeçalho gravado pelo PacketCapture
+function aether_trace.dissector(tvb, pinfo, tree)
+    if tvb:len() < 6 then
+        return 0
+    end
+
+    local direction = tvb(0, 1):uint()
+    local device_len = tvb(1, 1):uint()
+    local header_size = 6 + device_len
+
+    local subtree = tree:add(aether_trace, tvb(0, header_size))
+    subtree:add(f_direction, tvb(0, 1))
+    subtree:add(f_device_len, tvb(1, 1))
+    subtree:add(f_channel, tvb(2, 4))
+
+    local device = "-"
+    if device_len > 0 then
+        subtree:add(f_device, tvb(6, device_len))
+        device = tvb(6, device_len):string()
+    end
+
+    pinfo.cols.src = direction == 0 and device or "aetherd"
+    pinfo.cols.dst = direction == 0 and "aetherd" or device
+    pinfo.cols.info:set(string.format("%s ch=%d", directions[direction] or "?", tvb(2, 4):uint()))
+
+    if tvb:len() > header_size then
+        aether.dissector(tvb(header_size):tvb(), pinfo, tree)
+    end
+
+    return tvb:len()
+end
+
+DissectorTable.get("wtap_encap"):add(wtap.USER0, aether_trace)
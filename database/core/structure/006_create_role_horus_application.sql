@@ -0,0 +1,7 @@
+/* Cria um usuario chamado 'HORUS_APPLICATION' para a API carregar o cadastro de cameras do Horus */
+CREATE USER HORUS_APPLICATION WITH PASSWORD ':password';
+
+/* A API so le o cadastro (horus.came_camera); nao recebe escrita */
+GRANT USAGE ON SCHEMA horus TO HORUS_APPLICATION;
+GRANT SELECT ON ALL TABLES IN SCHEMA horus TO HORUS_APPLICATION;
+ALTER DEFAULT PRIVILEGES IN SCHEMA horus GRANT SELECT ON TABLES TO HORUS_APPLICATION;